@@ -0,0 +1,108 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * latency_bench.h
+ *
+ * \brief Command to measurement latency: streams a hold setpoint on
+ *  servo_jp or servo_cp, steps it by a small offset, and times from the
+ *  return of the CRTK_robot::run() that published the step (sent()) until
+ *  measured_js / measured_cp has moved a set fraction of the step. Steps
+ *  alternate in sign, so every trial is told apart from the last one and
+ *  the arm does not drift.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_LATENCY_BENCH_H_
+#define CRTK_LATENCY_BENCH_H_
+
+#include <crtk_lib_cpp/crtk_robot.h>
+#include <crtk_lib_cpp/crtk_histogram.h>
+#include <ros/callback_queue.h>
+#include <mutex>
+
+enum CRTK_latency_type {CRTK_LATENCY_JP, CRTK_LATENCY_CP, CRTK_LATENCY_NUM};
+
+class CRTK_latency_bench{
+public:
+  CRTK_latency_bench(ros::NodeHandle n, CRTK_robot *robot, std::string r_space);
+  ~CRTK_latency_bench(){ spinner.stop(); };
+
+  bool tick();
+  void sent();
+  void report();
+
+private:
+  enum phase {BENCH_WAIT, BENCH_SETTLE, BENCH_STEP, BENCH_DONE};
+
+  void measured_js_cb(const sensor_msgs::JointState::ConstPtr&);
+  void measured_cp_cb(const geometry_msgs::TransformStamped::ConstPtr&);
+  void check_step(double measured);
+  bool robot_ready();
+  void start_type();
+  void send_hold();
+  void next_type(int64_t now_ns);
+
+  CRTK_robot *robot;
+  ros::CallbackQueue queue;
+  ros::AsyncSpinner spinner;
+  ros::Subscriber sub_measured_js;
+  ros::Subscriber sub_measured_cp;
+
+  // parameters
+  int trials;
+  int joint;
+  double jp_step;          // rad (or m)
+  double cp_step;          // m, along x
+  double threshold;        // fraction of the step that counts as arrived
+  int64_t settle_ns;
+  int64_t timeout_ns;
+  bool run_type[CRTK_LATENCY_NUM];
+  bool enable;
+
+  // main loop
+  phase state;
+  int type;
+  int trial;
+  int64_t phase_start_ns;
+  int64_t last_enable_ns;
+  float hold_jp[MAX_JOINTS];
+  tf::Transform hold_cp;
+
+  // shared with the measured callbacks
+  std::mutex mtx;
+  bool have_js, have_cp;
+  double last_js[MAX_JOINTS];
+  tf::Transform last_cp;
+  bool step_active;
+  bool step_pending;       // issued by tick(), not yet published
+  int64_t step_sent_ns;
+  double step_from;        // measured value when the step went out
+  double step_size;        // signed
+  bool step_seen;
+
+  CRTK_histogram latency[CRTK_LATENCY_NUM];
+  unsigned long seen[CRTK_LATENCY_NUM];
+  unsigned long lost[CRTK_LATENCY_NUM];
+};
+
+#endif
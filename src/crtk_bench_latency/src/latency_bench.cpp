@@ -0,0 +1,370 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * latency_bench.cpp
+ *
+ * \brief Command to measurement latency benchmark (see latency_bench.h)
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include "latency_bench.h"
+#include <chrono>
+#include <sstream>
+
+static const char *type_names[CRTK_LATENCY_NUM] = {"servo_jp -> measured_js", "servo_cp -> measured_cp"};
+
+static int64_t steady_now_ns(){
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/**
+ * @brief      Reads the parameters and subscribes to the measured stream on
+ *             its own callback queue and thread, so arrivals are timed when
+ *             they come in rather than at the next loop tick.
+ *
+ * @param[in]  n        ros node handle (private parameters)
+ * @param      robot    The robot the commands go out through
+ * @param[in]  r_space  The robot namespace
+ */
+CRTK_latency_bench::CRTK_latency_bench(ros::NodeHandle n, CRTK_robot *robot, std::string r_space)
+  : robot(robot), spinner(1, &queue){
+
+  trials    = 200;
+  joint     = 0;
+  jp_step   = 0.005;
+  cp_step   = 0.001;
+  threshold = 0.2;
+  enable    = false;
+  double settle = 0.3, timeout = 0.5;
+  std::string types = "jp cp";
+  n.getParam("trials", trials);
+  n.getParam("joint", joint);
+  n.getParam("jp_step", jp_step);
+  n.getParam("cp_step", cp_step);
+  n.getParam("threshold", threshold);
+  n.getParam("settle", settle);
+  n.getParam("timeout", timeout);
+  n.getParam("types", types);
+  n.getParam("enable", enable);
+  settle_ns  = (int64_t)(settle*1e9);
+  timeout_ns = (int64_t)(timeout*1e9);
+
+  if(joint < 0 || joint >= robot->arm.get_num_joints()){
+    ROS_ERROR("joint must be 0 to %d (got %d), using 0.", robot->arm.get_num_joints()-1, joint);
+    joint = 0;
+  }
+
+  run_type[CRTK_LATENCY_JP] = run_type[CRTK_LATENCY_CP] = false;
+  std::istringstream in(types);
+  std::string t;
+  while(in >> t){
+    if(t == "jp")      run_type[CRTK_LATENCY_JP] = true;
+    else if(t == "cp") run_type[CRTK_LATENCY_CP] = true;
+    else ROS_ERROR("Unknown command type '%s' (jp or cp).", t.c_str());
+  }
+
+  state          = BENCH_WAIT;
+  type           = -1;
+  trial          = 0;
+  phase_start_ns = 0;
+  last_enable_ns = 0;
+  have_js = have_cp = false;
+  step_active    = false;
+  step_pending   = false;
+  step_seen      = false;
+  step_sent_ns   = 0;
+  step_from      = 0;
+  step_size      = 0;
+  for(int i=0;i<CRTK_LATENCY_NUM;i++)
+    seen[i] = lost[i] = 0;
+  next_type(0);
+
+  ros::NodeHandle nq(n);
+  nq.setCallbackQueue(&queue);
+  std::string topic = "/" + r_space + "/measured_js";
+  sub_measured_js = nq.subscribe(topic, 10, &CRTK_latency_bench::measured_js_cb, this, CRTK_transport::hints(n, topic));
+  topic = "/" + r_space + "/measured_cp";
+  sub_measured_cp = nq.subscribe(topic, 10, &CRTK_latency_bench::measured_cp_cb, this, CRTK_transport::hints(n, topic));
+  spinner.start();
+
+  ROS_INFO("%d steps per command type (joint %d by %g, x by %g), arrived at %.0f%% of the step.",
+    trials, joint, jp_step, cp_step, 100*threshold);
+}
+
+
+
+/**
+ * @brief      Runs one loop tick, before CRTK_robot::run() publishes: waits
+ *             for the robot, streams the hold setpoint, and issues or
+ *             times out steps. A new step is timed from sent().
+ *
+ * @return     false once every command type is done
+ */
+bool CRTK_latency_bench::tick(){
+  int64_t now = steady_now_ns();
+
+  if(state == BENCH_DONE)
+    return false;
+
+  if(!robot_ready()){
+    if(state != BENCH_WAIT){
+      ROS_WARN("Robot no longer enabled; %s continues once it is.", type_names[type]);
+      std::lock_guard<std::mutex> lock(mtx);
+      step_active = false;
+      step_pending = false;
+    }
+    state = BENCH_WAIT;
+
+    if(enable && now - last_enable_ns > 2000000000LL){
+      last_enable_ns = now;
+      robot->state.crtk_command_pb(robot->state.get_paused() ? CRTK_RESUME : CRTK_ENABLE);
+    }
+    ROS_INFO_THROTTLE(5, "Waiting for the robot to be enabled and homed%s.", enable ? "" : " (or set _enable:=true)");
+    return true;
+  }
+
+  switch(state){
+    case BENCH_WAIT:
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      bool have = type == CRTK_LATENCY_JP ? have_js : have_cp;
+      if(have){
+        start_type();
+        state = BENCH_SETTLE;
+        phase_start_ns = now;
+      }
+      break;
+    }
+
+    case BENCH_SETTLE:
+    {
+      if(now - phase_start_ns < settle_ns){
+        send_hold();
+        break;
+      }
+
+      // step the hold setpoint; the sign alternates trial to trial
+      double size = (trial % 2 ? -1 : 1) * (type == CRTK_LATENCY_JP ? jp_step : cp_step);
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        step_from    = type == CRTK_LATENCY_JP ? last_js[joint] : last_cp.getOrigin().x();
+        step_size    = size;
+        step_seen    = false;
+        step_pending = true;     // timed from sent(), once it is published
+      }
+      if(type == CRTK_LATENCY_JP)
+        hold_jp[joint] += size;
+      else
+        hold_cp.setOrigin(hold_cp.getOrigin() + tf::Vector3(size,0,0));
+      send_hold();
+
+      state = BENCH_STEP;
+      phase_start_ns = now;
+      break;
+    }
+
+    case BENCH_STEP:
+    {
+      send_hold();
+      bool done;
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        done = step_seen;
+        if(!done && now - phase_start_ns > timeout_ns){
+          step_active = false;
+          step_pending = false;
+          lost[type]++;
+          done = true;
+        }
+      }
+      if(!done)
+        break;
+
+      trial++;
+      state = BENCH_SETTLE;
+      phase_start_ns = now;
+      if(trial >= trials)
+        next_type(now);
+      break;
+    }
+
+    default:
+      break;
+  }
+  return state != BENCH_DONE;
+}
+
+
+
+/**
+ * @brief      Call right after CRTK_robot::run(): starts timing a step
+ *             issued by this tick's tick(), now that its command is out
+ */
+void CRTK_latency_bench::sent(){
+  int64_t now = steady_now_ns();
+  std::lock_guard<std::mutex> lock(mtx);
+  if(!step_pending)
+    return;
+  step_pending = false;
+  step_active  = true;
+  step_sent_ns = now;
+}
+
+
+
+/**
+ * @brief      Checks if the robot takes servo commands: enabled, homed and
+ *             not busy
+ *
+ * @return     true if ready
+ */
+bool CRTK_latency_bench::robot_ready(){
+  return robot->state.get_enabled() && robot->state.get_homed() && !robot->state.get_busy();
+}
+
+
+
+/**
+ * @brief      Starts (or resumes) a command type from where the arm is now.
+ *             Called with mtx held.
+ */
+void CRTK_latency_bench::start_type(){
+  for(int i=0;i<MAX_JOINTS;i++)
+    hold_jp[i] = last_js[i];
+  hold_cp = last_cp;
+  ROS_INFO("Timing %s.", type_names[type]);
+}
+
+
+
+/**
+ * @brief      Moves on to the next command type, or finishes
+ *
+ * @param[in]  now_ns  The current time (ns)
+ */
+void CRTK_latency_bench::next_type(int64_t now_ns){
+  std::lock_guard<std::mutex> lock(mtx);
+  do{
+    type++;
+  }while(type < CRTK_LATENCY_NUM && !run_type[type]);
+
+  trial = 0;
+  step_active = false;
+  step_pending = false;
+  phase_start_ns = now_ns;
+  if(type >= CRTK_LATENCY_NUM){
+    type = CRTK_LATENCY_NUM - 1;
+    state = BENCH_DONE;
+  }
+  else
+    state = BENCH_WAIT;
+}
+
+
+
+/**
+ * @brief      Sends the hold setpoint for this tick
+ */
+void CRTK_latency_bench::send_hold(){
+  if(type == CRTK_LATENCY_JP)
+    robot->arm.send_servo_jp(hold_jp);
+  else
+    robot->arm.send_servo_cp(hold_cp);
+}
+
+
+
+/**
+ * @brief      Times the step if this measured value has moved far enough
+ *             towards it. Called with mtx held.
+ *
+ * @param[in]  measured  The measured joint or x position
+ */
+void CRTK_latency_bench::check_step(double measured){
+  if(!step_active)
+    return;
+  if((measured - step_from)*(step_size > 0 ? 1 : -1) < threshold*std::fabs(step_size))
+    return;
+
+  latency[type].add(steady_now_ns() - step_sent_ns);
+  seen[type]++;
+  step_seen = true;
+  step_active = false;
+}
+
+
+
+/**
+ * @brief      measured_js callback, on the bench's own spinner thread
+ *
+ * @param[in]  msg   The message
+ */
+void CRTK_latency_bench::measured_js_cb(const sensor_msgs::JointState::ConstPtr& msg){
+  int size = msg->position.size();
+  if(size <= joint)
+    return;
+
+  std::lock_guard<std::mutex> lock(mtx);
+  for(int i=0;i<size && i<MAX_JOINTS;i++)
+    last_js[i] = msg->position[i];
+  have_js = true;
+  if(type == CRTK_LATENCY_JP)
+    check_step(msg->position[joint]);
+}
+
+
+
+/**
+ * @brief      measured_cp callback, on the bench's own spinner thread
+ *
+ * @param[in]  msg   The message
+ */
+void CRTK_latency_bench::measured_cp_cb(const geometry_msgs::TransformStamped::ConstPtr& msg){
+  tf::Transform in;
+  tf::transformMsgToTF(msg->transform, in);
+
+  std::lock_guard<std::mutex> lock(mtx);
+  last_cp = in;
+  have_cp = true;
+  if(type == CRTK_LATENCY_CP)
+    check_step(in.getOrigin().x());
+}
+
+
+
+/**
+ * @brief      Logs p50, p99, max and mean latency per command type, and the
+ *             steps that never showed up within the timeout
+ */
+void CRTK_latency_bench::report(){
+  for(int i=0;i<CRTK_LATENCY_NUM;i++){
+    if(!run_type[i])
+      continue;
+    CRTK_histogram_summary s;
+    latency[i].summarize(&s);
+    ROS_INFO("%-24s %4lu steps  %3lu lost  p50 %7.3f ms  p99 %7.3f ms  max %7.3f ms  mean %7.3f ms",
+      type_names[i], seen[i], lost[i], 1e3*s.p50, 1e3*s.p99, 1e3*s.max, 1e3*s.mean);
+  }
+}
@@ -0,0 +1,70 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * main.cpp
+ *
+ * \brief Command to measurement latency benchmark node. Works against a
+ *  real arm or crtk_sim; see launch/latency_sim.launch.
+ *
+ *  rosrun crtk_bench_latency crtk_bench_latency _r_space:=arm1 _trials:=500
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include <crtk_lib_cpp/crtk_robot.h>
+#include <crtk_lib_cpp/crtk_rt_loop.h>
+#include "latency_bench.h"
+
+
+
+/**
+ * @brief      The main function
+ *
+ * @param[in]  argc  The argc
+ * @param      argv  The argv
+ *
+ * @return     0
+ */
+int main(int argc, char **argv)
+{
+  ros::init(argc, argv, "crtk_bench_latency");
+  static ros::NodeHandle n("~");
+  CRTK_rt_loop loop_rate(n, LOOP_RATE);
+
+  std::string r_space;
+  if(!n.getParam("r_space", r_space))
+    ROS_ERROR("No Robot namespace provided in command line!");
+  CRTK_robot robot(n, r_space);
+  CRTK_latency_bench bench(n, &robot, r_space);
+
+  while (ros::ok()){
+    ros::spinOnce();
+    if(!bench.tick())
+      break;
+    robot.run();
+    bench.sent();
+    loop_rate.sleep();
+  }
+
+  bench.report();
+  return 0;
+}
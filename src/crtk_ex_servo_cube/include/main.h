@@ -2,11 +2,13 @@
 #define _MAIN_H_
 
 #include <crtk_lib_cpp/defines.h>
+#include <crtk_lib_cpp/crtk_robot.h>
+#include <ctime>
 
 enum cube_dir{cube_x, cube_y, cube_z};
-char front_face = 0b100;
-char left_face  = 0b010;
-char lower_face = 0b001;
+extern char front_face;
+extern char left_face;
+extern char lower_face;
 
 /**
  * @brief      The function executes a random cube tracing example
@@ -18,7 +20,7 @@ char lower_face = 0b001;
  *
  * @return     0
  */
-int run_cube(CRTK_robot *, time_t);
+int run_cube(CRTK_robot *, ros::Time);
 
 
 /**
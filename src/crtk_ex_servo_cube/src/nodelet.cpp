@@ -0,0 +1,53 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford,
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * nodelet.cpp
+ *
+ * \brief Nodelet form of the servo_cr cube example. Load it into the robot
+ *  driver's nodelet manager with the r_space parameter set.
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include <crtk_lib_cpp/crtk_robot_nodelet.h>
+#include <crtk_lib_cpp/crtk_confirm.h>
+#include <pluginlib/class_list_macros.h>
+
+#include "main.h"
+
+
+class CRTK_ex_servo_cube_nodelet : public CRTK_robot_nodelet{
+  protected:
+    virtual void onInit(){
+      // prompts answer from this nodelet's confirm topic, not the manager's,
+      // and never block the loop thread
+      CRTK_confirm::init(getPrivateNodeHandle());
+      CRTK_robot_nodelet::onInit();
+    }
+
+    virtual int loop(const ros::Time& current_time){
+      return run_cube(robot, current_time);
+    }
+};
+
+PLUGINLIB_EXPORT_CLASS(CRTK_ex_servo_cube_nodelet, nodelet::Nodelet)
@@ -0,0 +1,276 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * bench_hot_paths.cpp
+ *
+ * \brief Google benchmark suite for the per-tick hot paths: the go_to_* and
+ *  send_servo_* motion generators, the measured_js callback and every
+ *  publish_servo_*. Each iteration is one 1 kHz tick; "allocs" is the
+ *  number of heap allocations per tick on the benchmark thread. The
+ *  publishers have no subscribers, so publish() returns before any
+ *  serialization and only the library's own cost is timed. Needs a running
+ *  roscore (for the node handle); benchmark flags pass through, e.g.
+ *
+ *  rosrun crtk_lib_cpp crtk_bench_hot_paths --benchmark_filter=go_to _num_joints:=7
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include <crtk_lib_cpp/crtk_robot.h>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <new>
+
+// heap allocations made by this thread, for the per-tick allocation count
+static thread_local unsigned long thread_allocs = 0;
+
+void* operator new(std::size_t size){
+  thread_allocs++;
+  void *p = std::malloc(size ? size : 1);
+  if(!p) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](std::size_t size){
+  return operator new(size);
+}
+void operator delete(void *p) noexcept{
+  std::free(p);
+}
+void operator delete[](void *p) noexcept{
+  std::free(p);
+}
+void operator delete(void *p, std::size_t) noexcept{
+  std::free(p);
+}
+void operator delete[](void *p, std::size_t) noexcept{
+  std::free(p);
+}
+
+static CRTK_robot *robot = NULL;
+static int num_joints = 7;
+static const ros::Duration tick(0.001);
+
+
+/**
+ * @brief      Loads the parameters CRTK_robot expects for a fake arm namespace
+ *
+ * @param      n           ros node handle
+ * @param[in]  r_space     The robot namespace
+ * @param[in]  num_joints  The number of joints
+ */
+static void set_bench_params(ros::NodeHandle &n, std::string r_space, int num_joints){
+  XmlRpc::XmlRpcValue home_pos, home_jpos, home_quat;
+
+  home_pos.setSize(3);
+  for(int i=0;i<3;i++) home_pos[i] = 0.0;
+  home_quat.setSize(4);
+  for(int i=0;i<3;i++) home_quat[i] = 0.0;
+  home_quat[3] = 1.0;
+  home_jpos.setSize(num_joints);
+  for(int i=0;i<num_joints;i++) home_jpos[i] = 0.0;
+
+  n.setParam("/"+r_space+"/grasper_name", r_space+"_grasper");
+  n.setParam("/"+r_space+"/num_joints", (double)num_joints);
+  n.setParam("/"+r_space+"/home_pos", home_pos);
+  n.setParam("/"+r_space+"/home_jpos", home_jpos);
+  n.setParam("/"+r_space+"/home_quat", home_quat);
+}
+
+
+/**
+ * @brief      Counts allocations over a benchmark run and reports them per
+ *             iteration, less the spans passed to exclude()
+ */
+class alloc_counter{
+  public:
+    explicit alloc_counter(benchmark::State &s):state(s),start(thread_allocs),excluded(0){};
+    ~alloc_counter(){
+      state.counters["allocs"] = benchmark::Counter((double)(thread_allocs - start - excluded),
+        benchmark::Counter::kAvgIterations);
+    }
+    // leaves out every allocation since the thread_allocs snapshot from
+    void exclude(unsigned long from){
+      excluded += thread_allocs - from;
+    }
+  private:
+    benchmark::State &state;
+    unsigned long start;
+    unsigned long excluded;
+};
+
+
+/**
+ * @brief      Runs a motion generator once per tick. When it finishes (or
+ *             fails) a new motion is started with the timer paused, so only
+ *             steady-state ticks are timed. The allocations of the last
+ *             tick of a motion (its completion log) and of the restart are
+ *             left out of the count the same way.
+ *
+ * @param      state  The benchmark state
+ * @param[in]  fn     One tick of the motion, returns nonzero when done
+ */
+template <typename F>
+static void run_motion(benchmark::State &state, F fn){
+  ros::Time t(1000, 0);
+  robot->arm.start_motion(t);
+  fn(t);
+
+  alloc_counter allocs(state);
+  for(auto _ : state){
+    t = t + tick;
+    unsigned long before = thread_allocs;
+    char out = fn(t);
+    benchmark::DoNotOptimize(out);
+    if(out){
+      state.PauseTiming();
+      robot->arm.start_motion(t);
+      fn(t);
+      allocs.exclude(before);
+      state.ResumeTiming();
+    }
+  }
+  robot->arm.cancel_motion();
+}
+
+
+static void BM_go_to_pos(benchmark::State &state){
+  tf::Transform goal(tf::Quaternion(tf::Vector3(0,0,1), 0.5), tf::Vector3(0.05,0.02,-0.03));
+  run_motion(state, [&](const ros::Time &t){ return robot->arm.go_to_pos(goal, t); });
+}
+
+static void BM_go_to_jpos(benchmark::State &state){
+  float goal[MAX_JOINTS];
+  for(int i=0;i<MAX_JOINTS;i++) goal[i] = 0.5;
+  run_motion(state, [&](const ros::Time &t){ return robot->arm.go_to_jpos(1, goal, t, num_joints); });
+}
+
+static void BM_send_servo_cp_distance(benchmark::State &state){
+  tf::Vector3 dir(1,0,0);
+  run_motion(state, [&](const ros::Time &t){ return robot->arm.send_servo_cp_distance(dir, 0.05, t); });
+}
+
+static void BM_send_servo_cr_rot_time(benchmark::State &state){
+  tf::Vector3 axis(0,0,1);
+  run_motion(state, [&](const ros::Time &t){ return robot->arm.send_servo_cr_rot_time(axis, 0.5, 5, t); });
+}
+
+static void BM_send_servo_cv_rot_time(benchmark::State &state){
+  tf::Vector3 axis(0,0,1);
+  run_motion(state, [&](const ros::Time &t){ return robot->arm.send_servo_cv_rot_time(axis, 0.5, 5, t); });
+}
+
+static void BM_send_servo_cp_rot_angle(benchmark::State &state){
+  tf::Vector3 axis(0,0,1);
+  run_motion(state, [&](const ros::Time &t){ return robot->arm.send_servo_cp_rot_angle(axis, 1.0, t); });
+}
+
+
+static void BM_measured_js_cb(benchmark::State &state){
+  sensor_msgs::JointState::Ptr js(new sensor_msgs::JointState);
+  for(int i=0;i<num_joints;i++){
+    js->name.push_back("joint_" + std::to_string(i));
+    js->position.push_back(0.1*i);
+    js->velocity.push_back(0.01*i);
+    js->effort.push_back(0.001*i);
+  }
+  js->header.stamp = ros::Time::now();
+  sensor_msgs::JointState::ConstPtr js_c = js;
+
+  alloc_counter allocs(state);
+  for(auto _ : state)
+    robot->crtk_measured_js_arm_cb(js_c);
+}
+
+
+/**
+ * @brief      Times one publish_servo_* call, with a command set once
+ *
+ * @param      state    The benchmark state
+ * @param[in]  publish  The publish function
+ */
+static void BM_publish_servo(benchmark::State &state, void (CRTK_robot::*publish)()){
+  float jp[MAX_JOINTS] = {0};
+  robot->arm.send_servo_cr(tf::Transform(tf::Quaternion(0,0,0,1), tf::Vector3(0.001,0,0)));
+  robot->arm.send_servo_cp(tf::Transform(tf::Quaternion(0,0,0,1), tf::Vector3(0,0,0)));
+  robot->arm.send_servo_cv(tf::Transform(tf::Quaternion(0,0,0,1), tf::Vector3(0.01,0,0)));
+  robot->arm.send_servo_jr(jp);
+  robot->arm.send_servo_jp(jp);
+  robot->arm.send_servo_jv(jp);
+  robot->arm.send_servo_jr_grasp(0);
+  robot->arm.send_servo_jp_grasp(0);
+  robot->arm.send_servo_jv_grasp(0);
+
+  alloc_counter allocs(state);
+  for(auto _ : state)
+    (robot->*publish)();
+}
+
+
+/**
+ * @brief      The main function
+ *
+ * @param[in]  argc  The argc
+ * @param      argv  The argv
+ *
+ * @return     0
+ */
+int main(int argc, char **argv){
+
+  ros::init(argc, argv, "crtk_bench_hot_paths");
+  static ros::NodeHandle n("~");
+  n.getParam("num_joints", num_joints);
+
+  benchmark::Initialize(&argc, argv);
+
+  // nobody subscribes to this namespace
+  std::string r_space = "crtk_bench_hot_paths";
+  set_bench_params(n, r_space, num_joints);
+  CRTK_robot bench_robot(n, r_space);
+  robot = &bench_robot;
+
+  benchmark::RegisterBenchmark("go_to_pos", BM_go_to_pos);
+  benchmark::RegisterBenchmark("go_to_jpos", BM_go_to_jpos);
+  benchmark::RegisterBenchmark("send_servo_cp_distance", BM_send_servo_cp_distance);
+  benchmark::RegisterBenchmark("send_servo_cr_rot_time", BM_send_servo_cr_rot_time);
+  benchmark::RegisterBenchmark("send_servo_cv_rot_time", BM_send_servo_cv_rot_time);
+  benchmark::RegisterBenchmark("send_servo_cp_rot_angle", BM_send_servo_cp_rot_angle);
+  benchmark::RegisterBenchmark("crtk_measured_js_arm_cb", BM_measured_js_cb);
+
+  struct { const char *name; void (CRTK_robot::*fn)(); } publishers[] = {
+    {"publish_servo_cr",       &CRTK_robot::publish_servo_cr},
+    {"publish_servo_cp",       &CRTK_robot::publish_servo_cp},
+    {"publish_servo_cv",       &CRTK_robot::publish_servo_cv},
+    {"publish_servo_jr",       &CRTK_robot::publish_servo_jr},
+    {"publish_servo_jp",       &CRTK_robot::publish_servo_jp},
+    {"publish_servo_jv",       &CRTK_robot::publish_servo_jv},
+    {"publish_servo_jr_grasp", &CRTK_robot::publish_servo_jr_grasp},
+    {"publish_servo_jp_grasp", &CRTK_robot::publish_servo_jp_grasp},
+    {"publish_servo_jv_grasp", &CRTK_robot::publish_servo_jv_grasp},
+  };
+  for(auto &p : publishers){
+    void (CRTK_robot::*fn)() = p.fn;
+    benchmark::RegisterBenchmark(p.name, [fn](benchmark::State &state){ BM_publish_servo(state, fn); });
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
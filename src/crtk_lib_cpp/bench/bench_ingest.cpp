@@ -0,0 +1,173 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford,
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * bench_ingest.cpp
+ *
+ * \brief Microbenchmark for the measured_js / measured_cp / operating_state
+ *  ingest path and the servo_* publish path. Compares the per-message copy
+ *  the old by-value callbacks paid against the ConstPtr callbacks, and
+ *  reports how many messages the publish path allocated. Needs a running
+ *  roscore.
+ *
+ *  rosrun crtk_lib_cpp crtk_bench_ingest _iterations:=100000 _num_joints:=7
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include <crtk_lib_cpp/crtk_robot.h>
+#include <chrono>
+
+static volatile double sink;
+
+
+/**
+ * @brief      Loads the parameters CRTK_robot expects for a fake arm namespace
+ *
+ * @param      n           ros node handle
+ * @param[in]  r_space     The robot namespace
+ * @param[in]  num_joints  The number of joints
+ */
+void set_bench_params(ros::NodeHandle &n, std::string r_space, int num_joints){
+  XmlRpc::XmlRpcValue home_pos, home_jpos, home_quat;
+
+  home_pos.setSize(3);
+  for(int i=0;i<3;i++) home_pos[i] = 0.0;
+  home_quat.setSize(4);
+  for(int i=0;i<3;i++) home_quat[i] = 0.0;
+  home_quat[3] = 1.0;
+  home_jpos.setSize(num_joints);
+  for(int i=0;i<num_joints;i++) home_jpos[i] = 0.0;
+
+  n.setParam("/"+r_space+"/grasper_name", r_space+"_grasper");
+  n.setParam("/"+r_space+"/num_joints", (double)num_joints);
+  n.setParam("/"+r_space+"/home_pos", home_pos);
+  n.setParam("/"+r_space+"/home_jpos", home_jpos);
+  n.setParam("/"+r_space+"/home_quat", home_quat);
+}
+
+
+/**
+ * @brief      Reports the time per call of a timed loop
+ *
+ * @param[in]  name        The benchmark name
+ * @param[in]  start       The start time
+ * @param[in]  iterations  The number of iterations
+ */
+void report(const char *name, std::chrono::steady_clock::time_point start, int iterations){
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  ROS_INFO("%-40s %10.1f ns/msg", name, ns/iterations);
+}
+
+
+/**
+ * @brief      The main function
+ *
+ * @param[in]  argc  The argc
+ * @param      argv  The argv
+ *
+ * @return     0
+ */
+int main(int argc, char **argv){
+
+  ros::init(argc, argv, "crtk_bench_ingest");
+  static ros::NodeHandle n("~");
+
+  int iterations = 100000;
+  int num_joints = 7;
+  n.getParam("iterations", iterations);
+  n.getParam("num_joints", num_joints);
+
+  std::string r_space = "crtk_bench";
+  set_bench_params(n, r_space, num_joints);
+  CRTK_robot robot(n, r_space);
+
+  sensor_msgs::JointState::Ptr js(new sensor_msgs::JointState);
+  for(int i=0;i<num_joints;i++){
+    js->name.push_back("joint_" + std::to_string(i));
+    js->position.push_back(0.1*i);
+    js->velocity.push_back(0.01*i);
+    js->effort.push_back(0.001*i);
+  }
+  geometry_msgs::TransformStamped::Ptr cp(new geometry_msgs::TransformStamped);
+  cp->transform.rotation.w = 1;
+  crtk_msgs::operating_state::Ptr os(new crtk_msgs::operating_state);
+  os->state = "ENABLED";
+  os->is_homed = 1;
+
+  sensor_msgs::JointState::ConstPtr js_c = js;
+  geometry_msgs::TransformStamped::ConstPtr cp_c = cp;
+  crtk_msgs::operating_state::ConstPtr os_c = os;
+
+  ROS_INFO("%d iterations, %d joints", iterations, num_joints);
+
+  // what every by-value callback paid before it ran
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(int i=0;i<iterations;i++){
+    sensor_msgs::JointState copy(*js_c);
+    sink = copy.position[0];
+  }
+  report("measured_js by-value copy", start, iterations);
+
+  start = std::chrono::steady_clock::now();
+  for(int i=0;i<iterations;i++){
+    geometry_msgs::TransformStamped copy(*cp_c);
+    sink = copy.transform.rotation.w;
+  }
+  report("measured_cp by-value copy", start, iterations);
+
+  start = std::chrono::steady_clock::now();
+  for(int i=0;i<iterations;i++){
+    crtk_msgs::operating_state copy(*os_c);
+    sink = copy.is_homed;
+  }
+  report("operating_state by-value copy", start, iterations);
+
+  // the ConstPtr callbacks themselves
+  start = std::chrono::steady_clock::now();
+  for(int i=0;i<iterations;i++)
+    robot.crtk_measured_js_arm_cb(js_c);
+  report("crtk_measured_js_arm_cb (ConstPtr)", start, iterations);
+
+  start = std::chrono::steady_clock::now();
+  for(int i=0;i<iterations;i++)
+    robot.crtk_measured_cp_arm_cb(cp_c);
+  report("crtk_measured_cp_arm_cb (ConstPtr)", start, iterations);
+
+  start = std::chrono::steady_clock::now();
+  for(int i=0;i<iterations;i++)
+    robot.state.operating_state_cb(os_c);
+  report("operating_state_cb (ConstPtr)", start, iterations);
+
+  // publish path: steady state should not allocate
+  float jp[MAX_JOINTS] = {0};
+  unsigned long allocs = robot.get_publish_alloc_count();
+  start = std::chrono::steady_clock::now();
+  for(int i=0;i<iterations;i++){
+    robot.arm.send_servo_jp(jp);
+    robot.arm.send_servo_jp_grasp(0);
+    robot.run();
+  }
+  report("run() with servo_jp + servo_jp_grasp", start, iterations);
+  ROS_INFO("publish allocations: %lu over %d iterations",
+    robot.get_publish_alloc_count() - allocs, iterations);
+
+  return 0;
+}
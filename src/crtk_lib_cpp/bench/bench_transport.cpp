@@ -0,0 +1,171 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * bench_transport.cpp
+ *
+ * \brief One-way latency and jitter of a 1 kHz measured_js-sized
+ *  JointState on loopback for each transport CRTK_transport accepts. A
+ *  forked publisher node stamps every message just before publishing; this
+ *  node subscribes with one transport after the other and reports receive
+ *  time minus stamp (mean/p50/p99/max), its spread p99 - p50 as jitter, and
+ *  the messages lost (sequence gaps, UDP only). Needs a running roscore.
+ *
+ *  rosrun crtk_lib_cpp crtk_bench_transport _samples:=5000 _num_joints:=7
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include <crtk_lib_cpp/crtk_transport.h>
+#include <crtk_lib_cpp/crtk_rt_loop.h>
+#include <crtk_lib_cpp/crtk_histogram.h>
+#include <crtk_lib_cpp/defines.h>
+#include <sensor_msgs/JointState.h>
+#include <ros/callback_queue.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const std::string bench_topic = "/crtk_bench_transport/measured_js";
+
+
+/**
+ * Latency of the messages received with one transport
+ */
+struct bench_stats{
+  CRTK_histogram latency;
+  unsigned long received;
+  unsigned long lost;
+  unsigned long last_seq;
+  int warmup;
+
+  void cb(const sensor_msgs::JointState::ConstPtr& msg){
+    int64_t ns = (ros::Time::now() - msg->header.stamp).toNSec();
+    if(warmup > 0){
+      warmup--;
+      last_seq = msg->header.seq;
+      return;
+    }
+    if(msg->header.seq > last_seq + 1)
+      lost += msg->header.seq - last_seq - 1;
+    last_seq = msg->header.seq;
+    latency.add(ns);
+    received++;
+  }
+};
+
+
+/**
+ * @brief      Publishes stamped joint states at LOOP_RATE until interrupted
+ *
+ * @param[in]  argc  The argc
+ * @param      argv  The argv
+ *
+ * @return     0
+ */
+int run_publisher(int argc, char **argv){
+  ros::init(argc, argv, "crtk_bench_transport_pub");
+  ros::NodeHandle n("~");
+
+  int num_joints = 7;
+  n.getParam("num_joints", num_joints);
+
+  ros::Publisher pub = n.advertise<sensor_msgs::JointState>(bench_topic, 10);
+  sensor_msgs::JointState msg;
+  msg.position.resize(num_joints);
+  msg.velocity.resize(num_joints);
+  msg.effort.resize(num_joints);
+
+  CRTK_rt_loop loop_rate(n, LOOP_RATE);
+  while(ros::ok()){
+    msg.header.stamp = ros::Time::now();
+    pub.publish(msg);
+    loop_rate.sleep();
+  }
+  return 0;
+}
+
+
+/**
+ * @brief      Receives samples messages with one transport and reports them
+ *
+ * @param      n        ros node handle
+ * @param[in]  spec     The transport, as in the transport parameter
+ * @param[in]  samples  The number of messages to time
+ */
+void run_transport(ros::NodeHandle &n, const std::string &spec, int samples){
+  bench_stats stats;
+  stats.received = 0;
+  stats.lost = 0;
+  stats.last_seq = 0;
+  stats.warmup = LOOP_RATE/2;
+
+  ros::Subscriber sub = n.subscribe(bench_topic, 100, &bench_stats::cb, &stats,
+    CRTK_transport::parse(spec));
+
+  ros::WallTime give_up = ros::WallTime::now() + ros::WallDuration(10 + 2.0*samples/LOOP_RATE);
+  while(ros::ok() && (int)stats.received < samples && ros::WallTime::now() < give_up)
+    ros::getGlobalCallbackQueue()->callAvailable(ros::WallDuration(0.01));
+  sub.shutdown();
+
+  if(stats.received == 0){
+    ROS_ERROR("%-12s no messages received", spec.c_str());
+    return;
+  }
+
+  CRTK_histogram_summary s;
+  stats.latency.summarize(&s);
+  ROS_INFO("%-12s %8lu msgs  latency mean %7.1f  p50 %7.1f  p99 %7.1f  max %8.1f us  jitter %7.1f us  lost %lu",
+    spec.c_str(), s.count, 1e6*s.mean, 1e6*s.p50, 1e6*s.p99, 1e6*s.max, 1e6*(s.p99 - s.p50), stats.lost);
+}
+
+
+/**
+ * @brief      The main function
+ *
+ * @param[in]  argc  The argc
+ * @param      argv  The argv
+ *
+ * @return     0
+ */
+int main(int argc, char **argv){
+
+  // fork before ros::init: a subscriber in the publishing node would get
+  // the messages intra-process and bypass the transport
+  pid_t publisher = fork();
+  if(publisher == 0)
+    return run_publisher(argc, argv);
+
+  ros::init(argc, argv, "crtk_bench_transport");
+  static ros::NodeHandle n("~");
+
+  int samples = 5000;
+  n.getParam("samples", samples);
+
+  ROS_INFO("%d samples per transport at %d Hz", samples, LOOP_RATE);
+  const char *specs[] = {"tcp", "tcp_nodelay", "udp"};
+  for(int i=0;i<3 && ros::ok();i++)
+    run_transport(n, specs[i], samples);
+
+  kill(publisher, SIGINT);
+  waitpid(publisher, NULL, 0);
+  return 0;
+}
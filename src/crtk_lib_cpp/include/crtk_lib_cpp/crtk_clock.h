@@ -0,0 +1,41 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_clock.h
+ *
+ * \brief Time base for the timed motion primitives and the app loops.
+ *  Monotonic with nanosecond resolution on a real robot; follows /clock when
+ *  use_sim_time is set.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_CLOCK_H_
+#define CRTK_CLOCK_H_
+
+#include <ros/ros.h>
+
+class CRTK_clock{
+public:
+  static ros::Time now();
+};
+
+#endif
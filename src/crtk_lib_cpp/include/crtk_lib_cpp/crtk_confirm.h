@@ -0,0 +1,76 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * crtk_confirm.h
+ *
+ * \brief Operator confirmations for the test nodes that never block the
+ *  loop. Answers come from stdin (read on a background thread, so they can
+ *  also be piped in) or from std_msgs/String messages on the node's private
+ *  confirm topic, and are consumed in the order they arrive.
+ *
+ *  With the private parameter confirm set to auto nobody has to answer:
+ *  "press Enter" prompts pass straight away and "did the robot move?"
+ *  prompts are answered from measured_js and measured_cp. The caller passes
+ *  what the arm should have done, e.g. a joint displacement since
+ *  start_motion. Once the arm has been still for confirm_settle seconds
+ *  (default 0.5), the answer is yes if the measured motion is within
+ *  confirm_tol (default 0.25) of that, and no otherwise. An arm still moving
+ *  after confirm_timeout seconds (default 10) is a no. Prompts that say
+ *  nothing measurable wait for an answer on the confirm topic and are a
+ *  no after confirm_timeout.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_CONFIRM_H_
+#define CRTK_CONFIRM_H_
+
+#include <ros/ros.h>
+#include <std_msgs/String.h>
+#include <tf/tf.h>
+#include <string>
+
+class CRTK_robot;
+
+class CRTK_confirm{
+public:
+  static void init(const ros::NodeHandle&);
+  static bool is_auto();
+  static int enter();
+  static int yes_no();
+  static int yes_no(CRTK_robot *robot, int joint, float displacement);
+  static int yes_no(CRTK_robot *robot, const float *jpos);
+  static int yes_no(CRTK_robot *robot, const tf::Transform& start, const tf::Vector3& displacement);
+  static int yes_no(CRTK_robot *robot, const tf::Transform& start, float angle);
+  static void watch(CRTK_robot *robot);
+  static int yes_no_peak(CRTK_robot *robot, const tf::Vector3& translation, const tf::Vector3& rotation);
+  static void push(const std::string&);
+
+private:
+  static void confirm_cb(const std_msgs::String::ConstPtr&);
+  static bool pop(std::string*);
+  static int typed();
+  static int settle(CRTK_robot *robot);
+  static int verdict(bool ok, const char *what, double measured, double expected);
+};
+
+#endif
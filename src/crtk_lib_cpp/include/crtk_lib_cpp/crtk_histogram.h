@@ -0,0 +1,231 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_histogram.h
+ *
+ * \brief Lock-free latency histogram for the control loop. Any thread may
+ *  add() samples (relaxed atomic increments, no locks, no allocation);
+ *  one reader thread periodically calls summarize() or report(), which
+ *  cover the samples added since its previous call.
+ *
+ *  Buckets are log-linear in nanoseconds, 4 per power of two, so every
+ *  reported percentile is within 25% (upper bound of its bucket) from 1 ns
+ *  up to ~2 minutes.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_HISTOGRAM_H_
+#define CRTK_HISTOGRAM_H_
+
+#include <atomic>
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <diagnostic_msgs/DiagnosticStatus.h>
+
+#define CRTK_HIST_SUB_BITS 2
+#define CRTK_HIST_SUB (1 << CRTK_HIST_SUB_BITS)
+#define CRTK_HIST_BUCKETS (CRTK_HIST_SUB * 36)
+
+struct CRTK_histogram_summary{
+  unsigned long count;
+  double mean;     // all in seconds
+  double p50;
+  double p99;
+  double max;
+};
+
+class CRTK_histogram{
+public:
+  CRTK_histogram();
+  ~CRTK_histogram(){};
+
+  void add(int64_t ns);
+  void summarize(CRTK_histogram_summary*);
+  void report(diagnostic_msgs::DiagnosticStatus*, const std::string&);
+  unsigned long get_count() const;
+
+private:
+  CRTK_histogram(const CRTK_histogram&);
+  CRTK_histogram& operator=(const CRTK_histogram&);
+
+  static int bucket(int64_t ns);
+  static int64_t bucket_top(int b);
+
+  std::atomic<unsigned long> buckets[CRTK_HIST_BUCKETS];
+  std::atomic<unsigned long> count;
+  std::atomic<int64_t> sum_ns;
+  std::atomic<int64_t> window_max_ns;
+
+  // reader side only
+  unsigned long last_buckets[CRTK_HIST_BUCKETS];
+  unsigned long last_count;
+  int64_t last_sum_ns;
+};
+
+
+inline CRTK_histogram::CRTK_histogram(){
+  for(int i=0;i<CRTK_HIST_BUCKETS;i++){
+    buckets[i].store(0, std::memory_order_relaxed);
+    last_buckets[i] = 0;
+  }
+  count.store(0, std::memory_order_relaxed);
+  sum_ns.store(0, std::memory_order_relaxed);
+  window_max_ns.store(0, std::memory_order_relaxed);
+  last_count = 0;
+  last_sum_ns = 0;
+}
+
+
+/**
+ * @brief      Maps a duration to its bucket
+ *
+ * @param[in]  ns    The duration (ns)
+ *
+ * @return     The bucket index
+ */
+inline int CRTK_histogram::bucket(int64_t ns){
+  if(ns < CRTK_HIST_SUB)
+    return ns < 0 ? 0 : (int)ns;
+
+  int msb = 63 - __builtin_clzll((unsigned long long)ns);
+  int sub = (int)(ns >> (msb - CRTK_HIST_SUB_BITS)) & (CRTK_HIST_SUB - 1);
+  int b = CRTK_HIST_SUB * (msb - CRTK_HIST_SUB_BITS + 1) + sub;
+  return b < CRTK_HIST_BUCKETS ? b : CRTK_HIST_BUCKETS - 1;
+}
+
+
+/**
+ * @brief      Gets the largest duration that falls in a bucket
+ *
+ * @param[in]  b     The bucket index
+ *
+ * @return     The bucket's upper bound (ns)
+ */
+inline int64_t CRTK_histogram::bucket_top(int b){
+  if(b < CRTK_HIST_SUB)
+    return b;
+
+  int shift = b / CRTK_HIST_SUB - 1;
+  int64_t low = (int64_t)(CRTK_HIST_SUB + b % CRTK_HIST_SUB) << shift;
+  return low + ((int64_t)1 << shift) - 1;
+}
+
+
+/**
+ * @brief      Records one sample. Safe to call from any thread.
+ *
+ * @param[in]  ns    The duration (ns)
+ */
+inline void CRTK_histogram::add(int64_t ns){
+  buckets[bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+  sum_ns.fetch_add(ns, std::memory_order_relaxed);
+
+  int64_t m = window_max_ns.load(std::memory_order_relaxed);
+  while(ns > m && !window_max_ns.compare_exchange_weak(m, ns, std::memory_order_relaxed));
+
+  count.fetch_add(1, std::memory_order_release);
+}
+
+
+/**
+ * @brief      Summarizes the samples added since the last call. Only one
+ *             thread may summarize a histogram.
+ *
+ * @param      out   The summary
+ */
+inline void CRTK_histogram::summarize(CRTK_histogram_summary *out){
+  unsigned long total = count.load(std::memory_order_acquire);
+  int64_t sum = sum_ns.load(std::memory_order_relaxed);
+  int64_t max = window_max_ns.exchange(0, std::memory_order_relaxed);
+
+  unsigned long window[CRTK_HIST_BUCKETS];
+  unsigned long n = 0;
+  for(int i=0;i<CRTK_HIST_BUCKETS;i++){
+    unsigned long c = buckets[i].load(std::memory_order_relaxed);
+    window[i] = c - last_buckets[i];
+    last_buckets[i] = c;
+    n += window[i];
+  }
+
+  out->count = total - last_count;
+  out->mean = out->count ? (sum - last_sum_ns) / 1e9 / out->count : 0;
+  out->max = max / 1e9;
+  last_count = total;
+  last_sum_ns = sum;
+
+  // percentiles from the bucket counts, capped at the exact window max
+  out->p50 = 0;
+  out->p99 = 0;
+  unsigned long seen = 0;
+  bool have_p50 = false;
+  for(int i=0;i<CRTK_HIST_BUCKETS && n;i++){
+    seen += window[i];
+    if(!have_p50 && 2*seen >= n){
+      out->p50 = bucket_top(i) / 1e9;
+      have_p50 = true;
+    }
+    if(100*seen >= 99*n){
+      out->p99 = bucket_top(i) / 1e9;
+      break;
+    }
+  }
+  if(out->p50 > out->max) out->p50 = out->max;
+  if(out->p99 > out->max) out->p99 = out->max;
+}
+
+
+/**
+ * @brief      Summarizes the samples since the last call into diagnostic
+ *             key/values named "<name> count/mean/p50/p99/max"; times in us.
+ *
+ * @param      status  The diagnostic status to append to
+ * @param[in]  name    The histogram name
+ */
+inline void CRTK_histogram::report(diagnostic_msgs::DiagnosticStatus *status, const std::string &name){
+  CRTK_histogram_summary s;
+  summarize(&s);
+
+  const char *keys[5] = {" count", " mean (us)", " p50 (us)", " p99 (us)", " max (us)"};
+  double vals[5] = {(double)s.count, 1e6*s.mean, 1e6*s.p50, 1e6*s.p99, 1e6*s.max};
+
+  for(int i=0;i<5;i++){
+    char buf[32];
+    snprintf(buf, sizeof(buf), i ? "%.1f" : "%.0f", vals[i]);
+    diagnostic_msgs::KeyValue kv;
+    kv.key = name + keys[i];
+    kv.value = buf;
+    status->values.push_back(kv);
+  }
+}
+
+
+/**
+ * @brief      Gets the number of samples added since construction.
+ *
+ * @return     The sample count.
+ */
+inline unsigned long CRTK_histogram::get_count() const{
+  return count.load(std::memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,492 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford,
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_interp.h
+ *
+ * \brief CRTK interp_* mode: timestamped setpoints arriving at a low rate
+ *  are buffered and resampled every control tick. The curve is rendered a
+ *  fixed delay behind the current time, so the setpoint after the one being
+ *  left has normally arrived already: positions follow a cubic Hermite
+ *  (Catmull-Rom) spline and orientations a squad quaternion spline.
+ *
+ *  The tangents of a segment are fixed when the renderer enters it, and its
+ *  start tangent is the end tangent of the previous one, so the output stays
+ *  continuous in velocity even if setpoints arrive late.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_INTERP_H_
+#define CRTK_INTERP_H_
+
+#include "crtk_seqlock.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <ros/ros.h>
+#include <tf/tf.h>
+
+
+/**
+ * The last few setpoints of an interp_* stream. Shared between the
+ * subscriber callback and the control loop through a CRTK_seqlock.
+ */
+template <typename Sample>
+struct CRTK_interp_buffer{
+  enum {DEPTH = 8};
+
+  CRTK_interp_buffer():count(0){};
+
+  double stamp[DEPTH];
+  Sample sample[DEPTH];
+  unsigned long count;    // setpoints received so far
+
+  unsigned long oldest() const{ return count > DEPTH ? count - DEPTH : 0; }
+  double t(unsigned long k) const{ return stamp[k % DEPTH]; }
+  const Sample& at(unsigned long k) const{ return sample[k % DEPTH]; }
+};
+
+
+/**
+ * @brief      Adjusts a new setpoint to the previous one before it is
+ *             stored. Nothing to do by default.
+ */
+template <typename Sample>
+inline void CRTK_interp_align(const Sample&, Sample*){}
+
+
+/**
+ * Segment bookkeeping shared by the joint and Cartesian interpolators.
+ * Lives on the control loop side only.
+ */
+template <typename Sample>
+class CRTK_interp_stream{
+public:
+  typedef CRTK_interp_buffer<Sample> buffer;
+
+  CRTK_interp_stream():delay(0),auto_delay(true),last_now(0),timeout(0.1),segment(0),in_segment(false),streaming(false){};
+
+  void set_delay(double d){ auto_delay = d <= 0; delay = auto_delay ? 0 : d; }
+  void set_timeout(double t){ timeout = t; }
+  double get_delay() const{ return delay; }
+  bool is_streaming() const{ return streaming; }
+
+  char push(double t, const Sample &s);
+
+protected:
+  char locate(double now, buffer *b, unsigned long *k, double *u);
+  char enter(unsigned long k);
+  void track_delay(double now, const buffer &b);
+
+  CRTK_seqlock<buffer> samples;
+  double delay;      // render time behind now (s), the added latency
+  bool auto_delay;   // delay follows twice the measured setpoint interval
+  double last_now;
+  double timeout;    // stop once the newest setpoint is this much older than the render time (s)
+  unsigned long segment;
+  bool in_segment;
+  bool streaming;
+};
+
+
+/**
+ * @brief      Adds a setpoint to the stream. Safe to call from any thread.
+ *
+ * @param[in]  t     The setpoint time (s)
+ * @param[in]  s     The setpoint
+ *
+ * @return     success 0, fail -1 (not newer than the last setpoint)
+ */
+template <typename Sample>
+char CRTK_interp_stream<Sample>::push(double t, const Sample &s){
+  buffer *b = samples.write_begin();
+  char out = -1;
+  if(b->count == 0 || t > b->t(b->count-1)){
+    Sample &slot = b->sample[b->count % buffer::DEPTH];
+    slot = s;
+    if(b->count > 0)
+      CRTK_interp_align(b->at(b->count-1), &slot);
+    b->stamp[b->count % buffer::DEPTH] = t;
+    b->count++;
+    out = 0;
+  }
+  samples.write_end();
+  return out;
+}
+
+
+/**
+ * @brief      Finds the segment holding the render time now - delay
+ *
+ * @param[in]  now   The current time (s)
+ * @param      b     The buffer copy to render from
+ * @param      k     The segment start, or the setpoint to hold
+ * @param      u     The fraction of the segment
+ *
+ * @return     1 inside a segment, 0 to hold setpoint k, -1 for no output
+ */
+template <typename Sample>
+char CRTK_interp_stream<Sample>::locate(double now, buffer *b, unsigned long *k, double *u){
+  samples.load(b);
+  if(b->count == 0)
+    return -1;
+
+  if(auto_delay)
+    track_delay(now, *b);
+  double t = now - delay;
+  unsigned long newest = b->count - 1;
+  unsigned long oldest = b->oldest();
+
+  if(t - b->t(newest) > timeout){
+    if(streaming)
+      ROS_WARN("interp: no new setpoint for %f sec, stopping.", t - b->t(newest));
+    streaming = false;
+    in_segment = false;
+    return -1;
+  }
+  if(t < b->t(oldest))
+    return -1;
+  streaming = true;
+
+  // starved: hold the newest setpoint until the next one arrives
+  if(t >= b->t(newest)){
+    in_segment = false;
+    *k = newest;
+    return 0;
+  }
+
+  unsigned long i = newest - 1;
+  while(i > oldest && b->t(i) > t)
+    i--;
+  *k = i;
+  *u = (t - b->t(i)) / (b->t(i+1) - b->t(i));
+  return 1;
+}
+
+
+/**
+ * @brief      Keeps the automatic delay at two mean setpoint intervals over
+ *             the buffer, so the next setpoint is in hand even if it arrives
+ *             up to a period late. The delay changes by at most a tenth of
+ *             the elapsed time, so the render time never runs backwards.
+ *
+ * @param[in]  now   The current time (s)
+ * @param[in]  b     The buffer copy to render from
+ */
+template <typename Sample>
+void CRTK_interp_stream<Sample>::track_delay(double now, const buffer &b){
+  unsigned long newest = b.count - 1;
+  unsigned long oldest = b.oldest();
+  if(newest == oldest){
+    last_now = now;
+    return;
+  }
+
+  double target = 2 * (b.t(newest) - b.t(oldest)) / (double)(newest - oldest);
+  double slew = 0.1 * (now - last_now);
+  if(delay == 0)
+    delay = target;
+  else if(slew > 0)
+    delay += std::max(-slew, std::min(slew, target - delay));
+  last_now = now;
+}
+
+
+/**
+ * @brief      Moves the renderer to segment k
+ *
+ * @return     -1 if already in it, 1 if k continues the previous segment (so
+ *             its start tangent is the previous end tangent), 0 otherwise
+ */
+template <typename Sample>
+char CRTK_interp_stream<Sample>::enter(unsigned long k){
+  if(in_segment && k == segment)
+    return -1;
+  char continues = in_segment && k == segment + 1;
+  segment = k;
+  in_segment = true;
+  return continues;
+}
+
+
+/**
+ * Joint setpoints: one cubic Hermite spline per joint.
+ */
+template <int Capacity, typename Scalar>
+struct CRTK_interp_jp_sample{
+  std::array<Scalar, Capacity> jp;
+  int length;
+};
+
+template <int Capacity, typename Scalar>
+class CRTK_interp_jp_t : public CRTK_interp_stream< CRTK_interp_jp_sample<Capacity,Scalar> >{
+public:
+  typedef CRTK_interp_jp_sample<Capacity,Scalar> sample;
+  typedef CRTK_interp_buffer<sample> buffer;
+
+  char push(double t, const Scalar *jp, int length);
+  char get_jp(double now, Scalar *out, int *length);
+
+private:
+  static double tangent(const buffer &b, unsigned long i, int j);
+
+  std::array<double, Capacity> m0, m1;
+};
+
+
+/**
+ * @brief      Adds a joint setpoint
+ *
+ * @param[in]  t       The setpoint time (s)
+ * @param[in]  jp      The joint positions
+ * @param[in]  length  The number of joints
+ *
+ * @return     success 0, fail -1
+ */
+template <int Capacity, typename Scalar>
+char CRTK_interp_jp_t<Capacity,Scalar>::push(double t, const Scalar *jp, int length){
+  if(length > Capacity)
+    return -1;
+  sample s;
+  s.length = length;
+  for(int j=0;j<length;j++)
+    s.jp[j] = jp[j];
+  return CRTK_interp_stream<sample>::push(t, s);
+}
+
+
+/**
+ * @brief      Velocity at setpoint i: central difference, one-sided at the
+ *             ends of the buffer
+ */
+template <int Capacity, typename Scalar>
+double CRTK_interp_jp_t<Capacity,Scalar>::tangent(const buffer &b, unsigned long i, int j){
+  unsigned long lo = i > b.oldest() ? i-1 : i;
+  unsigned long hi = i+1 < b.count ? i+1 : i;
+  if(lo == hi)
+    return 0;
+  return ((double)b.at(hi).jp[j] - (double)b.at(lo).jp[j]) / (b.t(hi) - b.t(lo));
+}
+
+
+/**
+ * @brief      Gets the joint setpoint for this tick
+ *
+ * @param[in]  now     The current time (s)
+ * @param      out     The joint positions
+ * @param      length  The number of joints written
+ *
+ * @return     1 interpolated, 0 holding the newest setpoint, -1 no output
+ */
+template <int Capacity, typename Scalar>
+char CRTK_interp_jp_t<Capacity,Scalar>::get_jp(double now, Scalar *out, int *length){
+  buffer b;
+  unsigned long k;
+  double u;
+  char state = this->locate(now, &b, &k, &u);
+
+  if(state < 0)
+    return -1;
+
+  const sample &p0 = b.at(k);
+  *length = p0.length;
+  if(state == 0){
+    for(int j=0;j<p0.length;j++)
+      out[j] = p0.jp[j];
+    return 0;
+  }
+
+  const sample &p1 = b.at(k+1);
+  int n = std::min(p0.length, p1.length);
+  char entered = this->enter(k);
+  if(entered >= 0){
+    for(int j=0;j<n;j++){
+      m0[j] = entered ? m1[j] : tangent(b, k, j);
+      m1[j] = tangent(b, k+1, j);
+    }
+  }
+
+  // cubic Hermite basis, tangents scaled to the segment length
+  double h = b.t(k+1) - b.t(k);
+  double u2 = u*u, u3 = u2*u;
+  double h00 = 2*u3 - 3*u2 + 1, h10 = u3 - 2*u2 + u;
+  double h01 = -2*u3 + 3*u2,    h11 = u3 - u2;
+  for(int j=0;j<n;j++)
+    out[j] = h00*p0.jp[j] + h10*h*m0[j] + h01*p1.jp[j] + h11*h*m1[j];
+  *length = n;
+  return 1;
+}
+
+
+/**
+ * Cartesian setpoints: Hermite spline on the position, squad on the
+ * orientation.
+ */
+struct CRTK_interp_cp_sample{
+  tf::Vector3 pos;
+  tf::Quaternion rot;
+};
+
+// keeps consecutive quaternions in one hemisphere so every slerp takes the
+// short way
+inline void CRTK_interp_align(const CRTK_interp_cp_sample &prev, CRTK_interp_cp_sample *s){
+  if(s->rot.dot(prev.rot) < 0)
+    s->rot = -s->rot;
+}
+
+class CRTK_interp_cp : public CRTK_interp_stream<CRTK_interp_cp_sample>{
+public:
+  typedef CRTK_interp_cp_sample sample;
+  typedef CRTK_interp_buffer<sample> buffer;
+
+  inline char push(double t, const tf::Transform &cp);
+  inline char get_cp(double now, tf::Transform *out);
+
+private:
+  static inline tf::Vector3 tangent(const buffer &b, unsigned long i);
+  static inline tf::Quaternion control(const buffer &b, unsigned long i);
+  static inline tf::Vector3 quat_log(const tf::Quaternion &q);
+  static inline tf::Quaternion quat_exp(const tf::Vector3 &v);
+
+  tf::Vector3 v0, v1;
+  tf::Quaternion s0, s1;
+};
+
+
+/**
+ * @brief      Adds a Cartesian setpoint
+ *
+ * @param[in]  t     The setpoint time (s)
+ * @param[in]  cp    The pose
+ *
+ * @return     success 0, fail -1
+ */
+char CRTK_interp_cp::push(double t, const tf::Transform &cp){
+  sample s;
+  s.pos = cp.getOrigin();
+  s.rot = cp.getRotation();
+  return CRTK_interp_stream<sample>::push(t, s);
+}
+
+
+/**
+ * @brief      Log of a unit quaternion (half the rotation vector)
+ */
+tf::Vector3 CRTK_interp_cp::quat_log(const tf::Quaternion &q){
+  tf::Vector3 v(q.x(), q.y(), q.z());
+  double s = v.length();
+  if(s < 1e-12)
+    return tf::Vector3(0,0,0);
+  return v * (atan2(s, q.w()) / s);
+}
+
+
+/**
+ * @brief      Exp of a pure quaternion
+ */
+tf::Quaternion CRTK_interp_cp::quat_exp(const tf::Vector3 &v){
+  double a = v.length();
+  if(a < 1e-12)
+    return tf::Quaternion(0,0,0,1);
+  tf::Vector3 axis = v * (sin(a) / a);
+  return tf::Quaternion(axis.x(), axis.y(), axis.z(), cos(a));
+}
+
+
+/**
+ * @brief      Velocity at setpoint i: central difference, one-sided at the
+ *             ends of the buffer
+ */
+tf::Vector3 CRTK_interp_cp::tangent(const buffer &b, unsigned long i){
+  unsigned long lo = i > b.oldest() ? i-1 : i;
+  unsigned long hi = i+1 < b.count ? i+1 : i;
+  if(lo == hi)
+    return tf::Vector3(0,0,0);
+  return (b.at(hi).pos - b.at(lo).pos) / (b.t(hi) - b.t(lo));
+}
+
+
+/**
+ * @brief      Squad control point at setpoint i. Without a neighbour on
+ *             one side the curve starts or ends like a slerp.
+ */
+tf::Quaternion CRTK_interp_cp::control(const buffer &b, unsigned long i){
+  const tf::Quaternion &q = b.at(i).rot;
+  if(i == b.oldest() || i+1 >= b.count)
+    return q;
+
+  tf::Quaternion qi = q.inverse();
+  tf::Vector3 d = quat_log(qi * b.at(i+1).rot) + quat_log(qi * b.at(i-1).rot);
+  return q * quat_exp(d * -0.25);
+}
+
+
+/**
+ * @brief      Gets the Cartesian setpoint for this tick
+ *
+ * @param[in]  now   The current time (s)
+ * @param      out   The pose
+ *
+ * @return     1 interpolated, 0 holding the newest setpoint, -1 no output
+ */
+char CRTK_interp_cp::get_cp(double now, tf::Transform *out){
+  buffer b;
+  unsigned long k;
+  double u;
+  char state = locate(now, &b, &k, &u);
+
+  if(state < 0)
+    return -1;
+
+  const sample &p0 = b.at(k);
+  if(state == 0){
+    out->setOrigin(p0.pos);
+    out->setRotation(p0.rot);
+    return 0;
+  }
+
+  const sample &p1 = b.at(k+1);
+  char entered = enter(k);
+  if(entered > 0){
+    v0 = v1;
+    s0 = s1;
+  }
+  else if(entered == 0){
+    v0 = tangent(b, k);
+    s0 = control(b, k);
+  }
+  if(entered >= 0){
+    v1 = tangent(b, k+1);
+    s1 = control(b, k+1);
+  }
+
+  double h = b.t(k+1) - b.t(k);
+  double u2 = u*u, u3 = u2*u;
+  double h00 = 2*u3 - 3*u2 + 1, h10 = u3 - 2*u2 + u;
+  double h01 = -2*u3 + 3*u2,    h11 = u3 - u2;
+  out->setOrigin(p0.pos*h00 + v0*(h*h10) + p1.pos*h01 + v1*(h*h11));
+
+  tf::Quaternion q = p0.rot.slerp(p1.rot, u).slerp(s0.slerp(s1, u), 2*u*(1-u));
+  out->setRotation(q.normalized());
+  return 1;
+}
+
+#endif
@@ -34,35 +34,97 @@
 #ifndef CRTK_MOTION_H_
 #define CRTK_MOTION_H_
 #include "defines.h"
+#include "crtk_seqlock.h"
+#include "crtk_clock.h"
+#include "crtk_trajectory.h"
+#include "crtk_otg.h"
+#include "crtk_interp.h"
 #include <ctime>
+#include <array>
+#include <atomic>
 #include <ros/ros.h>
 #include <tf/tf.h>
 #include <crtk_msgs/operating_state.h>
 
 // extern const int MAX_JOINTS;
 
-class CRTK_motion{
+// Joint count only known at run time (num_joints), storage for MAX_JOINTS
+#define CRTK_DYNAMIC_JOINTS 0
+
+// Number of joints a CRTK_motion_t works on. With a fixed N the loop bound
+// is a compile-time constant, so per-joint loops unroll and vectorize.
+template <int N>
+struct CRTK_joint_count{
+  enum { capacity = N };
+  int get() const { return N; }
+  char set(int n){ return n == N ? 0 : -1; }
+};
+
+template <>
+struct CRTK_joint_count<CRTK_DYNAMIC_JOINTS>{
+  enum { capacity = MAX_JOINTS };
+  CRTK_joint_count():n(MAX_JOINTS){};
+  int get() const { return n; }
+  char set(int in){
+    if(in < 1 || in > MAX_JOINTS) return -1;
+    n = in;
+    return 0;
+  }
+private:
+  int n;
+};
+
+// One coherent sample of the measured robot state
+template <int N, typename Scalar>
+struct CRTK_measured_snapshot_t{
+  std::array<Scalar, CRTK_joint_count<N>::capacity> js_pos;
+  std::array<Scalar, CRTK_joint_count<N>::capacity> js_vel;
+  std::array<Scalar, CRTK_joint_count<N>::capacity> js_eff;
+  tf::Transform cp;
+};
+
+template <int N, typename Scalar>
+class CRTK_motion_t{
 public:
-  CRTK_motion();
-  ~CRTK_motion(){};
+  enum { capacity = CRTK_joint_count<N>::capacity };
+  typedef std::array<Scalar, capacity> joint_array;
+  typedef CRTK_measured_snapshot_t<N,Scalar> snapshot;
+
+  CRTK_motion_t();
+  ~CRTK_motion_t(){};
+  char set_num_joints(int);
+  int get_num_joints();
   tf::Transform get_measured_cp();
-  void set_measured_cp(tf::Transform);
+  void set_measured_cp(const tf::Transform&);
 
-  float get_measured_js_pos(int);
-  int get_measured_js_pos(float*, int);
-  int set_measured_js_pos(int, float);
-  int set_measured_js_pos(float*, int);
+  snapshot get_measured_snapshot();
+  void get_measured_snapshot(snapshot*);
+  unsigned long get_measured_version();
+  int set_measured_js(Scalar*, Scalar*, Scalar*, int);
+  int set_measured_js(const double*, const double*, const double*, int);
 
-  float get_measured_js_vel(int);
-  int get_measured_js_vel(float*, int);
-  int set_measured_js_vel(int, float);
-  int set_measured_js_vel(float*, int);
+  Scalar get_measured_js_pos(int);
+  int get_measured_js_pos(Scalar*, int);
+  int set_measured_js_pos(int, Scalar);
+  int set_measured_js_pos(Scalar*, int);
 
-  float get_measured_js_eff(int);
-  int get_measured_js_eff(float*, int);
-  int set_measured_js_eff(int, float);
-  int set_measured_js_eff(float*, int);
+  Scalar get_measured_js_vel(int);
+  int get_measured_js_vel(Scalar*, int);
+  int set_measured_js_vel(int, Scalar);
+  int set_measured_js_vel(Scalar*, int);
 
+  Scalar get_measured_js_eff(int);
+  int get_measured_js_eff(Scalar*, int);
+  int set_measured_js_eff(int, Scalar);
+  int set_measured_js_eff(Scalar*, int);
+
+  char send_servo_cr_time(tf::Vector3,float,float,const ros::Time&);
+  char send_servo_cv_time(tf::Vector3,float,float,const ros::Time&);
+  char send_servo_cp_distance(tf::Vector3,float,const ros::Time&);
+  char send_servo_cr_rot_time(tf::Vector3,float,float,const ros::Time&);
+  char send_servo_cv_rot_time(tf::Vector3,float,float,const ros::Time&);
+  char send_servo_cp_rot_angle(tf::Vector3,float,const ros::Time&);
+  // time_t forms keep the old 1 s resolution; pass CRTK_clock::now() instead
   char send_servo_cr_time(tf::Vector3,float,float,time_t);
   char send_servo_cv_time(tf::Vector3,float,float,time_t);
   char send_servo_cp_distance(tf::Vector3,float,time_t);
@@ -73,11 +135,18 @@ public:
   char send_servo_cr(tf::Transform);
   char send_servo_cv(tf::Transform);
   char send_servo_cp(tf::Transform);
-  char send_servo_jr(float*);
-  char send_servo_jp(float*);
-  char send_servo_jv(float*);
-  char send_servo_jr_grasp(float);
-  char send_servo_jv_grasp(float);
+  char send_servo_jr(Scalar*);
+  char send_servo_jp(Scalar*);
+  char send_servo_jv(Scalar*);
+  char send_servo_jr_grasp(Scalar);
+  char send_servo_jp_grasp(Scalar);
+  char send_servo_jv_grasp(Scalar);
+
+  char send_interp_jp(Scalar*, const ros::Time&, int length = capacity);
+  char send_interp_cp(tf::Transform, const ros::Time&);
+  char interp_tick(const ros::Time&);
+  void set_interp_delay(double);
+  void set_interp_timeout(double);
 
   void reset_servo_cr_updated();
   void reset_servo_cv_updated();
@@ -98,54 +167,76 @@ public:
   char get_servo_cr_updated();
   char get_servo_cv_updated();
   char get_servo_cp_updated();
+  char get_servo_updated(CRTK_servo_channel);
+  void reset_servo_updated(CRTK_servo_channel);
+  unsigned long get_servo_superseded(CRTK_servo_channel);
 
   tf::Transform get_servo_cr_command();
   tf::Transform get_servo_cv_command();
   tf::Transform get_servo_cp_command();
-  void get_servo_jr_command(float*, int);
-  void get_servo_jp_command(float*, int);
-  void get_servo_jv_command(float*, int);
-  float get_servo_jr_grasp_command();
-  float get_servo_jp_grasp_command();
-  float get_servo_jv_grasp_command();
+  void get_servo_jr_command(Scalar*, int);
+  void get_servo_jp_command(Scalar*, int);
+  void get_servo_jv_command(Scalar*, int);
+  Scalar get_servo_jr_grasp_command();
+  Scalar get_servo_jp_grasp_command();
+  Scalar get_servo_jv_grasp_command();
 
   time_t get_start_time();
+  ros::Time get_start_stamp();
   tf::Transform get_start_tf();
+  void get_start_jpos(Scalar* out, int length = capacity);
 
-  char start_motion( time_t curr_time);
+  char start_motion(const ros::Time& curr_time);
+  char start_motion(time_t curr_time);
+  void cancel_motion();
+  bool get_motion_active();
+  const CRTK_trajectory& get_cp_trajectory();
+  const CRTK_trajectory& get_jp_trajectory();
+  const CRTK_trajectory& get_otg_trajectory();
 
   char set_home_pos(tf::Quaternion, tf::Vector3);
-  char set_home_jpos(float*, int);
+  char set_home_jpos(Scalar*, int);
   tf::Transform get_home_pos();
-  void get_home_jpos(float* out, int length = MAX_JOINTS);
+  void get_home_jpos(Scalar* out, int length = capacity);
 
+  char go_to_pos(tf::Transform, const ros::Time&);
+  char go_to_jpos(char,int, Scalar, const ros::Time&);
+  char go_to_jpos(char,Scalar*, const ros::Time&, int length = capacity);
   char go_to_pos(tf::Transform, time_t);
-  char go_to_jpos(char,int, float, time_t);
-  char go_to_jpos(char,float*, time_t, int length = MAX_JOINTS);
+  char go_to_jpos(char,int, Scalar, time_t);
+  char go_to_jpos(char,Scalar*, time_t, int length = capacity);
+  char go_to_jpos_otg(Scalar*, int length = capacity);
+
+  char move_jp(Scalar*, int length = capacity);
+  char move_cp(tf::Transform);
+  void move_cancel();
+  CRTK_move_status move_tick(const ros::Time&, bool enabled);
+  CRTK_move_status get_move_status();
+  float get_move_progress();
+  char set_joint_limits(Scalar*, Scalar*, Scalar*, int);
   char is_prismatic(int);
 
   bool check_home_pos_set();
   bool check_home_jpos_set();
 
 private:
-  tf::Transform measured_cp;
+  char send_jp_traj_tick(char);
+
+  CRTK_seqlock<snapshot> measured;
   tf::Transform measured_cv;
   tf::Transform measured_cf; // Not supported by Raven
   tf::Transform goal_cp;
   tf::Transform setpoint_cp;
-  float measured_js_pos[MAX_JOINTS];
-  float measured_js_vel[MAX_JOINTS];
-  float measured_js_eff[MAX_JOINTS];
 
   tf::Transform servo_cr_command;
   tf::Transform servo_cv_command;
   tf::Transform servo_cp_command;
-  float servo_jr_grasp_command;
-  float servo_jp_grasp_command;
-  float servo_jv_grasp_command;
-  float servo_jr_command[MAX_JOINTS];
-  float servo_jp_command[MAX_JOINTS];
-  float servo_jv_command[MAX_JOINTS];
+  Scalar servo_jr_grasp_command;
+  Scalar servo_jp_grasp_command;
+  Scalar servo_jv_grasp_command;
+  joint_array servo_jr_command;
+  joint_array servo_jp_command;
+  joint_array servo_jv_command;
 
   char servo_cr_updated;
   char servo_cv_updated;
@@ -156,17 +247,51 @@ private:
   char servo_jr_grasp_updated;
   char servo_jp_grasp_updated;
   char servo_jv_grasp_updated;
+  unsigned long servo_superseded[CRTK_SERVO_NUM];
 
-  time_t motion_start_time;
+  ros::Time motion_start_time;
   tf::Transform motion_start_tf;
-  float motion_start_js_pos[MAX_JOINTS];
+  joint_array motion_start_js_pos;
+
+  // go_to_pos, send_servo_cp_distance and send_servo_cp_rot_angle share the
+  // Cartesian one, both go_to_jpos the joint one
+  CRTK_trajectory cp_traj;
+  CRTK_joint_trajectory_t<capacity, Scalar> jp_traj;
+  CRTK_otg_t<capacity, Scalar> otg;   // go_to_jpos_otg
+
+  // move_* goals: handed over from any thread, executed by move_tick
+  enum {MOVE_NONE, MOVE_JP, MOVE_CP};
+  struct move_goal{
+    unsigned long id;
+    char mode;
+    joint_array jp;
+    int length;
+    tf::Transform cp;
+  };
+  CRTK_seqlock<move_goal> move_request;
+  move_goal move_active;
+  std::atomic<int> move_status;
+  std::atomic<float> move_progress;
+
+  // interp_* setpoints, resampled into servo_* by interp_tick
+  CRTK_interp_jp_t<capacity, Scalar> interp_jp;
+  CRTK_interp_cp interp_cp;
 
   tf::Transform home_pos;
   bool home_pos_set;
   bool home_jpos_set;
-  float home_jpos[MAX_JOINTS];
-  char prismatic_joints[MAX_JOINTS];
+  joint_array home_jpos;
+  std::array<char, capacity> prismatic_joints;
+  CRTK_joint_count<N> joints;
 
 };
 
+// The default arm: float joints, count set at run time from num_joints.
+// Instantiated once in crtk_motion.cpp; include crtk_motion_impl.h to use
+// another CRTK_motion_t, e.g. CRTK_motion_t<7,double>.
+typedef CRTK_motion_t<CRTK_DYNAMIC_JOINTS,float> CRTK_motion;
+typedef CRTK_measured_snapshot_t<CRTK_DYNAMIC_JOINTS,float> CRTK_measured_snapshot;
+
+extern template class CRTK_motion_t<CRTK_DYNAMIC_JOINTS,float>;
+
 #endif
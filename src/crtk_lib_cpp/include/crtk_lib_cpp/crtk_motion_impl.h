@@ -0,0 +1,2383 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_motion_impl.h
+ *
+ * \brief Member definitions for the CRTK_motion_t template. Only
+ *  crtk_motion.cpp (which instantiates the default CRTK_motion) and code
+ *  that uses another joint count or scalar type need to include this.
+ *
+ * \date Oct 29, 2018
+ * \author Andrew Lewis
+ * \author Melody Yun-Hsuan Su
+ *
+ */
+
+#ifndef CRTK_MOTION_IMPL_H_
+#define CRTK_MOTION_IMPL_H_
+
+#include "crtk_motion.h"
+
+
+
+/**
+ * @brief      Constructs the CRTK_motion object.
+ */
+template<int N, typename Scalar>
+CRTK_motion_t<N,Scalar>::CRTK_motion_t(){
+
+  servo_cr_updated = 0;
+  servo_cp_updated = 0;
+  servo_cv_updated = 0;
+  servo_jr_updated = 0;
+  servo_jp_updated = 0;
+  servo_jv_updated = 0;
+  servo_jr_grasp_updated = 0;
+  servo_jp_grasp_updated = 0;
+  servo_jv_grasp_updated = 0;
+
+  home_pos_set = 0;
+  home_jpos_set = 0;
+
+  for(int i=0;i<CRTK_SERVO_NUM;i++)
+    servo_superseded[i] = 0;
+
+  for(int i=0;i<capacity;i++)
+  {
+    prismatic_joints[i] = 0;
+  }
+
+#ifdef RAVEN 
+  if(capacity > 2) prismatic_joints[2] = 1;
+#endif
+
+  // go_to_jpos_otg defaults: the go_to_jpos speeds, full speed in 0.25 s
+  joint_array max_vel, max_acc, max_jerk;
+  for(int i=0;i<capacity;i++)
+  {
+    max_vel[i] = prismatic_joints[i] ? 0.03 : 20 DEG_TO_RAD;
+    max_acc[i] = 8 * max_vel[i];
+    max_jerk[i] = 64 * max_vel[i];
+  }
+  otg.set_limits(max_vel.data(), max_acc.data(), max_jerk.data(), capacity);
+
+  snapshot *init = measured.write_begin();
+  for(int i=0;i<capacity;i++)
+  {
+    init->js_pos[i] = 0;
+    init->js_vel[i] = 0;
+    init->js_eff[i] = 0;
+  }
+  init->cp.setIdentity();
+  measured.write_end();
+
+  move_goal *goal = move_request.write_begin();
+  goal->id = 0;
+  goal->mode = MOVE_NONE;
+  goal->length = 0;
+  move_request.write_end();
+  move_active.id = 0;
+  move_active.mode = MOVE_NONE;
+  move_status = CRTK_MOVE_IDLE;
+  move_progress = 0;
+  
+}
+
+
+/**
+ * @brief      Sets the number of joints the robot actually has. Commands,
+ *             checks and copies only touch this many joints.
+ *
+ * @param[in]  n     The number of joints
+ *
+ * @return     success 0, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::set_num_joints(int n){
+  if(joints.set(n) < 0){
+    ROS_ERROR("Number of joints %d does not fit this arm (capacity %d).", n, (int)capacity);
+    return -1;
+  }
+  return 0;
+}
+
+
+/**
+ * @brief      Gets the number of joints.
+ *
+ * @return     The number of joints.
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::get_num_joints(){
+  return joints.get();
+}
+
+
+/**
+ * @brief      Gets the measured cartesian pose.
+ *
+ * @return     The measured cp.
+ */
+template<int N, typename Scalar>
+tf::Transform CRTK_motion_t<N,Scalar>::get_measured_cp(){
+  return measured.load().cp;
+}
+
+
+/**
+ * @brief      Sets the measured cartesian pose.
+ *
+ * @param[in]  trans  The transformation matrix
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::set_measured_cp(const tf::Transform& trans){
+  measured.write_begin()->cp = trans;
+  measured.write_end();
+}
+
+
+/**
+ * @brief      Gets one coherent sample of the measured js and cp. Safe to call
+ *             while the measured callbacks run on another thread.
+ *
+ * @return     The measured snapshot.
+ */
+template<int N, typename Scalar>
+CRTK_measured_snapshot_t<N,Scalar> CRTK_motion_t<N,Scalar>::get_measured_snapshot(){
+  return measured.load();
+}
+
+
+/**
+ * @brief      Gets one coherent sample of the measured js and cp.
+ *
+ * @param      out   The output snapshot
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::get_measured_snapshot(snapshot *out){
+  measured.load(out);
+}
+
+
+/**
+ * @brief      Gets the number of measured updates received so far.
+ *
+ * @return     The measured version.
+ */
+template<int N, typename Scalar>
+unsigned long CRTK_motion_t<N,Scalar>::get_measured_version(){
+  return measured.version();
+}
+
+
+/**
+ * @brief      Sets the measured js position, velocity and effort as one update.
+ *
+ * @param      pos     The js position array
+ * @param      vel     The js velocity array
+ * @param      eff     The js effort array
+ * @param[in]  length  The length
+ *
+ * @return     success 1, fail -1
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::set_measured_js(Scalar* pos, Scalar* vel, Scalar* eff, int length){
+  if(length > capacity){
+    ROS_ERROR("Wrong number of joints.");
+    return -1;
+  }
+
+  snapshot *snap = measured.write_begin();
+  for(int i=0; i<length; i++){
+    snap->js_pos[i] = pos[i];
+    snap->js_vel[i] = vel[i];
+    snap->js_eff[i] = eff[i];
+  }
+  measured.write_end();
+
+  return 1;
+}
+
+
+/**
+ * @brief      Sets the measured js straight from message arrays as one update,
+ *             without intermediate copies. A NULL vel or eff leaves that
+ *             field unchanged.
+ *
+ * @param[in]  pos     The js position array
+ * @param[in]  vel     The js velocity array (or NULL)
+ * @param[in]  eff     The js effort array (or NULL)
+ * @param[in]  length  The length
+ *
+ * @return     success 1, fail -1
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::set_measured_js(const double* pos, const double* vel, const double* eff, int length){
+  if(length > capacity){
+    ROS_ERROR("Wrong number of joints.");
+    return -1;
+  }
+
+  snapshot *snap = measured.write_begin();
+  for(int i=0; i<length; i++)
+    snap->js_pos[i] = pos[i];
+  if(vel)
+    for(int i=0; i<length; i++)
+      snap->js_vel[i] = vel[i];
+  if(eff)
+    for(int i=0; i<length; i++)
+      snap->js_eff[i] = eff[i];
+  measured.write_end();
+
+  return 1;
+}
+
+
+/**
+ * @brief      Gets the measured js position for a specific joint.
+ *
+ * @param[in]  index  The joint index
+ *
+ * @return     The measured js position.
+ */
+template<int N, typename Scalar>
+Scalar CRTK_motion_t<N,Scalar>::get_measured_js_pos(int index){
+  if(index<0 || index>=capacity){
+    ROS_ERROR("Index out of range.");
+    return -1;
+  }
+  return measured.load().js_pos[index];
+}
+
+
+/**
+ * @brief      Gets the measured js position vector for all joints.
+ *
+ * @param      out     The out
+ * @param[in]  length  The length
+ *
+ * @return     The measured js position.
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::get_measured_js_pos(Scalar* out, int length){
+  if(length > capacity){
+    ROS_ERROR("Wrong number of joints.");
+    return -1;
+  }
+
+  snapshot snap = measured.load();
+  for(int i=0; i<length; i++)
+  {
+    out[i] = snap.js_pos[i];
+    ROS_INFO("start_jpos %d=%f",i,out[i]);
+  }
+
+  return 1;
+}
+
+
+/**
+ * @brief      Sets the measured js position at a specific joint.
+ *
+ * @param[in]  index  The joint index
+ * @param[in]  value  The value
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::set_measured_js_pos(int index, Scalar value){
+  if(index<0 || index>=capacity){
+    ROS_ERROR("Wrong index of joints.");
+    return -1;
+  }
+  measured.write_begin()->js_pos[index] = value;
+  measured.write_end();
+  return 1;
+}
+
+
+/**
+ * @brief      Sets the measured js position for all the joints.
+ *
+ * @param      js_value  The js value
+ * @param[in]  length    The length
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::set_measured_js_pos(Scalar* js_value, int length){
+  if(length > capacity){
+    ROS_ERROR("Wrong number of joints.");
+    return -1;
+  }
+  snapshot *snap = measured.write_begin();
+  for(int i=0; i<length; i++)
+    snap->js_pos[i] = js_value[i];
+  measured.write_end();
+
+  return 1;
+}
+
+
+/**
+ * @brief      Gets the measured js velocity.
+ *
+ * @param[in]  index  The joint index
+ *
+ * @return     The measured js velocity.
+ */
+template<int N, typename Scalar>
+Scalar CRTK_motion_t<N,Scalar>::get_measured_js_vel(int index){
+  if(index<0 || index>=capacity){
+    ROS_ERROR("Index out of range.");
+    return -1;
+  }
+  return measured.load().js_vel[index];
+}
+
+
+/**
+ * @brief      Gets the measured js velocity.
+ *
+ * @param      out     The output joint velocity array
+ * @param[in]  length  The length
+ *
+ * @return     The measured js velocity.
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::get_measured_js_vel(Scalar* out, int length){
+  if(length > capacity){
+    ROS_ERROR("Wrong number of joints.");
+    return -1;
+  }
+
+  snapshot snap = measured.load();
+  for(int i=0; i<length; i++)
+    out[i] = snap.js_vel[i];
+
+  return 1;
+}
+
+
+
+/**
+ * @brief      Sets the measured js velocity for a specific joint.
+ *
+ * @param[in]  index  The joint index
+ * @param[in]  value  The joint velocity value
+ *
+ * @return     success 1, fail -1
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::set_measured_js_vel(int index, Scalar value){
+  if(index<0 || index>=capacity){
+    ROS_ERROR("Wrong index of joints.");
+    return -1;
+  }
+  measured.write_begin()->js_vel[index] = value;
+  measured.write_end();
+  return 1;
+}
+
+
+
+/**
+ * @brief      Sets the measured js velocity.
+ *
+ * @param      js_value  The array of js values
+ * @param[in]  length    The length
+ *
+ * @return     success 1, fail -1
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::set_measured_js_vel(Scalar* js_value, int length){
+  if(length > capacity){
+    ROS_ERROR("Wrong number of joints.");
+    return -1;
+  }
+  snapshot *snap = measured.write_begin();
+  for(int i=0; i<length; i++)
+    snap->js_vel[i] = js_value[i];
+  measured.write_end();
+
+  return 1;
+}
+
+
+/**
+ * @brief      Gets the measured js effort for a specific joint.
+ *
+ * @param[in]  index  The joint index
+ *
+ * @return     The measured js effort.
+ */
+template<int N, typename Scalar>
+Scalar CRTK_motion_t<N,Scalar>::get_measured_js_eff(int index){
+  if(index<0 || index>=capacity){
+    ROS_ERROR("Index out of range.");
+    return -1;
+  }
+  return measured.load().js_eff[index];
+}
+
+
+
+/**
+ * @brief      Gets the measured js effort.
+ *
+ * @param      out     The output joint array
+ * @param[in]  length  The length
+ *
+ * @return     The measured js eff.
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::get_measured_js_eff(Scalar* out, int length){
+  if(length > capacity){
+    ROS_ERROR("Wrong number of joints.");
+    return -1;
+  }
+
+  snapshot snap = measured.load();
+  for(int i=0; i<length; i++)
+    out[i] = snap.js_eff[i];
+
+  return 1;
+}
+
+
+/**
+ * @brief      Sets the measured js effort for a specific joint.
+ *
+ * @param[in]  index  The joint index
+ * @param[in]  value  The value
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::set_measured_js_eff(int index, Scalar value){
+  if(index<0 || index>=capacity){
+    ROS_ERROR("Wrong index of joints.");
+    return -1;
+  }
+  measured.write_begin()->js_eff[index] = value;
+  measured.write_end();
+  return 1;
+}
+
+
+/**
+ * @brief      Sets the measured js effort array.
+ *
+ * @param      js_value  The js value array
+ * @param[in]  length    The length
+ *
+ * @return     success 1, fail -1
+ */
+template<int N, typename Scalar>
+int CRTK_motion_t<N,Scalar>::set_measured_js_eff(Scalar* js_value, int length){
+  if(length > capacity){
+    ROS_ERROR("Wrong number of joints.");
+    return -1;
+  }
+  snapshot *snap = measured.write_begin();
+  for(int i=0; i<length; i++)
+    snap->js_eff[i] = js_value[i];
+  measured.write_end();
+
+  return 1;
+}
+
+
+/**
+ * @brief      Starts a motion.
+ *
+ * @param[in]  curr_time  The curr time
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::start_motion(const ros::Time& curr_time){
+  snapshot snap = measured.load();
+
+  // a new motion never resumes one that was abandoned halfway
+  cancel_motion();
+
+  motion_start_time = curr_time;
+  motion_start_tf = snap.cp;
+  for(int i=0; i<joints.get(); i++)
+    motion_start_js_pos[i] = snap.js_pos[i];
+  return 0;
+}
+
+
+/**
+ * @brief      start_motion with the time in whole seconds, e.g. from time(NULL)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::start_motion(time_t curr_time){
+  return start_motion(ros::Time((uint32_t)curr_time,0));
+}
+
+
+/**
+ * @brief      Stops any go_to_pos, go_to_jpos, go_to_jpos_otg,
+ *             send_servo_cp_distance or
+ *             send_servo_cp_rot_angle in progress. The next call starts over
+ *             from the motion start captured by start_motion.
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::cancel_motion(){
+  cp_traj.cancel();
+  jp_traj.cancel();
+  otg.cancel();
+}
+
+
+/**
+ * @brief      Checks if a multi-tick motion is in progress.
+ *
+ * @return     true if a Cartesian or joint trajectory is active
+ */
+template<int N, typename Scalar>
+bool CRTK_motion_t<N,Scalar>::get_motion_active(){
+  return cp_traj.is_active() || jp_traj.is_active() || otg.is_active();
+}
+
+
+/**
+ * @brief      Gets the progress of go_to_pos, send_servo_cp_distance and
+ *             send_servo_cp_rot_angle.
+ *
+ * @return     The Cartesian trajectory.
+ */
+template<int N, typename Scalar>
+const CRTK_trajectory& CRTK_motion_t<N,Scalar>::get_cp_trajectory(){
+  return cp_traj;
+}
+
+
+/**
+ * @brief      Gets the progress of go_to_jpos.
+ *
+ * @return     The joint trajectory.
+ */
+template<int N, typename Scalar>
+const CRTK_trajectory& CRTK_motion_t<N,Scalar>::get_jp_trajectory(){
+  return jp_traj;
+}
+
+
+/**
+ * @brief      Gets the progress of go_to_jpos_otg. The duration is the
+ *             planned one, and is re-estimated whenever the target changes.
+ *
+ * @return     The online trajectory.
+ */
+template<int N, typename Scalar>
+const CRTK_trajectory& CRTK_motion_t<N,Scalar>::get_otg_trajectory(){
+  return otg;
+}
+
+
+/**
+ * @brief      Sends a servo_cr time. (Must call start_motion function first)
+ *
+ * @param[in]  vec         The vector
+ * @param[in]  total_dist  The total distance
+ * @param[in]  duration    The duration
+ * @param[in]  curr_time   The curr time
+ *
+ * @return     success 1, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cr_time(tf::Vector3 vec, float total_dist, float duration, const ros::Time& curr_time){
+  // static char start = 1;
+  char out=0;
+  float step = total_dist/(duration*LOOP_RATE);
+
+  if(duration <= 0 || total_dist <= 0){
+    ROS_ERROR("Duration and distance should be positive.");
+    return -1;    
+  }
+  if(step > 0.001){
+    ROS_ERROR("Step size is too big.");
+    return -1;
+  }
+
+  // send command
+  if(!vec.normalized()){
+    vec = vec.normalize();
+    ROS_INFO("Servo_cr direction not normalized. (set to normalized)");
+  }
+  tf::Transform tf_out = tf::Transform();
+  tf_out.setIdentity();
+  tf_out.setOrigin(vec*step);
+  out = send_servo_cr(tf_out);
+
+  // check time
+  if((curr_time - motion_start_time).toSec() > duration){
+    ROS_INFO("%f sec movement complete.",duration);
+    
+    //at end of time, send 0 command
+    tf::Transform ident = tf::Transform();
+    // ident.setIdentity();
+    // out = send_servo_cr(ident);
+    return 1;
+  }
+  return out;
+}  
+
+
+/**
+ * @brief      send_servo_cr_time with the time in whole seconds, e.g. from time(NULL)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cr_time(tf::Vector3 vec, float total_dist, float duration, time_t curr_time){
+  return send_servo_cr_time(vec, total_dist, duration, ros::Time((uint32_t)curr_time,0));
+}
+
+
+/**
+ * @brief      Sends a servo_cv time. (Must call start_motion function first)
+ *
+ * @param[in]  vec         The vector
+ * @param[in]  total_dist  The total distance
+ * @param[in]  duration    The duration
+ * @param[in]  curr_time   The curr time
+ *
+ * @return     success 1, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cv_time(tf::Vector3 vec, float total_dist, float duration, const ros::Time& curr_time){
+  // static char start = 1;
+  char out=0;
+  float step = total_dist/(duration*LOOP_RATE);
+
+  if(duration <= 0 || total_dist <= 0){
+    ROS_ERROR("Duration and distance should be positive.");
+    return -1;    
+  }
+  if(step > 0.001){
+    ROS_ERROR("Step size is too big.");
+    return -1;
+  }
+
+  // send command
+  if(!vec.normalized()){
+    vec = vec.normalize();
+    ROS_INFO("Servo_cv direction not normalized. (set to normalized)");
+  }
+  tf::Transform tf_out = tf::Transform();
+  tf_out.setIdentity();
+  tf_out.setOrigin(vec*step*LOOP_RATE);
+  out = send_servo_cv(tf_out);
+
+  // check time
+  if((curr_time - motion_start_time).toSec() > duration){
+    ROS_INFO("%f sec movement complete.",duration);
+    
+    //at end of time, send 0 command
+    tf::Transform ident = tf::Transform();
+    // ident.setIdentity();
+    // out = send_servo_cv(ident);
+    return 1;
+  }
+  return out;
+}  
+
+
+/**
+ * @brief      send_servo_cv_time with the time in whole seconds, e.g. from time(NULL)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cv_time(tf::Vector3 vec, float total_dist, float duration, time_t curr_time){
+  return send_servo_cv_time(vec, total_dist, duration, ros::Time((uint32_t)curr_time,0));
+}
+
+
+/**
+ * @brief      Sends a servo_cp distance. (Must call start_motion function first)
+ * 
+ * minimum of 1 sec movements
+ *
+ * @param[in]  vec         The vector
+ * @param[in]  total_dist  The total distance
+ * @param[in]  duration    The duration
+ * @param[in]  curr_time   The curr time
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cp_distance(tf::Vector3 vec, float total_dist, const ros::Time& curr_time){
+  // static char start = 1;
+  char out=0;
+  
+  float safe_speed = 0.025; // m/s
+  //figure out total duration with ramp up and ramp down as 1/4 of movement each
+  float duration_loops = total_dist/(.875 * safe_speed/LOOP_RATE);
+  float step = safe_speed/LOOP_RATE;
+  float scale;
+
+  int ramp_loops = duration_loops/4;
+
+  if(!cp_traj.is_active())
+    cp_traj.start(duration_loops);
+  
+  // check time
+  if(cp_traj.is_done()) {
+    ROS_INFO("%f sec movement complete.",duration_loops/LOOP_RATE);
+    cp_traj.cancel();
+    return 1;
+  }
+    
+  int loop_count = cp_traj.step();
+
+  //determine ramp-up scale for this loop
+  if(loop_count <= duration_loops/2){
+    scale = std::min((double)loop_count/(double)ramp_loops, (double)1);
+  } else{
+    scale = 1;
+    //scale = std::min((double)(-loop_count+duration_loops)/(double)ramp_loops, (double)1);
+  }
+
+  if(scale <= 0) ROS_ERROR("Negative scaling factor of %f OMGWTFBBQsemicolon", scale);
+
+  if(total_dist <= 0){
+    ROS_ERROR("Duration and distance should be positive.");
+    return -1;    
+  }
+
+  // check command
+  if(step > 0.001){
+    ROS_ERROR("Step size is too big.");
+    return -1;
+  }  
+  if(!vec.normalized()){
+    vec = vec.normalize();
+    ROS_INFO("Servo_cp direction not normalized. (set to normalized)");
+  }
+
+  // send command
+  tf::Transform tf_out = tf::Transform();
+  tf::Transform curr_pos = get_measured_cp();
+
+  tf_out = curr_pos;
+  tf_out.setRotation(motion_start_tf.getRotation());
+  tf_out.setOrigin(motion_start_tf.getOrigin()+vec*(step*loop_count*scale));
+  out = send_servo_cp(tf_out);
+
+  return out;
+}
+
+
+/**
+ * @brief      send_servo_cp_distance with the time in whole seconds, e.g. from time(NULL)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cp_distance(tf::Vector3 vec, float total_dist, time_t curr_time){
+  return send_servo_cp_distance(vec, total_dist, ros::Time((uint32_t)curr_time,0));
+}
+
+
+/**
+ * @brief      goes to desired position and orientation
+ *
+ * @param[in]  end        The desired endpoint
+ * @param[in]  curr_time  The curr time
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::go_to_pos(tf::Transform end, const ros::Time& curr_time){
+  int out = 0;
+
+  float safe_speed = 0.015; // m/s
+  float max_omega = 15 DEG_TO_RAD; //per second 
+  //figure out total duration with ramp up and ramp down as 1/4 of movement each
+  float cart_loops, rot_loops, duration_loops;
+  float cart_step, rot_step;
+  float scale;
+  float rot_diff, cart_diff;
+  int ramp_loops;
+  
+
+  //determine cartesian diff and rotation diff
+  cart_diff =  (end.getOrigin() - motion_start_tf.getOrigin()).length();
+  rot_diff = motion_start_tf.getRotation().angleShortestPath(end.getRotation());
+
+  //determine max steps needed and corresponding steps for sync'ed finish
+  cart_loops = cart_diff/(.875 * safe_speed/LOOP_RATE); //.875
+  rot_loops = rot_diff/(.875 * max_omega/LOOP_RATE); //.875
+
+  duration_loops = std::max((double)cart_loops, (double)rot_loops);
+  if(duration_loops <= 0){
+    ROS_INFO("Already at the desired pos.");
+    return 1;
+  }
+  cart_step = cart_diff/duration_loops;
+  rot_step = rot_diff / duration_loops;
+
+  if(!cp_traj.is_active())
+    cp_traj.start(duration_loops);
+  int loop_count = cp_traj.get_loop_count();
+
+  if(loop_count == 5){
+    ROS_INFO("cart diff: %f \tcart speed = %f ", cart_diff,  cart_step * 1000);
+    ROS_INFO("rot diff: %f \trot speed = %f ", rot_diff RAD_TO_DEG,  rot_step * 1000 RAD_TO_DEG);
+  }
+
+  ramp_loops = duration_loops /4;
+
+ 
+  
+  // check time
+  if(cp_traj.is_done()) {
+    ROS_INFO("%f sec movement complete.",duration_loops/LOOP_RATE);
+    cp_traj.cancel();
+    return 1;
+  }
+    
+  loop_count = cp_traj.step();
+
+
+  scale = std::min((double)loop_count/(double)ramp_loops, (double)1);
+
+
+  if(scale <= 0) ROS_ERROR("Negative scaling factor of %f OMGWTFBBQsemicolon", scale);
+
+  // check command
+  if(cart_step > safe_speed){
+    ROS_ERROR("Step size is too big.");
+    return -1;
+  } else if(rot_step > max_omega){
+    ROS_ERROR("Step size is too big.");
+  } 
+
+  //calculate new position and orientation
+  tf::Transform error = motion_start_tf.inverse() *  end;
+
+  tf::Vector3 error_vec = end.getOrigin() - motion_start_tf.getOrigin();
+  
+  tf::Vector3 vec_plus = error_vec.normalized() * scale * cart_step * loop_count;
+  tf::Vector3 vec_out = motion_start_tf.getOrigin() + vec_plus;
+
+  tf::Vector3 rot_vec = error.getRotation().getAxis();
+  tf::Quaternion quat_out = motion_start_tf.getRotation().slerp(end.getRotation(), loop_count/duration_loops);//motion_start_tf.getRotation() * tf::Quaternion(rot_vec, scale * rot_step * loop_count);
+  
+
+    tf::Transform tf_out;
+    tf_out.setRotation(quat_out);
+    tf_out.setOrigin(vec_out);
+
+
+
+  if(loop_count == 25){
+    ROS_INFO("Start pos: %f, %f, %f", motion_start_tf.getOrigin().x(), motion_start_tf.getOrigin().y()
+      , motion_start_tf.getOrigin().z() );
+    ROS_INFO("End pos: %f, %f, %f", end.getOrigin().x(), end.getOrigin().y()
+      , end.getOrigin().z() );
+    ROS_INFO("Difference pos: %f, %f, %f", error_vec.x(), error_vec.y()
+      , error_vec.z() );
+    error_vec = motion_start_tf.getOrigin() + error_vec;
+    ROS_INFO("Start + difference: %f, %f, %f", error_vec.x(), error_vec.y()
+      , error_vec.z() );
+  }
+
+  out = send_servo_cp(tf_out);
+
+  return out;
+
+}
+
+
+/**
+ * @brief      go_to_pos with the time in whole seconds, e.g. from time(NULL)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::go_to_pos(tf::Transform end, time_t curr_time){
+  return go_to_pos(end, ros::Time((uint32_t)curr_time,0));
+}
+
+
+/**
+ * @brief      go to a desired jpos (for all joints)
+ *
+ * @param[in]  mode_flag      1 for _jp; 0 for _jr; 2 for _jv
+ * @param      jpos_d         The jpos desired
+ * @param[in]  curr_time      The curr time
+ * @param[in]  length         The length
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::go_to_jpos(char mode_flag, Scalar* jpos_d, const ros::Time& curr_time, int length)
+{
+  if(length > capacity){
+    ROS_ERROR("Toooooo many joints in go_to_jpos");
+    return -1;
+  }
+  if(length > joints.get())
+    length = joints.get();
+
+  float max_omega = 20 DEG_TO_RAD; // per second 
+  float max_pris = 0.03;           // meters per second 
+
+  //determine max steps needed and corresponding steps for sync'ed finish
+  float rot_step = (max_omega/LOOP_RATE);
+  float pris_step = (max_pris/LOOP_RATE);
+
+  if(!jp_traj.is_active()) // first entry: plan the whole move
+  {
+    // joints past length keep a zero displacement and hold still
+    joint_array diff;
+    diff.fill(0);
+    int duration_loops = 0;
+
+    for(int i=0;i<length;i++)
+    {
+      ROS_INFO("i=%i: start jpos (%f), desired jpos (%f)",i,motion_start_js_pos[i],jpos_d[i]);
+      diff[i] = jpos_d[i] - motion_start_js_pos[i];
+      if(is_prismatic(i))
+        duration_loops = std::max((double)duration_loops, fabs(diff[i])/(pris_step * .75));
+      else
+        duration_loops = std::max((double)duration_loops, fabs(diff[i])/(rot_step * .75));
+    }
+    ROS_INFO("duration_loops = %d",duration_loops);
+
+    if(duration_loops <= 0){
+      ROS_INFO("Already at the desired jpos.");
+      return 1;
+    }
+
+    jp_traj.plan_move(duration_loops, motion_start_js_pos, diff, joints.get());
+    ROS_INFO("Planned %d ticks x %d joints in %.1f us", jp_traj.get_ticks(), joints.get(),
+      1e6*jp_traj.get_plan_time());
+  }
+
+  // check time
+  if(jp_traj.is_done()) {
+    ROS_INFO("%f sec movement complete.", (double)jp_traj.get_duration_loops()/(double)LOOP_RATE);
+    jp_traj.cancel();
+    return 1;
+  }
+
+  return send_jp_traj_tick(mode_flag);
+}
+
+
+/**
+ * @brief      go_to_jpos with the time in whole seconds, e.g. from time(NULL)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::go_to_jpos(char mode_flag, Scalar* jpos_d, time_t curr_time, int length){
+  return go_to_jpos(mode_flag, jpos_d, ros::Time((uint32_t)curr_time,0), length);
+}
+
+
+
+
+/**
+ * @brief      desired joint position (for a single joint)
+ *
+ * @param[in]  mode_flag      1 for _jp; 0 for _jr; 2 for _jv
+ * @param[in]  joint_index    The joint index
+ * @param[in]  angle          The angle in degrees or linear distance in meters
+ * @param[in]  curr_time      The curr time
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::go_to_jpos(char mode_flag, int joint_index, Scalar angle, const ros::Time& curr_time){
+
+  float max_omega = 20 DEG_TO_RAD; // per second 
+  float max_pris = 0.03;           // meters per second 
+
+  //determine max steps needed and corresponding steps for sync'ed finish
+  float rot_step = (max_omega/LOOP_RATE);
+  float pris_step = (max_pris/LOOP_RATE);
+
+  if(!jp_traj.is_active()) // first entry: plan the whole move
+  {
+    float duration_loops;
+    joint_array peak_step;
+    peak_step.fill(0);
+
+    if(is_prismatic(joint_index))
+      duration_loops = angle/(pris_step * .75);
+    else
+      duration_loops = angle/(rot_step * .75);
+
+    if(joint_index >= 0 && joint_index < joints.get())
+      peak_step[joint_index] = is_prismatic(joint_index) ? -pris_step : rot_step;
+
+    jp_traj.plan_steps(duration_loops, motion_start_js_pos, peak_step, joints.get());
+  }
+
+  // check time
+  if(jp_traj.is_done()) {
+    ROS_INFO("%f sec movement complete.", (double)jp_traj.get_duration_loops()/(double)LOOP_RATE);
+    jp_traj.cancel();
+    return 1;
+  }
+
+  return send_jp_traj_tick(mode_flag);
+}
+
+
+/**
+ * @brief      Sends the current tick of the planned joint trajectory and
+ *             advances it
+ *
+ * @param[in]  mode_flag  1 for _jp; 0 for _jr; 2 for _jv
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_jp_traj_tick(char mode_flag){
+  int out = 0;
+  int tick = jp_traj.get_loop_count();
+  joint_array cmd;
+
+  if(mode_flag == (char)1)
+  {
+    jp_traj.get_jp(tick, cmd.data());
+    out = send_servo_jp(cmd.data());
+  }
+  else if(mode_flag == (char)0)
+  {
+    jp_traj.get_jr(tick, cmd.data());
+    out = send_servo_jr(cmd.data());
+  }
+  else if(mode_flag == (char)2)
+  {
+    jp_traj.get_jr(tick, cmd.data());
+    for(int i=0;i<joints.get();i++)
+      cmd[i] *= (Scalar)LOOP_RATE;
+    out = send_servo_jv(cmd.data());
+  }
+  else
+  {
+    ROS_ERROR("go_to_jpos: unrecognized mode. Motion not sent!");
+  }
+
+  jp_traj.step();
+
+  return out;
+}
+
+
+/**
+ * @brief      go_to_jpos with the time in whole seconds, e.g. from time(NULL)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::go_to_jpos(char mode_flag, int joint_index, Scalar angle, time_t curr_time){
+  return go_to_jpos(mode_flag, joint_index, angle, ros::Time((uint32_t)curr_time,0));
+}
+
+
+/**
+ * @brief      Jerk-limited move to a desired jpos with servo_jp. Unlike
+ *             go_to_jpos nothing is planned ahead: every call computes the
+ *             next setpoint from the current one, so jpos_d may change from
+ *             one call to the next and the motion follows it smoothly.
+ *             (Must call start_motion function first)
+ *
+ * @param      jpos_d  The jpos desired
+ * @param[in]  length  The length, joints past it hold their position
+ *
+ * @return     1 when the target is reached, -1 on error, 0 otherwise
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::go_to_jpos_otg(Scalar* jpos_d, int length)
+{
+  if(length > capacity){
+    ROS_ERROR("Toooooo many joints in go_to_jpos_otg");
+    return -1;
+  }
+  if(length > joints.get())
+    length = joints.get();
+
+  joint_array target = motion_start_js_pos;
+  for(int i=0;i<length;i++)
+    target[i] = jpos_d[i];
+
+  if(!otg.is_active()){
+    otg.reset(motion_start_js_pos.data(), joints.get());
+    otg.set_target(target.data(), 1.0/LOOP_RATE);
+    ROS_INFO("go_to_jpos_otg: about %f sec to the desired jpos.",
+      (double)otg.get_duration_loops()/(double)LOOP_RATE);
+  }
+  else if(otg.target_changed(target.data())){
+    otg.set_target(target.data(), 1.0/LOOP_RATE);
+  }
+
+  char done = otg.update(1.0/LOOP_RATE);
+
+  joint_array cmd;
+  otg.get_jp(cmd.data());
+  char out = send_servo_jp(cmd.data());
+
+  if(done){
+    ROS_INFO("%f sec movement complete.", (double)otg.get_loop_count()/(double)LOOP_RATE);
+    otg.cancel();
+    return 1;
+  }
+  return out;
+}
+
+
+/**
+ * @brief      Starts a move_jp: the arm goes to jpos_d on its own, planned
+ *             and executed by move_tick. Replaces any move in progress. Safe
+ *             to call from any thread.
+ *
+ * @param      jpos_d  The jpos desired
+ * @param[in]  length  The length, joints past it stay where they are
+ *
+ * @return     success 0, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::move_jp(Scalar* jpos_d, int length){
+  if(length > capacity){
+    ROS_ERROR("Toooooo many joints in move_jp");
+    return -1;
+  }
+  if(length > joints.get())
+    length = joints.get();
+
+  move_goal *goal = move_request.write_begin();
+  goal->id++;
+  goal->mode = MOVE_JP;
+  goal->length = length;
+  for(int i=0;i<length;i++)
+    goal->jp[i] = jpos_d[i];
+  move_request.write_end();
+  return 0;
+}
+
+
+/**
+ * @brief      Starts a move_cp: the arm goes to pose end on its own, planned
+ *             and executed by move_tick. Replaces any move in progress. Safe
+ *             to call from any thread.
+ *
+ * @param[in]  end   The desired pose
+ *
+ * @return     0
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::move_cp(tf::Transform end){
+  move_goal *goal = move_request.write_begin();
+  goal->id++;
+  goal->mode = MOVE_CP;
+  goal->cp = end;
+  move_request.write_end();
+  return 0;
+}
+
+
+/**
+ * @brief      Stops the move in progress, if any. Safe to call from any
+ *             thread.
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::move_cancel(){
+  move_goal *goal = move_request.write_begin();
+  goal->id++;
+  goal->mode = MOVE_NONE;
+  move_request.write_end();
+}
+
+
+/**
+ * @brief      Picks up a new move goal and runs one tick of the current
+ *             one. Call once per loop.
+ *
+ * @param[in]  now      The current time
+ * @param[in]  enabled  Whether the robot is enabled; a move fails if not
+ *
+ * @return     The move status after this tick
+ */
+template<int N, typename Scalar>
+CRTK_move_status CRTK_motion_t<N,Scalar>::move_tick(const ros::Time& now, bool enabled){
+  unsigned long last_id = move_active.id;
+  move_request.load(&move_active);
+
+  if(move_active.id != last_id){
+    bool was_active = move_status == CRTK_MOVE_ACTIVE;
+    cancel_motion();
+    move_progress = 0;
+
+    if(move_active.mode == MOVE_NONE){
+      if(was_active){
+        ROS_INFO("Move canceled.");
+        move_status = CRTK_MOVE_CANCELED;
+      }
+    }
+    else if(!enabled){
+      ROS_WARN("Move rejected: robot not enabled.");
+      move_status = CRTK_MOVE_FAILED;
+    }
+    else{
+      start_motion(now);
+      move_status = CRTK_MOVE_ACTIVE;
+    }
+  }
+
+  if(move_status != CRTK_MOVE_ACTIVE)
+    return (CRTK_move_status)move_status.load();
+
+  if(!enabled){
+    ROS_WARN("Move stopped: robot no longer enabled.");
+    cancel_motion();
+    move_status = CRTK_MOVE_FAILED;
+    return CRTK_MOVE_FAILED;
+  }
+
+  char out;
+  if(move_active.mode == MOVE_JP){
+    out = go_to_jpos_otg(move_active.jp.data(), move_active.length);
+    move_progress = otg.get_progress();
+  }
+  else{
+    out = go_to_pos(move_active.cp, now);
+    move_progress = cp_traj.get_progress();
+  }
+
+  if(out == 1){
+    move_progress = 1;
+    move_status = CRTK_MOVE_DONE;
+  }
+  else if(out < 0){
+    cancel_motion();
+    move_status = CRTK_MOVE_FAILED;
+  }
+  return (CRTK_move_status)move_status.load();
+}
+
+
+/**
+ * @brief      Gets the status of the last move goal
+ *
+ * @return     The move status.
+ */
+template<int N, typename Scalar>
+CRTK_move_status CRTK_motion_t<N,Scalar>::get_move_status(){
+  return (CRTK_move_status)move_status.load();
+}
+
+
+/**
+ * @brief      Gets how far along the current move is
+ *
+ * @return     progress in [0,1], by time
+ */
+template<int N, typename Scalar>
+float CRTK_motion_t<N,Scalar>::get_move_progress(){
+  return move_progress.load();
+}
+
+
+/**
+ * @brief      Sets the per joint limits of go_to_jpos_otg
+ *
+ * @param      vel     The velocity limits (rad/s, or m/s for prismatic joints)
+ * @param      acc     The acceleration limits
+ * @param      jerk    The jerk limits
+ * @param[in]  length  The number of joints
+ *
+ * @return     success 0, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::set_joint_limits(Scalar* vel, Scalar* acc, Scalar* jerk, int length){
+  if(length > joints.get()){
+    ROS_ERROR("Joint limits for %d joints, the arm has %d.", length, joints.get());
+    return -1;
+  }
+  if(otg.set_limits(vel, acc, jerk, length) < 0){
+    ROS_ERROR("Joint velocity, acceleration and jerk limits must be positive.");
+    return -1;
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief      check if a joint is prismatic
+ *
+ * @param[in]  joint_index  The joint index
+ *
+ * @return     1 if prismatic, 0 otherwise
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::is_prismatic(int joint_index)
+{
+    if(joint_index >= 0 && joint_index < capacity)
+    {
+      return prismatic_joints[joint_index];
+    }
+    else
+    { 
+      ROS_ERROR("Joint out of bounds - is_prismatic!!!!!!!");
+      return 0;
+    }
+}
+
+
+/**
+ * @brief      Sends a servo_cr increment for a given time. (Must call start_motion
+ *             function first)
+ *
+ * @param[in]  vec          The rotation vector
+ * @param[in]  total_angle  The total angle (radian)
+ * @param[in]  duration     The duration
+ * @param[in]  curr_time    The curr time
+ *
+ * @return     success 1, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cr_rot_time(tf::Vector3 vec, float total_angle, float duration, const ros::Time& curr_time){
+  // static char start = 1;
+  char out=0;
+  float step = total_angle/(duration*LOOP_RATE);
+
+  if(duration <= 0){
+    ROS_ERROR("Duration should be positive.");
+    return -1;    
+  }
+  if(step > 0.001){
+    ROS_ERROR("Step size is too big.");
+    return -1;
+  }
+
+  // send command
+  if(!vec.normalized()){
+    vec = vec.normalize();
+    ROS_INFO("Servo_cr rot direction not normalized. (set to normalized)");
+  }
+
+  tf::Quaternion out_qua = tf::Quaternion(vec,step);
+  out = send_servo_cr(tf::Transform(out_qua));
+
+
+  // check time
+  if((curr_time - motion_start_time).toSec() > duration){
+    ROS_INFO("%f sec movement complete.",duration);
+
+    return 1;
+  }
+  return out;
+}  
+
+
+/**
+ * @brief      send_servo_cr_rot_time with the time in whole seconds, e.g. from time(NULL)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cr_rot_time(tf::Vector3 vec, float total_angle, float duration, time_t curr_time){
+  return send_servo_cr_rot_time(vec, total_angle, duration, ros::Time((uint32_t)curr_time,0));
+}
+
+
+/**
+ * @brief      Sends a servo_cv increment for a given time. (Must call start_motion
+ *             function first)
+ *
+ * @param[in]  vec          The rotation vector
+ * @param[in]  total_angle  The total angle (radian)
+ * @param[in]  duration     The duration
+ * @param[in]  curr_time    The curr time
+ *
+ * @return     success 1, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cv_rot_time(tf::Vector3 vec, float total_angle, float duration, const ros::Time& curr_time){
+  // static char start = 1;
+  char out=0;
+  float step = total_angle/(duration*LOOP_RATE);
+
+  if(duration <= 0){
+    ROS_ERROR("Duration should be positive.");
+    return -1;    
+  }
+  if(step > 0.001){
+    ROS_ERROR("Step size is too big.");
+    return -1;
+  }
+
+  // send command
+  if(!vec.normalized()){
+    vec = vec.normalize();
+    ROS_INFO("Servo_cv rot direction not normalized. (set to normalized)");
+  }
+
+  tf::Quaternion out_qua = tf::Quaternion(vec,step*LOOP_RATE);
+  out = send_servo_cv(tf::Transform(out_qua));
+
+
+  // check time
+  if((curr_time - motion_start_time).toSec() > duration){
+    ROS_INFO("%f sec movement complete.",duration);
+
+    return 1;
+  }
+  return out;
+}  
+
+
+/**
+ * @brief      send_servo_cv_rot_time with the time in whole seconds, e.g. from time(NULL)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cv_rot_time(tf::Vector3 vec, float total_angle, float duration, time_t curr_time){
+  return send_servo_cv_rot_time(vec, total_angle, duration, ros::Time((uint32_t)curr_time,0));
+}
+
+
+/**
+ * @brief      Sends a servo_cp rotation over a given distance. (Must call start_motion
+ *             function first)
+ *
+ * @param[in]  vec          The rotation vector
+ * @param[in]  total_angle  The total angle (radian)
+ * @param[in]  duration     The duration
+ * @param[in]  curr_time    The curr time
+ *
+ * @return     success 1, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cp_rot_angle(tf::Vector3 vec, float total_angle, const ros::Time& curr_time){
+  // static char start = 1;
+  char out=0;
+  float max_omega = 15 DEG_TO_RAD; //per second 
+  float step = max_omega/LOOP_RATE;
+  int loop_duration = total_angle / step;
+
+  if(!cp_traj.is_active())
+    cp_traj.start(loop_duration);
+  
+  // check time 
+  if(cp_traj.get_loop_count() >= loop_duration){
+    ROS_INFO("%f sec rotation movement complete", (float)loop_duration/LOOP_RATE);
+    cp_traj.cancel();
+    return 1;
+  }
+  int loop_count = cp_traj.step();
+
+  if(step > max_omega/LOOP_RATE){
+    ROS_ERROR("Step size is too big.");
+    return -1;
+  }
+
+  // send command
+  if(!vec.normalized()){
+    vec = vec.normalize();
+    ROS_INFO("Servo_cp rot direction not normalized. (set to normalized)");
+  }
+
+  //get current pose
+  tf::Quaternion start_rot = motion_start_tf.getRotation();
+  tf::Vector3 curr_pos = motion_start_tf.getOrigin();
+
+  // add (by multiplication) current pose and increment quaternion
+  float out_angle = step * loop_count;
+  tf::Quaternion out_qua = start_rot * tf::Quaternion(vec, out_angle);
+  
+  out = send_servo_cp(tf::Transform(out_qua, curr_pos));
+
+  return out;
+}  
+
+
+/**
+ * @brief      send_servo_cp_rot_angle with the time in whole seconds, e.g. from time(NULL)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cp_rot_angle(tf::Vector3 vec, float total_angle, time_t curr_time){
+  return send_servo_cp_rot_angle(vec, total_angle, ros::Time((uint32_t)curr_time,0));
+}
+
+
+
+/**
+ * @brief      Sends a servo carriage return.
+ *
+ * @param[in]  trans  The transaction
+ *
+ * @return     success 0, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cr(tf::Transform trans){
+  // check command
+  tf::Vector3 vec = trans.getOrigin();
+  float ang = trans.getRotation().getAngle();
+  if(vec.length() > STEP_TRANS_LIMIT || ang > STEP_ROT_LIMIT){
+    ROS_ERROR("Servo_cr step limit exceeded. Motion not sent.");
+    reset_servo_cr_updated();
+    return -1;
+  }
+  double det = trans.getBasis().determinant();
+  if(det <1){
+    ROS_ERROR("Determinenant of servo_cr is %f instead of 1", det);
+    return -1;
+  }
+
+  // send command
+  if(servo_cr_updated) servo_superseded[CRTK_SERVO_CR]++;
+  servo_cr_updated = 1;
+  servo_cr_command = trans;
+
+  return 0;
+}
+
+
+
+/**
+ * @brief      Sends a servo carriage return.
+ *
+ * @param[in]  trans  The transaction
+ *
+ * @return     success 0, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cv(tf::Transform trans){
+  // check command
+  tf::Vector3 vec = trans.getOrigin();
+  float ang = trans.getRotation().getAngle();
+  if(vec.length() > STEP_TRANS_LIMIT*LOOP_RATE || ang > STEP_ROT_LIMIT*LOOP_RATE){
+    ROS_ERROR("Servo_cv step limit exceeded. Motion not sent.");
+    reset_servo_cv_updated();
+    return -1;
+  }
+  double det = trans.getBasis().determinant();
+  if(det <1){
+    ROS_ERROR("Determinenant of servo_cv is %f instead of 1", det);
+    return -1;
+  }
+
+  // send command
+  if(servo_cv_updated) servo_superseded[CRTK_SERVO_CV]++;
+  servo_cv_updated = 1;
+  servo_cv_command = trans;
+
+  return 0;
+}
+
+
+
+/**
+ * @brief      reset servo_cr updated flag
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::reset_servo_cr_updated(){
+  servo_cr_command = tf::Transform();
+  servo_cr_updated = 0;
+}
+
+
+/**
+ * @brief      reset servo_cv updated flag
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::reset_servo_cv_updated(){
+  servo_cv_command = tf::Transform();
+  servo_cv_updated = 0;
+}
+
+
+
+/**
+ * @brief      Checks the servo_cr updated flag.
+ *
+ * @return     The servo_cr updated flag value.
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::get_servo_cr_updated(){
+  return servo_cr_updated;
+}
+
+
+
+/**
+ * @brief      Checks the servo_cv updated flag.
+ *
+ * @return     The servo_cv updated flag value.
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::get_servo_cv_updated(){
+  return servo_cv_updated;
+}
+
+
+/**
+ * @brief      Gets the servo_cr motion command.
+ *
+ * @return     The servo_cr command
+ */
+template<int N, typename Scalar>
+tf::Transform CRTK_motion_t<N,Scalar>::get_servo_cr_command(){
+  return tf::Transform(servo_cr_command);
+}
+
+
+
+/**
+ * @brief      Gets the servo_cv motion command.
+ *
+ * @return     The servo_cv command
+ */
+template<int N, typename Scalar>
+tf::Transform CRTK_motion_t<N,Scalar>::get_servo_cv_command(){
+  return tf::Transform(servo_cv_command);
+}
+
+
+
+/**
+ * @brief      Sends a servo cp motion command.
+ *
+ * @param[in]  trans  The transformation
+ *
+ * @return     0
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_cp(tf::Transform trans){
+
+  // send command
+  if(servo_cp_updated) servo_superseded[CRTK_SERVO_CP]++;
+  servo_cp_updated = 1;
+  servo_cp_command = trans;
+
+  return 0;
+}
+
+
+
+/**
+ * @brief      Resets the servo_cp updated flag
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::reset_servo_cp_updated(){
+  servo_cp_command = tf::Transform();
+  servo_cp_updated = 0;
+}
+
+
+
+/**
+ * @brief      Checks the servo cp updated flag.
+ *
+ * @return     The servo cp updated flag.
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::get_servo_cp_updated(){
+  // servo_cp_updated = 1;
+  // ROS_INFO("get says: %i", servo_cp_updated);
+  return servo_cp_updated;
+}
+
+
+
+/**
+ * @brief      Gets the servo cp command.
+ *
+ * @return     The servo cp command.
+ */
+template<int N, typename Scalar>
+tf::Transform CRTK_motion_t<N,Scalar>::get_servo_cp_command(){
+  return tf::Transform(servo_cp_command);
+}
+
+
+
+/**
+ * @brief      Gets the motion start time.
+ *
+ * @return     The start time.
+ */
+template<int N, typename Scalar>
+time_t CRTK_motion_t<N,Scalar>::get_start_time(){
+  return motion_start_time.sec;
+}
+
+
+
+/**
+ * @brief      Gets the motion start time on the motion clock.
+ *
+ * @return     The start time.
+ */
+template<int N, typename Scalar>
+ros::Time CRTK_motion_t<N,Scalar>::get_start_stamp(){
+  return motion_start_time;
+}
+
+
+
+/**
+ * @brief      Gets the start transformation.
+ *
+ * @return     The start tf.
+ */
+template<int N, typename Scalar>
+tf::Transform CRTK_motion_t<N,Scalar>::get_start_tf(){
+  return motion_start_tf;
+}
+
+
+
+/**
+ * @brief      Gets the joint positions captured by start_motion.
+ *
+ * @param      out     The output start jpos
+ * @param[in]  length  The length
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::get_start_jpos(Scalar* out, int length){
+  for(int i=0;i<length && i<joints.get();i++)
+    out[i] = motion_start_js_pos[i];
+}
+
+
+
+/**
+ * @brief      Sends a servo jr motion command.
+ *
+ * @param      jpos_d  The desired jpos
+ *
+ * @return     success 0, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_jr(Scalar* jpos_d){
+
+  Scalar step_angle;
+  for(int i=0;i<joints.get();i++){
+    step_angle = jpos_d[i];
+    if(fabs(step_angle) > STEP_ROT_LIMIT){ 
+      ROS_ERROR("Servo_jr step limit exceeded. Motion not sent.");
+      reset_servo_jr_updated();
+      return -1;
+    }
+  }
+  
+  // send command
+  if(servo_jr_updated) servo_superseded[CRTK_SERVO_JR]++;
+  servo_jr_updated = 1;
+  for(int i=0;i<joints.get();i++)
+    servo_jr_command[i] = jpos_d[i];
+  return 0;
+}
+
+
+
+/**
+ * @brief      Sends a servo jp motion command.
+ *
+ * @param      jpos_d  The desired jpos
+ *
+ * @return     0
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_jp(Scalar* jpos_d){
+
+  // send command
+  if(servo_jp_updated) servo_superseded[CRTK_SERVO_JP]++;
+  servo_jp_updated = 1;
+  for(int i=0;i<joints.get();i++)
+    servo_jp_command[i] = jpos_d[i];
+  return 0;
+}
+
+
+
+/**
+ * @brief      Queues a timestamped joint setpoint for interp_tick. Safe to
+ *             call from a subscriber callback.
+ *
+ * @param      jpos_d  The desired jpos
+ * @param[in]  stamp   The time the arm should be there (plus the interp delay)
+ * @param[in]  length  The length, joints past it hold their measured position
+ *
+ * @return     success 0, fail -1 (stamp not newer than the last setpoint)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_interp_jp(Scalar* jpos_d, const ros::Time& stamp, int length){
+  if(length > joints.get())
+    length = joints.get();
+  if(interp_jp.push(stamp.toSec(), jpos_d, length) < 0){
+    ROS_WARN_THROTTLE(1, "interp_jp setpoint out of order. Setpoint dropped.");
+    return -1;
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief      Queues a timestamped Cartesian setpoint for interp_tick. Safe
+ *             to call from a subscriber callback.
+ *
+ * @param[in]  trans  The desired pose
+ * @param[in]  stamp  The time the arm should be there (plus the interp delay)
+ *
+ * @return     success 0, fail -1 (stamp not newer than the last setpoint)
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_interp_cp(tf::Transform trans, const ros::Time& stamp){
+  if(interp_cp.push(stamp.toSec(), trans) < 0){
+    ROS_WARN_THROTTLE(1, "interp_cp setpoint out of order. Setpoint dropped.");
+    return -1;
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief      Sends this tick's servo_jp and servo_cp from the interp_jp and
+ *             interp_cp streams, if any is active. Call once per loop.
+ *
+ * @param[in]  now   The current time
+ *
+ * @return     1 if a servo command was sent, 0 otherwise
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::interp_tick(const ros::Time& now){
+  char out = 0;
+
+  joint_array jp;
+  int length = 0;
+  if(interp_jp.get_jp(now.toSec(), jp.data(), &length) >= 0){
+    if(length < joints.get()){
+      snapshot snap = measured.load();
+      for(int i=length;i<joints.get();i++)
+        jp[i] = snap.js_pos[i];
+    }
+    send_servo_jp(jp.data());
+    out = 1;
+  }
+
+  tf::Transform cp;
+  if(interp_cp.get_cp(now.toSec(), &cp) >= 0){
+    send_servo_cp(cp);
+    out = 1;
+  }
+  return out;
+}
+
+
+
+/**
+ * @brief      Sets how far behind the current time interp_* setpoints are
+ *             rendered. About two setpoint periods keeps the next setpoint
+ *             in hand; this is the latency interp mode adds.
+ *
+ * @param[in]  delay  The delay (s), 0 to follow twice the measured
+ *                    setpoint interval
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::set_interp_delay(double delay){
+  interp_jp.set_delay(delay);
+  interp_cp.set_delay(delay);
+}
+
+
+
+/**
+ * @brief      Sets how long interp_tick holds the last setpoint when the
+ *             stream stops before it stops sending servo commands.
+ *
+ * @param[in]  timeout  The timeout (s)
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::set_interp_timeout(double timeout){
+  interp_jp.set_timeout(timeout);
+  interp_cp.set_timeout(timeout);
+}
+
+
+
+/**
+ * @brief      Sends a servo jv motion command.
+ *
+ * @param      jpos_d  The desired jpos
+ *
+ * @return     success 0, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_jv(Scalar* jpos_d){
+
+  Scalar step_angle;
+  for(int i=0;i<joints.get();i++){
+    step_angle = jpos_d[i];
+    if(fabs(step_angle) > STEP_ROT_LIMIT * LOOP_RATE){ 
+      ROS_ERROR("Servo_jv velocity limit exceeded. Motion not sent. i=%d,(command:%f, threshold:%f)",i,step_angle,STEP_ROT_LIMIT * LOOP_RATE);
+      reset_servo_jv_updated();
+      return -1;
+    }
+  }
+  
+  // send command
+  if(servo_jv_updated) servo_superseded[CRTK_SERVO_JV]++;
+  servo_jv_updated = 1;
+  for(int i=0;i<joints.get();i++)
+    servo_jv_command[i] = jpos_d[i];
+  return 0;
+}
+
+
+
+
+/**
+ * @brief      Sends a servo jr grasp.
+ *
+ * @param[in]  step_angle  The step angle
+ *
+ * @return     success 0, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_jr_grasp(Scalar step_angle){
+
+  
+  if(fabs(step_angle) > STEP_ROT_LIMIT){ 
+    ROS_ERROR("Servo_jr_grasp step limit exceeded. Motion not sent.");
+    reset_servo_jr_grasp_updated();
+    return -1;
+  }
+  // send command
+  if(servo_jr_grasp_updated) servo_superseded[CRTK_SERVO_JR_GRASP]++;
+  servo_jr_grasp_updated = 1;
+  servo_jr_grasp_command = step_angle;
+  return 0;
+}
+
+
+
+/**
+ * @brief      Sends a servo jp grasp.
+ *
+ * @param[in]  angle  The grasp angle
+ *
+ * @return     0
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_jp_grasp(Scalar angle){
+
+  // send command
+  if(servo_jp_grasp_updated) servo_superseded[CRTK_SERVO_JP_GRASP]++;
+  servo_jp_grasp_updated = 1;
+  servo_jp_grasp_command = angle;
+  return 0;
+}
+
+
+
+/**
+ * @brief      Sends a servo jv grasp.
+ *
+ * @param[in]  step_angle  The step angle
+ *
+ * @return     success 0, fail -1
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::send_servo_jv_grasp(Scalar step_angle){
+
+  
+  if(fabs(step_angle) > STEP_ROT_LIMIT * LOOP_RATE){ 
+    ROS_ERROR("Servo_jv_grasp velocity limit exceeded. Motion not sent.");
+    reset_servo_jv_grasp_updated();
+    return -1;
+  }
+  // send command
+  if(servo_jv_grasp_updated) servo_superseded[CRTK_SERVO_JV_GRASP]++;
+  servo_jv_grasp_updated = 1;
+  servo_jv_grasp_command = step_angle;
+  return 0;
+}
+
+
+
+/**
+ * @brief      resets the servo_jr updated flag
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::reset_servo_jr_updated(){
+  servo_jr_updated = 0;
+}
+
+
+
+/**
+ * @brief      Resets the servo_jp updated flag
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::reset_servo_jp_updated(){
+  servo_jp_updated = 0;
+}
+
+
+/**
+ * @brief      Resets the servo_jv updated flag
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::reset_servo_jv_updated(){
+  servo_jv_updated = 0;
+}
+
+
+/**
+ * @brief      Resets the servo_jr grasper updated flag
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::reset_servo_jr_grasp_updated(){
+  servo_jr_grasp_updated = 0;
+}
+
+
+
+/**
+ * @brief      Resets servo jp grasper updated flag
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::reset_servo_jp_grasp_updated(){
+  servo_jp_grasp_updated = 0;
+}
+
+
+/**
+ * @brief      Resets servo jv grasper updated flag
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::reset_servo_jv_grasp_updated(){
+  servo_jv_grasp_updated = 0;
+}
+
+
+
+/**
+ * @brief      Gets the servo jr updated flag.
+ *
+ * @return     The servo jr updated.
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::get_servo_jr_updated(){
+  return servo_jr_updated;
+}
+
+
+/**
+ * @brief      Gets the servo jp updated flag.
+ *
+ * @return     The servo jp updated.
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::get_servo_jp_updated(){
+  return servo_jp_updated;
+}
+
+
+/**
+ * @brief      Gets the servo jv updated flag.
+ *
+ * @return     The servo jv updated.
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::get_servo_jv_updated(){
+  return servo_jv_updated;
+}
+
+
+
+/**
+ * @brief      Gets the servo jr grasper updated flag.
+ *
+ * @return     The servo jr grasp updated.
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::get_servo_jr_grasp_updated(){
+  return servo_jr_grasp_updated;
+}
+
+
+
+/**
+ * @brief      Gets the servo jv grasper updated.
+ *
+ * @return     The servo jv grasp updated.
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::get_servo_jv_grasp_updated(){
+  return servo_jv_grasp_updated;
+}
+
+
+
+/**
+ * @brief      Gets the servo jp grasper updated.
+ *
+ * @return     The servo jp grasp updated.
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::get_servo_jp_grasp_updated(){
+  return servo_jp_grasp_updated;
+}
+
+
+
+/**
+ * @brief      Gets the updated flag of any servo channel.
+ *
+ * @param[in]  channel  The servo channel
+ *
+ * @return     The updated flag.
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::get_servo_updated(CRTK_servo_channel channel){
+  switch(channel){
+    case CRTK_SERVO_CR:       return servo_cr_updated;
+    case CRTK_SERVO_CP:       return servo_cp_updated;
+    case CRTK_SERVO_CV:       return servo_cv_updated;
+    case CRTK_SERVO_JR:       return servo_jr_updated;
+    case CRTK_SERVO_JP:       return servo_jp_updated;
+    case CRTK_SERVO_JV:       return servo_jv_updated;
+    case CRTK_SERVO_JR_GRASP: return servo_jr_grasp_updated;
+    case CRTK_SERVO_JP_GRASP: return servo_jp_grasp_updated;
+    case CRTK_SERVO_JV_GRASP: return servo_jv_grasp_updated;
+    default:                  return 0;
+  }
+}
+
+
+
+/**
+ * @brief      Resets the updated flag of any servo channel.
+ *
+ * @param[in]  channel  The servo channel
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::reset_servo_updated(CRTK_servo_channel channel){
+  switch(channel){
+    case CRTK_SERVO_CR:       reset_servo_cr_updated();       break;
+    case CRTK_SERVO_CP:       reset_servo_cp_updated();       break;
+    case CRTK_SERVO_CV:       reset_servo_cv_updated();       break;
+    case CRTK_SERVO_JR:       reset_servo_jr_updated();       break;
+    case CRTK_SERVO_JP:       reset_servo_jp_updated();       break;
+    case CRTK_SERVO_JV:       reset_servo_jv_updated();       break;
+    case CRTK_SERVO_JR_GRASP: reset_servo_jr_grasp_updated(); break;
+    case CRTK_SERVO_JP_GRASP: reset_servo_jp_grasp_updated(); break;
+    case CRTK_SERVO_JV_GRASP: reset_servo_jv_grasp_updated(); break;
+    default: break;
+  }
+}
+
+
+
+/**
+ * @brief      Gets how many commands of a channel were overwritten by a newer
+ *             command of the same channel before they were published.
+ *
+ * @param[in]  channel  The servo channel
+ *
+ * @return     The superseded count.
+ */
+template<int N, typename Scalar>
+unsigned long CRTK_motion_t<N,Scalar>::get_servo_superseded(CRTK_servo_channel channel){
+  if(channel < 0 || channel >= CRTK_SERVO_NUM)
+    return 0;
+  return servo_superseded[channel];
+}
+
+
+
+/**
+ * @brief      Gets the servo jr grasper command.
+ *
+ * @return     The servo jr grasper command.
+ */
+template<int N, typename Scalar>
+Scalar CRTK_motion_t<N,Scalar>::get_servo_jr_grasp_command(){
+  return servo_jr_grasp_command;
+}
+
+
+
+/**
+ * @brief      Gets the servo jp grasper command.
+ *
+ * @return     The servo jp grasper command.
+ */
+template<int N, typename Scalar>
+Scalar CRTK_motion_t<N,Scalar>::get_servo_jp_grasp_command(){
+  return servo_jp_grasp_command;
+}
+
+
+
+/**
+ * @brief      Gets the servo jv grasper command.
+ *
+ * @return     The servo jv grasper command.
+ */
+template<int N, typename Scalar>
+Scalar CRTK_motion_t<N,Scalar>::get_servo_jv_grasp_command(){
+  return servo_jv_grasp_command;
+}
+
+
+
+/**
+ * @brief      Gets the servo jr command.
+ *
+ * @param      out     The output jr command array
+ * @param[in]  length  The length
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::get_servo_jr_command(Scalar* out, int length){
+  for(int i=0;i<length;i++)
+   out[i] = servo_jr_command[i];
+}
+
+
+
+/**
+ * @brief      Gets the servo jp command.
+ *
+ * @param      out     The out jp command array
+ * @param[in]  length  The length
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::get_servo_jp_command(Scalar* out, int length){
+  for(int i=0;i<length;i++)
+   out[i] = servo_jp_command[i];
+}
+
+
+/**
+ * @brief      Gets the servo jv command.
+ *
+ * @param      out     The out jv command array
+ * @param[in]  length  The length
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::get_servo_jv_command(Scalar* out, int length){
+  for(int i=0;i<length;i++)
+   out[i] = servo_jv_command[i];
+}
+
+
+
+/**
+ * @brief      Sets the home position.
+ *
+ * @param[in]  q_in  The quarter in
+ * @param[in]  v_in  The v in
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::set_home_pos(tf::Quaternion q_in, tf::Vector3 v_in){
+  home_pos.setRotation(q_in);
+  home_pos.setOrigin(v_in);
+  home_pos_set = 1;
+  return 1;
+}
+
+
+
+/**
+ * @brief      Sets the home jpos.
+ *
+ * @param      in      input home jpos array
+ * @param[in]  length  The length
+ *
+ * @return     success
+ */
+template<int N, typename Scalar>
+char CRTK_motion_t<N,Scalar>::set_home_jpos(Scalar* in, int length)
+{
+  for(int i=0;i<length;i++)
+  {
+    home_jpos[i] = in[i];
+  }
+
+  home_jpos_set = 1;
+  return 1;
+}
+
+
+
+/**
+ * @brief      Gets the home position.
+ *
+ * @return     The home position.
+ */
+template<int N, typename Scalar>
+tf::Transform  CRTK_motion_t<N,Scalar>::get_home_pos(){
+  if(!home_pos_set) ROS_ERROR("HOME POS NOT SET DON'T GO THERE, THERE BE DRAGONS AND BROKEN CABLES!");
+  return home_pos;
+}
+
+
+
+/**
+ * @brief      Gets the home jpos output array.
+ *
+ * @param      out     The output home jpos
+ * @param[in]  length  The length
+ */
+template<int N, typename Scalar>
+void CRTK_motion_t<N,Scalar>::get_home_jpos(Scalar* out, int length)
+{
+
+  if(!home_jpos_set) ROS_ERROR("HOME JPOS NOT SET DON'T GO THERE, THERE BE DRAGONS AND BROKEN CABLES!");
+
+  for(int i=0;i<length;i++)
+  {
+    out[i] = home_jpos[i];
+  }
+
+}
+
+  /**
+   * @brief      Check if home pos is set
+   *
+   * @return     home_pos_set flag
+   */
+  template<int N, typename Scalar>
+  bool CRTK_motion_t<N,Scalar>::check_home_pos_set()
+  {
+    return home_pos_set;
+  }
+
+
+  /**
+   * @brief      Check if home jpos is set
+   *
+   * @return     home_jpos_set flag
+   */
+  template<int N, typename Scalar>
+  bool CRTK_motion_t<N,Scalar>::check_home_jpos_set()
+  {
+    return home_jpos_set;
+  }
+
+#endif
@@ -0,0 +1,285 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * crtk_motion_stats.h
+ *
+ * \brief Streaming motion statistics for the test checkers. Each channel (a
+ *  joint, a Cartesian axis, a rotation angle) keeps the running mean,
+ *  variance (Welford) and RMS of its displacement from the start of the
+ *  check and its peak speed, all in constant time and memory per sample.
+ *  Nothing is logged while samples come in; report() logs one summary when
+ *  the check ends.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_MOTION_STATS_H_
+#define CRTK_MOTION_STATS_H_
+
+#include <ros/ros.h>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include "defines.h"
+
+// Running statistics of one signal
+struct CRTK_running_stats{
+  unsigned long count;
+  double mean;
+  double m2;               // sum of squared differences from the mean
+  double sum_sq;
+  double peak;             // largest magnitude
+
+  void reset();
+  void add(double x);
+  double variance() const;
+  double stddev() const;
+  double rms() const;
+};
+
+// One channel of a check
+struct CRTK_channel_stats{
+  CRTK_running_stats pos;  // displacement from the start of the check
+  CRTK_running_stats vel;
+  double last_pos;
+};
+
+class CRTK_motion_stats{
+public:
+  CRTK_motion_stats();
+  ~CRTK_motion_stats(){};
+
+  void start(const std::string &name, int channels, const ros::Time &t);
+  void add(int channel, double displacement, double vel);
+  void add(int channel, double displacement);
+  void tick(const ros::Time &t);
+  void report(int status);
+
+  const CRTK_channel_stats &get(int channel) const;
+  int get_channels() const;
+  double get_elapsed() const;
+
+private:
+  std::string name;
+  int channels;
+  unsigned long ticks;
+  ros::Time start_time;
+  double elapsed;          // s from the start to the last tick
+  double dt;               // s between the last two ticks
+  CRTK_channel_stats stats[MAX_JOINTS];
+};
+
+
+
+/**
+ * @brief      Clears the statistics
+ */
+inline void CRTK_running_stats::reset(){
+  count  = 0;
+  mean   = 0;
+  m2     = 0;
+  sum_sq = 0;
+  peak   = 0;
+}
+
+
+/**
+ * @brief      Adds one sample
+ *
+ * @param[in]  x     The sample
+ */
+inline void CRTK_running_stats::add(double x){
+  count++;
+  double delta = x - mean;
+  mean += delta / count;
+  m2 += delta * (x - mean);
+  sum_sq += x * x;
+  if(std::fabs(x) > peak)
+    peak = std::fabs(x);
+}
+
+
+/**
+ * @brief      Gets the population variance
+ *
+ * @return     The variance, 0 before the second sample
+ */
+inline double CRTK_running_stats::variance() const{
+  return count > 1 ? m2 / count : 0;
+}
+
+
+/**
+ * @brief      Gets the standard deviation
+ *
+ * @return     The standard deviation
+ */
+inline double CRTK_running_stats::stddev() const{
+  return std::sqrt(variance());
+}
+
+
+/**
+ * @brief      Gets the root mean square
+ *
+ * @return     The RMS, 0 without samples
+ */
+inline double CRTK_running_stats::rms() const{
+  return count ? std::sqrt(sum_sq / count) : 0;
+}
+
+
+
+inline CRTK_motion_stats::CRTK_motion_stats(){
+  start("", 0, ros::Time());
+}
+
+
+/**
+ * @brief      Starts a new check, clearing every channel
+ *
+ * @param[in]  name      The check name, for the report
+ * @param[in]  channels  The number of channels (up to MAX_JOINTS)
+ * @param[in]  t         The start time
+ */
+inline void CRTK_motion_stats::start(const std::string &name, int channels, const ros::Time &t){
+  this->name = name;
+  this->channels = channels < 0 ? 0 : (channels > MAX_JOINTS ? MAX_JOINTS : channels);
+  ticks      = 0;
+  start_time = t;
+  elapsed    = 0;
+  dt         = 0;
+  for(int i=0; i<MAX_JOINTS; i++){
+    stats[i].pos.reset();
+    stats[i].vel.reset();
+    stats[i].last_pos = 0;
+  }
+}
+
+
+/**
+ * @brief      Starts a sample: call once per tick, before the add() calls
+ *
+ * @param[in]  t     The time of the sample
+ */
+inline void CRTK_motion_stats::tick(const ros::Time &t){
+  double now = (t - start_time).toSec();
+  dt = ticks ? now - elapsed : 0;
+  elapsed = now;
+  ticks++;
+}
+
+
+/**
+ * @brief      Adds one sample of a channel with a measured velocity
+ *
+ * @param[in]  channel       The channel
+ * @param[in]  displacement  The displacement from the start of the check
+ * @param[in]  vel           The velocity
+ */
+inline void CRTK_motion_stats::add(int channel, double displacement, double vel){
+  if(channel < 0 || channel >= channels)
+    return;
+  CRTK_channel_stats &s = stats[channel];
+
+  s.pos.add(displacement);
+  s.vel.add(vel);
+  s.last_pos = displacement;
+}
+
+
+/**
+ * @brief      Adds one sample of a channel, taking the velocity from the
+ *             change since the last tick
+ *
+ * @param[in]  channel       The channel
+ * @param[in]  displacement  The displacement from the start of the check
+ */
+inline void CRTK_motion_stats::add(int channel, double displacement){
+  if(channel < 0 || channel >= channels)
+    return;
+  double vel = dt > 0 ? (displacement - stats[channel].last_pos) / dt : 0;
+  add(channel, displacement, vel);
+}
+
+
+/**
+ * @brief      Logs one summary of the check: a line per channel with the
+ *             mean, standard deviation and RMS of the displacement and the
+ *             peak speed. ROS_ERROR if the check failed.
+ *
+ * @param[in]  status  The check result, > 0 passed
+ */
+inline void CRTK_motion_stats::report(int status){
+  std::string out;
+  char line[160];
+
+  snprintf(line, sizeof(line), "%s %s after %.3f s (%lu samples)\n", name.c_str(),
+    status > 0 ? "passed" : "failed", elapsed, ticks);
+  out += line;
+  out += "   ch       mean      std      rms  peak vel\n";
+  for(int i=0; i<channels; i++){
+    const CRTK_channel_stats &s = stats[i];
+    snprintf(line, sizeof(line), "  %3i %9.4f %8.4f %8.4f %9.4f\n", i,
+      s.pos.mean, s.pos.stddev(), s.pos.rms(), s.vel.peak);
+    out += line;
+  }
+
+  if(status > 0)
+    ROS_INFO("%s", out.c_str());
+  else
+    ROS_ERROR("%s", out.c_str());
+}
+
+
+/**
+ * @brief      Gets the statistics of a channel
+ *
+ * @param[in]  channel  The channel
+ *
+ * @return     The channel statistics
+ */
+inline const CRTK_channel_stats &CRTK_motion_stats::get(int channel) const{
+  return stats[channel < 0 ? 0 : (channel >= MAX_JOINTS ? MAX_JOINTS - 1 : channel)];
+}
+
+
+/**
+ * @brief      Gets the number of channels
+ *
+ * @return     The number of channels
+ */
+inline int CRTK_motion_stats::get_channels() const{
+  return channels;
+}
+
+
+/**
+ * @brief      Gets the time from the start of the check to the last tick
+ *
+ * @return     The elapsed time in s
+ */
+inline double CRTK_motion_stats::get_elapsed() const{
+  return elapsed;
+}
+
+#endif
@@ -0,0 +1,108 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford,
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_msg_pool.h
+ *
+ * \brief Small pool of pre-sized outgoing messages. A message is handed out
+ *  again only once nothing else (publisher queue, intra-process subscriber)
+ *  still holds it, so published shared_ptr messages are never modified.
+ *  In steady state no message or vector is allocated; every allocation the
+ *  pool does make is counted.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_MSG_POOL_H_
+#define CRTK_MSG_POOL_H_
+
+#include <boost/shared_ptr.hpp>
+#include <atomic>
+
+#define CRTK_MSG_POOL_SIZE 4
+
+template <typename M>
+class CRTK_msg_pool{
+public:
+  CRTK_msg_pool():next(0),alloc_count(0){};
+  ~CRTK_msg_pool(){};
+
+  void init(const M&);
+  boost::shared_ptr<M> get();
+  unsigned long get_alloc_count() const;
+
+private:
+  M proto;
+  boost::shared_ptr<M> msgs[CRTK_MSG_POOL_SIZE];
+  int next;
+  std::atomic<unsigned long> alloc_count; // read from other threads
+};
+
+
+/**
+ * @brief      Fills the pool with copies of a pre-sized prototype message
+ *
+ * @param[in]  in    The prototype
+ */
+template <typename M>
+void CRTK_msg_pool<M>::init(const M& in){
+  proto = in;
+  for(int i=0;i<CRTK_MSG_POOL_SIZE;i++)
+    msgs[i].reset(new M(proto));
+  next = 0;
+}
+
+
+/**
+ * @brief      Gets a message nobody else holds. Allocates (and counts) a fresh
+ *             copy of the prototype only if every pooled message is still in use.
+ *
+ * @return     the message to fill and publish
+ */
+template <typename M>
+boost::shared_ptr<M> CRTK_msg_pool<M>::get(){
+  for(int k=0;k<CRTK_MSG_POOL_SIZE;k++){
+    int i = (next + k) % CRTK_MSG_POOL_SIZE;
+    if(msgs[i] && msgs[i].unique()){
+      next = (i + 1) % CRTK_MSG_POOL_SIZE;
+      return msgs[i];
+    }
+  }
+
+  // all in flight: replace the oldest slot
+  alloc_count.fetch_add(1, std::memory_order_relaxed);
+  msgs[next].reset(new M(proto));
+  boost::shared_ptr<M> out = msgs[next];
+  next = (next + 1) % CRTK_MSG_POOL_SIZE;
+  return out;
+}
+
+
+/**
+ * @brief      Gets the number of messages allocated after init()
+ *
+ * @return     The allocation count.
+ */
+template <typename M>
+unsigned long CRTK_msg_pool<M>::get_alloc_count() const{
+  return alloc_count.load(std::memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,361 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_otg.h
+ *
+ * \brief Online jerk-limited trajectory generator for servo_jp, in the
+ *  spirit of Reflexxes: each tick every joint takes the largest jerk toward
+ *  its target that still lets it stop there within its velocity,
+ *  acceleration and jerk limits. The next state is computed from the current
+ *  one every tick, so the target may change at any time and the motion
+ *  stays continuous in position, velocity and acceleration.
+ *
+ *  Rest-to-rest moves are time-synchronized: the limits of the faster joints
+ *  are time-scaled so all joints arrive together, the slowest one at its
+ *  minimum time. A retarget while moving runs every joint at its own limits.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_OTG_H_
+#define CRTK_OTG_H_
+
+#include "crtk_trajectory.h"
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+template <int Capacity, typename Scalar>
+class CRTK_otg_t : public CRTK_trajectory{
+public:
+  typedef std::array<double, Capacity> state_array;
+
+  CRTK_otg_t();
+
+  char set_limits(const Scalar *vel, const Scalar *acc, const Scalar *jerk, int n);
+  void reset(const Scalar *jpos, int n);
+  void set_target(const Scalar *target, double dt);
+  char update(double dt);
+
+  void get_jp(Scalar *out) const;
+  void get_jv(Scalar *out) const;
+  bool at_target() const;
+  bool target_changed(const Scalar *target) const;
+
+  static double min_time(double dist, double vel, double acc, double jerk);
+  static double stop_distance(double v, double a, double acc, double jerk);
+
+private:
+  static void integrate(double &p, double &v, double &a, double j, double t);
+  bool feasible(int i, double j, double dt) const;
+
+  int joints;
+  state_array pos, vel, acc;      // current state
+  state_array goal;
+  state_array max_vel, max_acc, max_jerk;
+  state_array lim_vel, lim_acc, lim_jerk;   // limits in use (time-scaled)
+};
+
+
+template <int Capacity, typename Scalar>
+CRTK_otg_t<Capacity,Scalar>::CRTK_otg_t():joints(0){
+  pos.fill(0); vel.fill(0); acc.fill(0); goal.fill(0);
+  max_vel.fill(0); max_acc.fill(0); max_jerk.fill(0);
+  lim_vel.fill(0); lim_acc.fill(0); lim_jerk.fill(0);
+}
+
+
+/**
+ * @brief      Sets the per joint limits
+ *
+ * @param[in]  vel   The velocity limits (rad/s or m/s)
+ * @param[in]  acc   The acceleration limits
+ * @param[in]  jerk  The jerk limits
+ * @param[in]  n     The number of joints
+ *
+ * @return     success 0, fail -1 (limits must be positive)
+ */
+template <int Capacity, typename Scalar>
+char CRTK_otg_t<Capacity,Scalar>::set_limits(const Scalar *vel_in, const Scalar *acc_in, const Scalar *jerk_in, int n){
+  if(n > Capacity)
+    return -1;
+  for(int i=0;i<n;i++)
+    if(!(vel_in[i] > 0 && acc_in[i] > 0 && jerk_in[i] > 0))
+      return -1;
+
+  for(int i=0;i<n;i++){
+    max_vel[i] = vel_in[i];
+    max_acc[i] = acc_in[i];
+    max_jerk[i] = jerk_in[i];
+  }
+  return 0;
+}
+
+
+/**
+ * @brief      Puts the generator at rest at a position
+ *
+ * @param[in]  jpos  The position
+ * @param[in]  n     The number of joints
+ */
+template <int Capacity, typename Scalar>
+void CRTK_otg_t<Capacity,Scalar>::reset(const Scalar *jpos, int n){
+  joints = std::min(n, (int)Capacity);
+  for(int i=0;i<joints;i++){
+    pos[i] = goal[i] = jpos[i];
+    vel[i] = acc[i] = 0;
+  }
+  cancel();
+}
+
+
+/**
+ * @brief      Sets a new target, keeping the current state. Starts the
+ *             trajectory with the synchronized duration as its length.
+ *
+ * @param[in]  target  The target position of every joint
+ * @param[in]  dt      The tick period
+ */
+template <int Capacity, typename Scalar>
+void CRTK_otg_t<Capacity,Scalar>::set_target(const Scalar *target, double dt){
+  bool at_rest = true;
+  for(int i=0;i<joints;i++){
+    goal[i] = target[i];
+    if(fabs(vel[i]) > 1e-9 || fabs(acc[i]) > 1e-9)
+      at_rest = false;
+  }
+
+  double duration = 0;
+  state_array t_min;
+  for(int i=0;i<joints;i++){
+    t_min[i] = min_time(fabs(goal[i] - pos[i]), max_vel[i], max_acc[i], max_jerk[i]);
+    duration = std::max(duration, t_min[i]);
+  }
+
+  // stretching joint i in time by 1/k scales its limits by k, k^2, k^3
+  for(int i=0;i<joints;i++){
+    double k = (at_rest && duration > 0 && t_min[i] > 0) ? t_min[i] / duration : 1;
+    lim_vel[i] = max_vel[i] * k;
+    lim_acc[i] = max_acc[i] * k * k;
+    lim_jerk[i] = max_jerk[i] * k * k * k;
+  }
+
+  start(duration / dt);
+}
+
+
+/**
+ * @brief      Minimum time of a rest-to-rest move
+ *
+ * @param[in]  dist  The distance
+ * @param[in]  vel   The velocity limit
+ * @param[in]  acc   The acceleration limit
+ * @param[in]  jerk  The jerk limit
+ *
+ * @return     The time (s)
+ */
+template <int Capacity, typename Scalar>
+double CRTK_otg_t<Capacity,Scalar>::min_time(double dist, double vel, double acc, double jerk){
+  if(dist <= 0 || vel <= 0 || acc <= 0 || jerk <= 0)
+    return 0;
+
+  // time to reach vel from rest (and to stop from it)
+  double t_acc = vel*jerk >= acc*acc ? vel/acc + acc/jerk : 2*sqrt(vel/jerk);
+
+  if(dist >= vel*t_acc)
+    return t_acc + dist/vel;
+
+  // vel not reached: find the peak velocity that covers dist
+  double peak = acc*(sqrt(acc*acc/(jerk*jerk) + 4*dist/acc) - acc/jerk)/2;
+  if(peak*jerk >= acc*acc)
+    return 2*(peak/acc + acc/jerk);
+
+  peak = pow(dist*sqrt(jerk)/2, 2.0/3.0);
+  return 4*sqrt(peak/jerk);
+}
+
+
+/**
+ * @brief      Integrates a constant jerk segment
+ */
+template <int Capacity, typename Scalar>
+void CRTK_otg_t<Capacity,Scalar>::integrate(double &p, double &v, double &a, double j, double t){
+  p += v*t + a*t*t/2 + j*t*t*t/6;
+  v += a*t + j*t*t/2;
+  a += j*t;
+}
+
+
+/**
+ * @brief      Distance covered while braking to rest as hard as the limits
+ *             allow (jerk down, hold -acc, jerk back to zero)
+ *
+ * @param[in]  v     The velocity (positive toward the target)
+ * @param[in]  a     The acceleration
+ * @param[in]  acc   The acceleration limit
+ * @param[in]  jerk  The jerk limit
+ *
+ * @return     The signed braking distance
+ */
+template <int Capacity, typename Scalar>
+double CRTK_otg_t<Capacity,Scalar>::stop_distance(double v, double a, double acc, double jerk){
+  if(v < 0 || (v == 0 && a < 0))
+    return -stop_distance(-v, -a, acc, jerk);
+
+  double p = 0;
+
+  // already decelerating too hard to reach zero velocity and acceleration
+  // together: release the brake, then stop the reverse motion
+  if(a < 0 && v*jerk < a*a/2){
+    integrate(p, v, a, jerk, -a/jerk);
+    return p + stop_distance(v, 0, acc, jerk);
+  }
+
+  double a_min = -sqrt(v*jerk + a*a/2);
+  double t_hold = 0;
+  if(a_min < -acc){
+    a_min = -acc;
+    t_hold = (v + (a*a - 2*acc*acc)/(2*jerk))/acc;
+  }
+
+  integrate(p, v, a, -jerk, (a - a_min)/jerk);
+  integrate(p, v, a, 0, t_hold);
+  integrate(p, v, a, jerk, -a_min/jerk);
+  return p;
+}
+
+
+/**
+ * @brief      Checks if one tick at jerk j keeps joint i within its velocity
+ *             limit and able to stop at its target
+ */
+template <int Capacity, typename Scalar>
+bool CRTK_otg_t<Capacity,Scalar>::feasible(int i, double j, double dt) const{
+  double dir = goal[i] >= pos[i] ? 1 : -1;
+  double p = 0, v = dir*vel[i], a = dir*acc[i];
+  double A = lim_acc[i], J = lim_jerk[i];
+
+  if(a + j*dt > A) j = (A - a)/dt;
+  if(a + j*dt < -A) j = (-A - a)/dt;
+  integrate(p, v, a, j, dt);
+
+  double v_peak = a > 0 ? v + a*a/(2*J) : v;
+  if(v_peak > lim_vel[i] * (1 + 1e-9))
+    return false;
+
+  return p + stop_distance(v, a, A, J) <= dir*(goal[i] - pos[i]) + 1e-12;
+}
+
+
+/**
+ * @brief      Advances every joint by one tick
+ *
+ * @param[in]  dt    The tick period
+ *
+ * @return     1 once every joint is at rest on its target, 0 otherwise
+ */
+template <int Capacity, typename Scalar>
+char CRTK_otg_t<Capacity,Scalar>::update(double dt){
+  if(at_target())
+    return 1;
+
+  for(int i=0;i<joints;i++){
+    double A = lim_acc[i], J = lim_jerk[i];
+    double dir = goal[i] >= pos[i] ? 1 : -1;
+
+    // close enough to finish this tick without exceeding the limits
+    if(fabs(goal[i] - pos[i]) < J*dt*dt*dt && fabs(vel[i]) < J*dt*dt && fabs(acc[i]) < J*dt){
+      pos[i] = goal[i];
+      vel[i] = acc[i] = 0;
+      continue;
+    }
+
+    // largest jerk toward the target that is still feasible
+    double j;
+    if(feasible(i, J, dt))
+      j = J;
+    else if(!feasible(i, -J, dt))
+      j = -J;
+    else{
+      double lo = -J, hi = J;
+      for(int k=0;k<20;k++){
+        double mid = (lo + hi)/2;
+        if(feasible(i, mid, dt)) lo = mid; else hi = mid;
+      }
+      j = lo;
+    }
+
+    double a = dir*acc[i];
+    if(a + j*dt > A) j = (A - a)/dt;
+    if(a + j*dt < -A) j = (-A - a)/dt;
+
+    integrate(pos[i], vel[i], acc[i], dir*j, dt);
+  }
+
+  step();
+  return at_target();
+}
+
+
+/**
+ * @brief      Checks if every joint is at rest on its target
+ */
+template <int Capacity, typename Scalar>
+bool CRTK_otg_t<Capacity,Scalar>::at_target() const{
+  for(int i=0;i<joints;i++)
+    if(pos[i] != goal[i] || vel[i] != 0 || acc[i] != 0)
+      return false;
+  return true;
+}
+
+
+/**
+ * @brief      Checks if a target differs from the current one
+ */
+template <int Capacity, typename Scalar>
+bool CRTK_otg_t<Capacity,Scalar>::target_changed(const Scalar *target) const{
+  for(int i=0;i<joints;i++)
+    if((double)target[i] != goal[i])
+      return true;
+  return false;
+}
+
+
+/**
+ * @brief      Gets the position of every joint
+ */
+template <int Capacity, typename Scalar>
+void CRTK_otg_t<Capacity,Scalar>::get_jp(Scalar *out) const{
+  for(int i=0;i<joints;i++)
+    out[i] = pos[i];
+}
+
+
+/**
+ * @brief      Gets the velocity of every joint
+ */
+template <int Capacity, typename Scalar>
+void CRTK_otg_t<Capacity,Scalar>::get_jv(Scalar *out) const{
+  for(int i=0;i<joints;i++)
+    out[i] = vel[i];
+}
+
+#endif
@@ -0,0 +1,131 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * crtk_recorder.h
+ *
+ * \brief In-process recorder for the measured and commanded streams of one
+ *  arm. Every sample becomes one fixed-size binary record. The callbacks and
+ *  the control loop claim a slot in a lock-free ring and fill it in place;
+ *  they never allocate, lock or touch the disk, and when the ring is full
+ *  the record is dropped and counted instead. A background thread drains the
+ *  ring into a memory-mapped file.
+ *
+ *  The file is an array of CRTK_record, the first of which holds a
+ *  CRTK_record_file_header. crtk_record_to_csv converts it to CSV.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_RECORDER_H_
+#define CRTK_RECORDER_H_
+
+#include "defines.h"
+#include <ros/ros.h>
+#include <tf/tf.h>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <stdint.h>
+
+#define CRTK_RECORD_VALUES (3*MAX_JOINTS)
+
+// servo records are CRTK_RECORD_SERVO + CRTK_servo_channel
+enum CRTK_record_type {CRTK_RECORD_HEADER, CRTK_RECORD_MEASURED_JS, CRTK_RECORD_MEASURED_CP,
+  CRTK_RECORD_OPERATING_STATE, CRTK_RECORD_SERVO, CRTK_RECORD_NUM = CRTK_RECORD_SERVO + CRTK_SERVO_NUM};
+
+/**
+ * One sample. measured_js holds count positions, then count velocities,
+ * then count efforts (NaN if not sent); Cartesian records x y z qx qy qz qw;
+ * operating_state the CRTK_robot_state_enum, is_homed and is_busy.
+ */
+struct CRTK_record{
+  int64_t t_ns;        // CRTK_clock time the sample was recorded
+  int64_t stamp_ns;    // header stamp, 0 if none
+  uint32_t dropped;    // records dropped so far, a jump means a gap before this one
+  uint16_t type;       // CRTK_record_type
+  uint16_t count;
+  double value[CRTK_RECORD_VALUES];
+};
+
+struct CRTK_record_file_header{
+  char magic[8];       // CRTK_RECORD_MAGIC
+  uint32_t version;
+  uint32_t record_size;
+  uint32_t num_joints;
+  uint32_t reserved;
+  int64_t start_wall_ns;    // wall clock at open
+  int64_t start_t_ns;       // CRTK_clock at open
+  char robot_name[64];
+};
+
+#define CRTK_RECORD_MAGIC "CRTKREC"
+#define CRTK_RECORD_VERSION 1
+
+class CRTK_recorder{
+public:
+  CRTK_recorder();
+  ~CRTK_recorder();
+
+  char open(const std::string& path, const std::string& robot_name, int num_joints, int slots = 8192);
+  void close();
+  bool is_open() const;
+
+  void record(CRTK_record_type, const ros::Time& stamp, const double* values, int count);
+  void record(CRTK_record_type, const ros::Time& stamp, const float* values, int count);
+  void record(CRTK_record_type, const ros::Time& stamp, const tf::Transform&);
+  void record_js(const ros::Time& stamp, const double* pos, const double* vel, const double* eff, int count);
+
+  unsigned long get_written() const;
+  unsigned long get_dropped() const;
+
+private:
+  CRTK_recorder(const CRTK_recorder&);
+  CRTK_recorder& operator=(const CRTK_recorder&);
+
+  struct slot{
+    std::atomic<uint64_t> seq;    // pos + 1 once filled, pos + ring_size once flushed
+    uint64_t pos;
+    CRTK_record rec;
+  };
+
+  slot* claim(CRTK_record_type, const ros::Time& stamp, int count);
+  void commit(slot*);
+  void flush_loop();
+  int drain();
+  char map_window(uint64_t index);
+
+  slot *ring;
+  uint64_t ring_size;             // power of two
+  std::atomic<uint64_t> head;     // next slot to claim
+  uint64_t tail;                  // next slot to flush (flush thread only)
+  std::atomic<unsigned long> dropped;
+  std::atomic<unsigned long> written;
+  std::atomic<bool> running;
+  std::thread flusher;
+
+  int fd;
+  CRTK_record *window;            // mapped part of the file
+  uint64_t window_index;
+  uint64_t file_records;          // records in the file, header included
+};
+
+#endif
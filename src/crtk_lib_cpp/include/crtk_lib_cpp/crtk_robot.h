@@ -39,27 +39,52 @@
 #include <geometry_msgs/TransformStamped.h>
 #include <sensor_msgs/JointState.h>
 #include <crtk_msgs/operating_state.h>
+#include <crtk_msgs/StringStamped.h>
 #include "crtk_robot_state.h"
 #include "crtk_motion.h"
+#include "crtk_msg_pool.h"
+#include "crtk_rt_loop.h"
+#include "crtk_histogram.h"
+#include "crtk_transport.h"
+#include "crtk_recorder.h"
+#include <atomic>
 
 // Max DOF 
 // extern const int MAX_JOINTS;
 
 class CRTK_robot{
 
+  private:
+    // first, so it is destroyed after the state and the subscribers that
+    // record into it
+    CRTK_recorder recorder;
+
   public:
     CRTK_robot_state state;
     CRTK_motion arm;
 
     CRTK_robot(ros::NodeHandle n,std::string);
-    ~CRTK_robot(){};
+    ~CRTK_robot();
     bool init_param(ros::NodeHandle);
     bool init_ros(ros::NodeHandle);
-    void crtk_measured_cp_arm_cb(geometry_msgs::TransformStamped);
-    void crtk_measured_js_arm_cb(sensor_msgs::JointState);
+    void init_recorder(ros::NodeHandle);
+    void init_diagnostics(ros::NodeHandle);
+    void init_msg_pools();
+    unsigned long get_publish_alloc_count();
+    unsigned long get_measured_js_rejected();
+    ros::Time get_input_stamp();
+    unsigned long get_commands_sent();
+    void crtk_measured_cp_arm_cb(const geometry_msgs::TransformStamped::ConstPtr&);
+    void crtk_measured_js_arm_cb(const sensor_msgs::JointState::ConstPtr&);
+    void crtk_interp_cp_arm_cb(const geometry_msgs::TransformStamped::ConstPtr&);
+    void crtk_interp_jp_arm_cb(const sensor_msgs::JointState::ConstPtr&);
+    void crtk_move_cp_arm_cb(const geometry_msgs::TransformStamped::ConstPtr&);
+    void crtk_move_jp_arm_cb(const sensor_msgs::JointState::ConstPtr&);
     void set_state(CRTK_robot_state *new_state);
 
     void check_motion_commands_to_publish();
+    void publish_servo(CRTK_servo_channel);
+    unsigned long get_servo_dropped(CRTK_servo_channel);
     void publish_servo_cr();
     void publish_servo_cv();
     void publish_servo_cp();
@@ -69,14 +94,26 @@ class CRTK_robot{
     void publish_servo_jp();
     void publish_servo_jv_grasp();
     void publish_servo_jv();
+    void publish_move_status(CRTK_move_status);
     void run();
+    void publish_diagnostics(const ros::WallTimerEvent&);
   private:
     unsigned int max_joints; 
+    // counters are read by the diagnostics timer on another thread
+    std::atomic<unsigned long> measured_js_rejected;
+    std::atomic<unsigned long> servo_dropped[CRTK_SERVO_NUM];
     std::string robot_name;
     std::string grasper_name;
 
     ros::Subscriber sub_measured_cp;
     ros::Subscriber sub_measured_js; 
+    ros::Subscriber sub_interp_cp;
+    ros::Subscriber sub_interp_jp;
+    ros::Subscriber sub_move_cp;
+    ros::Subscriber sub_move_jp;
+    ros::Publisher pub_move_status;
+    CRTK_move_status last_move_status;
+    unsigned long move_status_ticks;
 
     ros::Publisher pub_servo_cr;
     ros::Publisher pub_servo_cp;
@@ -87,6 +124,31 @@ class CRTK_robot{
     ros::Publisher pub_servo_jr_grasp;
     ros::Publisher pub_servo_jv_grasp;
     ros::Publisher pub_servo_jp_grasp;
+
+    // measured message age at receipt (header stamp to callback) and the
+    // age of the newest measured_js when a servo command goes out
+    CRTK_histogram measured_js_age;
+    CRTK_histogram measured_cp_age;
+    CRTK_histogram measured_js_to_publish;
+    std::atomic<int64_t> measured_js_rx_ns;
+    // read by a lockstep CRTK_rt_loop (see CRTK_rt_loop::follow)
+    std::atomic<int64_t> measured_js_stamp_ns;
+    std::atomic<int64_t> measured_cp_stamp_ns;
+    std::atomic<unsigned long> servo_sent;
+    int64_t last_report_js_rx_ns;
+    unsigned long last_report_js_rejected;
+    ros::Publisher pub_diagnostics;
+    ros::WallTimer diagnostics_timer;
+
+    CRTK_msg_pool<geometry_msgs::TransformStamped> pool_servo_cr;
+    CRTK_msg_pool<geometry_msgs::TransformStamped> pool_servo_cp;
+    CRTK_msg_pool<geometry_msgs::TransformStamped> pool_servo_cv;
+    CRTK_msg_pool<sensor_msgs::JointState> pool_servo_jr;
+    CRTK_msg_pool<sensor_msgs::JointState> pool_servo_jp;
+    CRTK_msg_pool<sensor_msgs::JointState> pool_servo_jv;
+    CRTK_msg_pool<sensor_msgs::JointState> pool_servo_jr_grasp;
+    CRTK_msg_pool<sensor_msgs::JointState> pool_servo_jp_grasp;
+    CRTK_msg_pool<sensor_msgs::JointState> pool_servo_jv_grasp;
 };
 
 #endif
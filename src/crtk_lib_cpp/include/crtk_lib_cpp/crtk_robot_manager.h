@@ -0,0 +1,107 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_robot_manager.h
+ *
+ * \brief Drives several arms (one CRTK_robot per robot namespace) from one
+ *  process and one loop. Each tick the app's step function runs for every
+ *  arm, optionally spread over a few worker threads, and only once all arms
+ *  are done are their servo commands published, back to back, so the arms'
+ *  commands go out within a small, measured skew.
+ *
+ *  Read from the given node handle:
+ *    r_spaces           list of robot namespaces, e.g. [arm1, arm2]
+ *    arm_threads        extra worker threads for the step functions
+ *                       (default 0: all arms step on the loop thread)
+ *    max_publish_skew   warn when publishing all arms takes longer (s,
+ *                       default 0.0002)
+ *  plus the CRTK_rt_loop parameters for spin(). Workers are started on the
+ *  first tick and inherit the loop thread's scheduling and CPU affinity,
+ *  so leave rt_cpu unset when using arm_threads.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_ROBOT_MANAGER_H_
+#define CRTK_ROBOT_MANAGER_H_
+
+#include "crtk_robot.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class CRTK_robot_manager{
+  public:
+    typedef std::function<int(CRTK_robot*, const ros::Time&)> arm_step;
+
+    CRTK_robot_manager(ros::NodeHandle n);
+    CRTK_robot_manager(ros::NodeHandle n, const std::vector<std::string>&, int arm_threads = 0);
+    ~CRTK_robot_manager();
+
+    int get_num_arms();
+    CRTK_robot* get_arm(int);
+    CRTK_robot* get_arm(const std::string&);
+    void set_step(const arm_step&);
+
+    void run(const ros::Time&);
+    void spin();
+    double get_max_publish_skew();
+
+  private:
+    CRTK_robot_manager(const CRTK_robot_manager&);
+    CRTK_robot_manager& operator=(const CRTK_robot_manager&);
+
+    void init(const std::vector<std::string>&, int);
+    void start_workers();
+    void worker();
+    void step_arms();
+    void publish_diagnostics(const ros::WallTimerEvent&);
+
+    ros::NodeHandle n;
+    std::vector<std::string> names;
+    std::vector<CRTK_robot*> arms;
+    arm_step step;
+
+    // worker pool: each tick the loop thread bumps generation, then it and
+    // the workers claim arms through next_arm until all are stepped
+    int num_threads;
+    std::vector<std::thread> workers;
+    std::mutex pool_mutex;
+    std::condition_variable pool_wake;
+    std::condition_variable pool_done;
+    unsigned long generation;
+    bool stopping;
+    std::atomic<int> next_arm;
+    std::atomic<int> arms_done;
+    ros::Time tick_time;
+
+    int64_t max_skew_ns;
+    std::atomic<int64_t> worst_skew_ns;
+    CRTK_histogram step_hist;
+    CRTK_histogram skew_hist;
+    ros::Publisher pub_diagnostics;
+    ros::WallTimer diagnostics_timer;
+};
+
+#endif
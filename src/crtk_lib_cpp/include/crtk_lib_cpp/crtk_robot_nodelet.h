@@ -0,0 +1,62 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford,
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_robot_nodelet.h
+ *
+ * \brief Nodelet form of a CRTK_robot client. Loaded into the same nodelet
+ *  manager as the robot driver, servo_* and measured_* messages are passed
+ *  as shared pointers with no serialization.
+ *
+ *  Apps derive from this class and implement loop(), which is called once
+ *  per LOOP_RATE tick before the robot's pending commands are published.
+ *  Callbacks run on the manager's threads, not in the loop.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_ROBOT_NODELET_H_
+#define CRTK_ROBOT_NODELET_H_
+
+#include "crtk_robot.h"
+#include <nodelet/nodelet.h>
+#include <atomic>
+#include <thread>
+#include <ctime>
+
+class CRTK_robot_nodelet : public nodelet::Nodelet{
+  public:
+    CRTK_robot_nodelet();
+    virtual ~CRTK_robot_nodelet();
+
+  protected:
+    CRTK_robot *robot;
+
+    virtual void onInit();
+    virtual int loop(const ros::Time&) = 0;
+
+  private:
+    void run_loop();
+
+    std::thread loop_thread;
+    std::atomic<bool> running;
+};
+
+#endif
@@ -36,6 +36,25 @@
 #include <ros/param.h>
 #include <crtk_msgs/operating_state.h>
 #include <crtk_msgs/StringStamped.h>
+#include "crtk_transport.h"
+#include "crtk_recorder.h"
+#include "crtk_seqlock.h"
+#include <atomic>
+
+// One coherent set of state flags. The callback replaces all of them at once,
+// so a reader never mixes flags from different operating_state messages.
+struct CRTK_robot_state_flags{
+  bool is_disabled;
+  bool is_enabled;
+  bool is_paused;
+  bool is_fault;
+  bool is_homing;
+  bool is_busy;
+  bool is_ready;
+  bool is_homed;
+
+  bool has_connected;
+};
 
 
 class CRTK_robot_state
@@ -45,6 +64,8 @@ class CRTK_robot_state
   // methods
   CRTK_robot_state();
   CRTK_robot_state(ros::NodeHandle n,std::string);
+  CRTK_robot_state(const CRTK_robot_state&);
+  CRTK_robot_state& operator=(const CRTK_robot_state&);
 
   ~CRTK_robot_state(){};
 
@@ -65,6 +86,7 @@ class CRTK_robot_state
   bool get_homed();
   bool get_connected();
 
+  CRTK_robot_state_flags get_flags();
   CRTK_robot_state_enum get_state();
 
   bool set_disabled_state();
@@ -74,8 +96,11 @@ class CRTK_robot_state
   bool set_connected(bool);
 
   bool init_ros(ros::NodeHandle);
-  void operating_state_cb(crtk_msgs::operating_state msg);
+  void operating_state_cb(const crtk_msgs::operating_state::ConstPtr& msg);
   void crtk_command_pb(CRTK_robot_command);
+  void set_recorder(CRTK_recorder*);
+  ros::Time get_stamp();
+  unsigned long get_commands_sent();
 
   char state_char();
   std::string state_string();
@@ -84,18 +109,20 @@ class CRTK_robot_state
   ros::Subscriber sub;
 
 private:
+  void clear_flags();
+  void set_exclusive_state(CRTK_robot_state_enum);
+  static CRTK_robot_state_enum state_of(const CRTK_robot_state_flags&);
+
   std::string robot_name;
 
-  bool is_disabled;
-  bool is_enabled;
-  bool is_paused;
-  bool is_fault;
-  bool is_homing;
-  bool is_busy;
-  bool is_ready;
-  bool is_homed;
+  // written by the operating_state callback, read by the loop
+  CRTK_seqlock<CRTK_robot_state_flags> flags;
 
-  bool has_connected;
+  std::atomic<CRTK_recorder*> recorder;   // read by the callback on a spinner thread
+
+  // for the lockstep clock (see CRTK_rt_loop::follow)
+  std::atomic<int64_t> stamp_ns;          // stamp of the last operating_state
+  std::atomic<unsigned long> commands_sent;
 
 };
 
@@ -0,0 +1,120 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_rt_loop.h
+ *
+ * \brief Fixed-rate loop timer to use in place of ros::Rate. Sleeps with
+ *  clock_nanosleep to absolute CLOCK_MONOTONIC deadlines, so the period does
+ *  not drift, and counts and reports every missed deadline. Optionally makes
+ *  the calling thread SCHED_FIFO, pins it to a CPU and locks memory.
+ *
+ *  Switching a loop over is one line:
+ *    CRTK_rt_loop loop_rate(n, LOOP_RATE);   // was ros::Rate loop_rate(LOOP_RATE);
+ *
+ *  Read from the given node handle (all optional):
+ *    rt_priority  SCHED_FIFO priority 1-99, 0 leaves the scheduler alone
+ *    rt_cpu       CPU to pin the loop thread to, -1 for no affinity
+ *    rt_mlockall  lock current and future memory (true/false)
+ *    diagnostics_period  seconds between /diagnostics summaries of the loop
+ *                 period and compute time (default 1, 0 disables)
+ *
+ *  Under use_sim_time it sleeps on ROS time instead, and acks on /clock_ack
+ *  before every sleep, so a clock running in lockstep (crtk_sim with
+ *  lockstep set) waits for it rather than running ahead. The ack string is
+ *  "<key> <commands sent> <input stamp ns>": key names this loop (node
+ *  name#instance), and the counts cover the robots passed to follow(). The
+ *  clock then handles those commands before its next step, and on waking
+ *  the loop waits until it holds those robots' measured_* for the new step,
+ *  since neither travels on the clock's own connection.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_RT_LOOP_H_
+#define CRTK_RT_LOOP_H_
+
+#include <ros/ros.h>
+#include <ros/callback_queue.h>
+#include <ctime>
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "crtk_histogram.h"
+
+class CRTK_robot;
+class CRTK_robot_state;
+
+class CRTK_rt_loop{
+  public:
+    CRTK_rt_loop(double rate);
+    CRTK_rt_loop(const ros::NodeHandle &n, double rate);
+    ~CRTK_rt_loop();
+
+    bool sleep();
+    void reset();
+    char set_realtime(int priority, int cpu, bool lock_memory);
+    void follow(CRTK_robot*, ros::CallbackQueue *queue = ros::getGlobalCallbackQueue());
+    void follow(CRTK_robot_state*, ros::CallbackQueue *queue = ros::getGlobalCallbackQueue());
+
+    unsigned long get_cycles();
+    unsigned long get_overruns();
+    unsigned long get_stale();
+    double get_max_overrun();
+    double get_period();
+
+  private:
+    void init(double rate);
+    void record_wake(int64_t wake_ns);
+    void publish_diagnostics(const ros::WallTimerEvent&);
+    void publish_ack(const ros::Time& done);
+    ros::Time input_stamp();
+    void wait_inputs();
+
+    int64_t period_ns;
+    struct timespec next;      // deadline of the current cycle (CLOCK_MONOTONIC)
+    bool sim_time;
+    ros::Time sim_next;
+    ros::Publisher pub_clock_ack;
+    std::string ack_key;
+    std::vector<CRTK_robot*> followed;
+    std::vector<CRTK_robot_state*> followed_states;
+    ros::CallbackQueue *follow_queue;   // spun while waiting, NULL if another thread does
+    double lockstep_timeout;            // s of wall time to wait for the inputs
+    unsigned long acked_sent;
+    std::atomic<unsigned long> stale;   // ticks run without them
+
+    std::atomic<unsigned long> cycles;
+    std::atomic<unsigned long> overruns;
+    std::atomic<int64_t> max_overrun_ns;
+
+    // wake to wake, and wake to the next sleep() call
+    int64_t last_wake_ns;
+    CRTK_histogram period_hist;
+    CRTK_histogram compute_hist;
+
+    std::string diagnostics_name;
+    unsigned long last_report_overruns;
+    ros::Publisher pub_diagnostics;
+    ros::WallTimer diagnostics_timer;
+};
+
+#endif
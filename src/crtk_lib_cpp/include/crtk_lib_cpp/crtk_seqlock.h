@@ -0,0 +1,157 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford,
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_seqlock.h
+ *
+ * \brief Sequence lock used to share measured robot state between the ROS
+ *  callbacks and the control loop. Readers never block and retry if a
+ *  write was in progress, so they always see one coherent sample.
+ *
+ *  Writers serialize on the sequence counter itself, so the measured_js and
+ *  measured_cp callbacks may run on different AsyncSpinner threads.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_SEQLOCK_H_
+#define CRTK_SEQLOCK_H_
+
+#include <atomic>
+
+template <typename T>
+class CRTK_seqlock{
+public:
+  CRTK_seqlock():seq(0){};
+  ~CRTK_seqlock(){};
+
+  T* write_begin();
+  void write_end();
+  void store(const T&);
+
+  T load() const;
+  void load(T*) const;
+  bool try_load(T*) const;
+  unsigned long version() const;
+
+private:
+  CRTK_seqlock(const CRTK_seqlock&);
+  CRTK_seqlock& operator=(const CRTK_seqlock&);
+
+  std::atomic<unsigned long> seq; // odd while a write is in progress
+  T data;
+};
+
+
+/**
+ * @brief      Claims the writer side and returns the payload to modify in place.
+ *             Must be paired with write_end().
+ *
+ * @return     pointer to the shared payload
+ */
+template <typename T>
+T* CRTK_seqlock<T>::write_begin(){
+  unsigned long s = seq.load(std::memory_order_relaxed);
+  for(;;){
+    if(!(s & 1) && seq.compare_exchange_weak(s, s+1, std::memory_order_acquire))
+      break;
+    s = seq.load(std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  return &data;
+}
+
+
+/**
+ * @brief      Publishes the payload written since write_begin().
+ */
+template <typename T>
+void CRTK_seqlock<T>::write_end(){
+  seq.fetch_add(1, std::memory_order_release);
+}
+
+
+/**
+ * @brief      Replaces the whole payload.
+ *
+ * @param[in]  in    The new value
+ */
+template <typename T>
+void CRTK_seqlock<T>::store(const T& in){
+  *write_begin() = in;
+  write_end();
+}
+
+
+/**
+ * @brief      Copies out a coherent payload, retrying while a write is in progress.
+ *
+ * @param      out   The output value
+ */
+template <typename T>
+void CRTK_seqlock<T>::load(T* out) const{
+  while(!try_load(out));
+}
+
+
+/**
+ * @brief      Copies out a coherent payload.
+ *
+ * @return     The payload.
+ */
+template <typename T>
+T CRTK_seqlock<T>::load() const{
+  T out;
+  load(&out);
+  return out;
+}
+
+
+/**
+ * @brief      Single read attempt.
+ *
+ * @param      out   The output value (may be torn if this returns false)
+ *
+ * @return     true if out holds a coherent copy
+ */
+template <typename T>
+bool CRTK_seqlock<T>::try_load(T* out) const{
+  unsigned long s0 = seq.load(std::memory_order_acquire);
+  if(s0 & 1)
+    return false;
+
+  *out = data;
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return seq.load(std::memory_order_relaxed) == s0;
+}
+
+
+/**
+ * @brief      Gets the number of completed writes.
+ *
+ * @return     the write count
+ */
+template <typename T>
+unsigned long CRTK_seqlock<T>::version() const{
+  return seq.load(std::memory_order_acquire) >> 1;
+}
+
+#endif
@@ -0,0 +1,50 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * crtk_suite.h
+ *
+ * \brief Machine readable results for the test nodes, read from the private
+ *  parameters given to CRTK_suite::init:
+ *    result_file     appends one JSON line per test,
+ *                      {"test": "test_5_1", "status": 1, "time": 12.345}
+ *                    and {"done": true, "errors": 0} when the suite ends
+ *    exit_when_done  shuts the node down once the suite ends, so it exits
+ *                    with 0 if every test passed and 1 otherwise
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_SUITE_H_
+#define CRTK_SUITE_H_
+
+#include <ros/ros.h>
+#include <string>
+
+class CRTK_suite{
+public:
+  static void init(const ros::NodeHandle&);
+  static void result(const std::string& test, int status);
+  static void done(int errors);
+  static int exit_code();
+};
+
+#endif
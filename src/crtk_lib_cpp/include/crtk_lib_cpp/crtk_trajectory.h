@@ -0,0 +1,257 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_trajectory.h
+ *
+ * \brief Progress of a multi-tick motion primitive (go_to_pos, go_to_jpos,
+ *  send_servo_cp_distance, send_servo_cp_rot_angle). Each CRTK_motion owns
+ *  its trajectories, so several arms can move in one process, and a motion
+ *  abandoned halfway is dropped by start_motion() or cancel_motion()
+ *  instead of resuming on the next call.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_TRAJECTORY_H_
+#define CRTK_TRAJECTORY_H_
+
+#include <array>
+#include <vector>
+#include <chrono>
+
+class CRTK_trajectory{
+public:
+  CRTK_trajectory():active(false),loop_count(0),duration_loops(0){};
+  ~CRTK_trajectory(){};
+
+  void start(float loops){ active = true; loop_count = 0; duration_loops = loops; }
+  int step(){ return ++loop_count; }
+  void cancel(){ active = false; loop_count = 0; duration_loops = 0; }
+
+  bool is_active() const { return active; }
+  bool is_done() const { return active && loop_count > duration_loops; }
+  int get_loop_count() const { return loop_count; }
+  float get_duration_loops() const { return duration_loops; }
+  float get_progress() const;
+  float trapezoid_scale() const;
+  static float trapezoid_scale(int loop_count, float duration_loops);
+
+protected:
+  bool active;
+  int loop_count;
+  float duration_loops;
+};
+
+
+/**
+ * @brief      Gets how far along the motion is
+ *
+ * @return     0 at start to 1 at the end (0 when idle)
+ */
+inline float CRTK_trajectory::get_progress() const{
+  if(!active || duration_loops <= 0)
+    return 0;
+  return loop_count >= duration_loops ? 1 : loop_count / duration_loops;
+}
+
+
+/**
+ * @brief      Speed scale of the current tick
+ *
+ * @return     scale in [0,1]
+ */
+inline float CRTK_trajectory::trapezoid_scale() const{
+  return trapezoid_scale(loop_count, duration_loops);
+}
+
+
+/**
+ * @brief      Speed scale of a trapezoid profile: ramp up over the first
+ *             quarter, cruise, ramp down over the last quarter
+ *
+ * @param[in]  loop_count      The tick
+ * @param[in]  duration_loops  The length of the motion in ticks
+ *
+ * @return     scale in [0,1]
+ */
+inline float CRTK_trajectory::trapezoid_scale(int loop_count, float duration_loops){
+  float ramp_loops = 1.0*duration_loops/4;
+
+  if(loop_count<ramp_loops)
+    return loop_count/ramp_loops;
+  else if(loop_count>3*ramp_loops)
+    return 1-(loop_count-3.0*ramp_loops)/ramp_loops;
+  return 1.0;
+}
+
+
+/**
+ * Joint space trajectory, planned whole when the motion starts. Positions
+ * and per-tick increments are stored structure-of-arrays, one contiguous
+ * run of ticks per joint, and computed from the start position in double,
+ * so nothing accumulates in the loop: each tick only copies its entries.
+ */
+template <int Capacity, typename Scalar>
+class CRTK_joint_trajectory_t : public CRTK_trajectory{
+public:
+  typedef std::array<Scalar, Capacity> joint_array;
+
+  CRTK_joint_trajectory_t():ticks(0),joints(0),plan_time(0){};
+
+  void plan_move(float loops, const joint_array &start_jpos, const joint_array &displacement, int n);
+  void plan_steps(float loops, const joint_array &start_jpos, const joint_array &peak_step, int n);
+
+  int get_ticks() const { return ticks; }
+  double get_plan_time() const { return plan_time; }
+  void get_jp(int tick, Scalar *out) const;
+  void get_jr(int tick, Scalar *out) const;
+
+private:
+  double build_profile(float loops, int n);
+  void fill(const joint_array &start_jpos, const joint_array &peak_step);
+
+  int ticks;
+  int joints;
+  double plan_time;
+  std::vector<double> profile;  // trapezoid scale summed up to each tick
+  std::vector<Scalar> plan_jp;  // plan_jp[joint*ticks + tick]
+  std::vector<Scalar> plan_jr;
+};
+
+
+/**
+ * @brief      Plans a move that ends exactly at start_jpos + displacement
+ *
+ * @param[in]  loops         The length of the motion in ticks
+ * @param[in]  start_jpos    The start jpos
+ * @param[in]  displacement  The distance each joint moves
+ * @param[in]  n             The number of joints
+ */
+template <int Capacity, typename Scalar>
+void CRTK_joint_trajectory_t<Capacity,Scalar>::plan_move(float loops, const joint_array &start_jpos,
+  const joint_array &displacement, int n){
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+  double total = build_profile(loops, n);
+  joint_array peak_step;
+  for(int i=0;i<n;i++)
+    peak_step[i] = total > 0 ? displacement[i] / total : 0;
+  fill(start_jpos, peak_step);
+
+  plan_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+
+/**
+ * @brief      Plans a move with a given full-speed step per tick
+ *
+ * @param[in]  loops       The length of the motion in ticks
+ * @param[in]  start_jpos  The start jpos
+ * @param[in]  peak_step   The per-tick step of each joint at full speed
+ * @param[in]  n           The number of joints
+ */
+template <int Capacity, typename Scalar>
+void CRTK_joint_trajectory_t<Capacity,Scalar>::plan_steps(float loops, const joint_array &start_jpos,
+  const joint_array &peak_step, int n){
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+  build_profile(loops, n);
+  fill(start_jpos, peak_step);
+
+  plan_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+
+/**
+ * @brief      Starts the trajectory and sums up the speed profile
+ *
+ * @param[in]  loops  The length of the motion in ticks
+ * @param[in]  n      The number of joints
+ *
+ * @return     The sum of the scale over all ticks
+ */
+template <int Capacity, typename Scalar>
+double CRTK_joint_trajectory_t<Capacity,Scalar>::build_profile(float loops, int n){
+  CRTK_trajectory::start(loops);
+  ticks = loops >= 0 ? (int)loops + 1 : 0;
+  joints = n < Capacity ? n : Capacity;
+
+  profile.resize(ticks);
+  double sum = 0;
+  for(int k=0;k<ticks;k++){
+    sum += trapezoid_scale(k, loops);
+    profile[k] = sum;
+  }
+  return sum;
+}
+
+
+/**
+ * @brief      Fills the position and increment buffers from the profile
+ *
+ * @param[in]  start_jpos  The start jpos
+ * @param[in]  peak_step   The per-tick step of each joint at full speed
+ */
+template <int Capacity, typename Scalar>
+void CRTK_joint_trajectory_t<Capacity,Scalar>::fill(const joint_array &start_jpos, const joint_array &peak_step){
+  plan_jp.resize(joints * ticks);
+  plan_jr.resize(joints * ticks);
+
+  for(int i=0;i<joints;i++){
+    Scalar *jp = plan_jp.data() + i*ticks;
+    Scalar *jr = plan_jr.data() + i*ticks;
+    double prev = 0;
+    for(int k=0;k<ticks;k++){
+      double pos = (double)peak_step[i] * profile[k];
+      jp[k] = start_jpos[i] + pos;
+      jr[k] = pos - prev;
+      prev = pos;
+    }
+  }
+}
+
+
+/**
+ * @brief      Gets the planned servo_jp command of a tick
+ *
+ * @param[in]  tick  The tick
+ * @param      out   The jpos of every planned joint
+ */
+template <int Capacity, typename Scalar>
+void CRTK_joint_trajectory_t<Capacity,Scalar>::get_jp(int tick, Scalar *out) const{
+  for(int i=0;i<joints;i++)
+    out[i] = plan_jp[i*ticks + tick];
+}
+
+
+/**
+ * @brief      Gets the planned servo_jr command of a tick
+ *
+ * @param[in]  tick  The tick
+ * @param      out   The increment of every planned joint
+ */
+template <int Capacity, typename Scalar>
+void CRTK_joint_trajectory_t<Capacity,Scalar>::get_jr(int tick, Scalar *out) const{
+  for(int i=0;i<joints;i++)
+    out[i] = plan_jr[i*ticks + tick];
+}
+
+#endif
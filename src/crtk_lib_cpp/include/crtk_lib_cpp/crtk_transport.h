@@ -0,0 +1,53 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * crtk_transport.h
+ *
+ * \brief Per-topic transport hints for the topics the library subscribes
+ *  to, chosen by rosparam on the node handle the robot is built with:
+ *  transport sets the default for every topic and transport_<topic>
+ *  (e.g. transport_measured_js) overrides it for one topic.
+ *
+ *  Each value lists transports in order of preference, separated by spaces
+ *  or commas: tcp, tcp_nodelay, udp (same as unreliable). For instance
+ *  "udp tcp_nodelay" uses UDP when the publisher offers it and falls back
+ *  to TCP without Nagle buffering. The default is tcp_nodelay.
+ *
+ *  Hints only exist on the subscriber side in ROS, so the servo_* topics
+ *  take the hints of the robot driver that subscribes to them.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_TRANSPORT_H_
+#define CRTK_TRANSPORT_H_
+
+#include <ros/ros.h>
+#include <string>
+
+class CRTK_transport{
+public:
+  static ros::TransportHints hints(const ros::NodeHandle&, const std::string& topic);
+  static ros::TransportHints parse(const std::string& spec, bool *ok = NULL);
+};
+
+#endif
@@ -48,9 +48,14 @@
 
 enum CRTK_axis {CRTK_X, CRTK_Y, CRTK_Z};
 enum CRTK_input {CRTK_servo, CRTK_interp, CRTK_move, CRTK_out};
+enum CRTK_move_status {CRTK_MOVE_IDLE, CRTK_MOVE_ACTIVE, CRTK_MOVE_DONE, CRTK_MOVE_FAILED, CRTK_MOVE_CANCELED};
 enum CRTK_robot_command {CRTK_ENABLE, CRTK_DISABLE, CRTK_PAUSE, CRTK_RESUME, CRTK_UNHOME, CRTK_HOME};
 enum CRTK_robot_state_enum {CRTK_ENABLED, CRTK_DISABLED, CRTK_PAUSED, CRTK_FAULT};
 
+// servo command channels, in publish priority order (arm group, then grasper group)
+enum CRTK_servo_channel {CRTK_SERVO_CR, CRTK_SERVO_CP, CRTK_SERVO_CV, CRTK_SERVO_JR, CRTK_SERVO_JP, CRTK_SERVO_JV,
+  CRTK_SERVO_JR_GRASP, CRTK_SERVO_JP_GRASP, CRTK_SERVO_JV_GRASP, CRTK_SERVO_NUM};
+
 
 
 #endif
@@ -0,0 +1,51 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_clock.cpp
+ *
+ * \brief Class file for the CRTK motion clock
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include "crtk_clock.h"
+#include <chrono>
+
+
+/**
+ * @brief      Gets the current motion time. Reads std::chrono::steady_clock,
+ *             so it never jumps with wall clock changes, unless ROS runs on
+ *             sim time, where it returns ros::Time::now(). Only differences
+ *             of these times are meaningful.
+ *
+ * @return     The current time.
+ */
+ros::Time CRTK_clock::now(){
+  if(ros::Time::isSimTime())
+    return ros::Time::now();
+
+  ros::Time out;
+  out.fromNSec(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+  return out;
+}
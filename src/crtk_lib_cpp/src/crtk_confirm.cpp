@@ -0,0 +1,551 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * crtk_confirm.cpp
+ *
+ * \brief Class file for the CRTK operator confirmations
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include "crtk_confirm.h"
+#include "crtk_robot.h"
+#include "crtk_clock.h"
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <iostream>
+#include <cmath>
+
+namespace {
+
+struct confirm_state{
+  confirm_state():initialized(0),automatic(0),settle(0.5),timeout(10),
+    jvel_tol(0.01),vel_tol(0.001),tol(0.25),dist_tol(0.002),angle_tol(0.035),
+    checking(0),watching(0){};
+
+  bool initialized;
+  bool automatic;
+  double settle;        // s the arm has to be still before answering
+  double timeout;       // s before answering no
+  double jvel_tol;      // rad/s (or m/s for prismatic joints)
+  double vel_tol;       // m/s of the measured_cp origin
+  double tol;           // allowed error, as a fraction of the expected motion
+  double dist_tol;      // m allowed where no motion is expected
+  double angle_tol;     // rad allowed where no motion is expected
+
+  std::mutex mtx;
+  std::deque<std::string> lines;
+  ros::Subscriber sub;
+
+  bool checking;
+  ros::Time check_start;
+  ros::Time still_since;
+  ros::Time last_time;
+  CRTK_motion::snapshot last;
+
+  // watch(): largest excursion from the first watched pose, per axis
+  bool watching;
+  tf::Transform watch_start;
+  tf::Vector3 peak_pos;
+  tf::Vector3 peak_rot;
+};
+
+confirm_state &state(){
+  static confirm_state s;
+  return s;
+}
+
+void read_stdin(){
+  std::string line;
+  while(std::getline(std::cin, line))
+    CRTK_confirm::push(line);
+}
+
+// rotation vector (axis times angle, in the base frame) from a to b
+tf::Vector3 rotation_between(const tf::Quaternion& a, const tf::Quaternion& b){
+  tf::Quaternion d = (b * a.inverse()).normalized();
+  if(d.w() < 0)
+    d = -d;
+  double angle = d.getAngle();
+  if(angle < 1e-9)
+    return tf::Vector3(0,0,0);
+  return d.getAxis() * angle;
+}
+
+// allowed error: a fraction of what was expected, or the floor if nothing was
+double allowed(double expected, double floor){
+  return expected > 0 ? state().tol * expected : floor;
+}
+
+}
+
+
+
+/**
+ * @brief      Reads the confirm, confirm_settle, confirm_timeout,
+ *             confirm_jvel, confirm_vel, confirm_tol, confirm_dist and
+ *             confirm_angle parameters and starts listening for answers.
+ *             Called on the first prompt with the private node handle if the
+ *             node did not call it.
+ *
+ * @param[in]  n     ros node handle, the confirm topic is advertised under it
+ */
+void CRTK_confirm::init(const ros::NodeHandle& n){
+  confirm_state &s = state();
+  if(s.initialized)
+    return;
+  s.initialized = 1;
+
+  std::string mode = "interactive";
+  n.getParam("confirm", mode);
+  n.getParam("confirm_settle", s.settle);
+  n.getParam("confirm_timeout", s.timeout);
+  n.getParam("confirm_jvel", s.jvel_tol);
+  n.getParam("confirm_vel", s.vel_tol);
+  n.getParam("confirm_tol", s.tol);
+  n.getParam("confirm_dist", s.dist_tol);
+  n.getParam("confirm_angle", s.angle_tol);
+
+  // auto mode still takes answers to the prompts it cannot measure
+  ros::NodeHandle nh(n);
+  s.sub = nh.subscribe("confirm", 10, &CRTK_confirm::confirm_cb);
+
+  if(mode == "auto"){
+    s.automatic = 1;
+    ROS_INFO("Confirmations are automatic (settle %.2f s, timeout %.1f s, tolerance %.0f%%).",
+      s.settle, s.timeout, 100*s.tol);
+    return;
+  }
+  if(mode != "interactive")
+    ROS_ERROR("Unknown confirm mode \"%s\" (use interactive or auto).", mode.c_str());
+
+  std::thread(read_stdin).detach();
+}
+
+
+
+/**
+ * @brief      Whether prompts are answered automatically.
+ *
+ * @return     true in auto mode
+ */
+bool CRTK_confirm::is_auto(){
+  init(ros::NodeHandle("~"));
+  return state().automatic;
+}
+
+
+
+/**
+ * @brief      Checks for a "press Enter" answer. Non-empty lines are
+ *             ignored, like the old prompts did.
+ *
+ * @return     1 if confirmed, 0 if there is no answer yet
+ */
+int CRTK_confirm::enter(){
+  if(is_auto())
+    return 1;
+
+  std::string line;
+  if(!pop(&line))
+    return 0;
+  return line == "" ? 1 : 0;
+}
+
+
+
+/**
+ * @brief      Checks for a Y/N answer to a prompt auto mode cannot measure.
+ *             In auto mode it waits for an answer on the confirm topic and
+ *             answers no after confirm_timeout.
+ *
+ * @return     1 for yes, -1 for no, 0 if there is no answer yet
+ */
+int CRTK_confirm::yes_no(){
+  confirm_state &s = state();
+  int out = typed();
+  if(!is_auto() || out)
+    return out;
+
+  ros::Time now = CRTK_clock::now();
+  if(!s.checking){
+    s.checking    = 1;
+    s.check_start = now;
+    ROS_INFO("Nothing to measure for this prompt, waiting for an answer on the confirm topic.");
+    return 0;
+  }
+  if((now - s.check_start).toSec() >= s.timeout){
+    s.checking = 0;
+    ROS_WARN("No answer after %.1f s, answering N.", s.timeout);
+    return -1;
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief      Checks for a Y/N answer to "did the joint move?". In auto
+ *             mode the answer is whether the joint has moved about
+ *             displacement (either way) since start_motion.
+ *
+ * @param      robot         The robot
+ * @param[in]  joint         The joint index
+ * @param[in]  displacement  The expected displacement (rad, or m for a
+ *                           prismatic joint)
+ *
+ * @return     1 for yes, -1 for no, 0 if there is no answer yet
+ */
+int CRTK_confirm::yes_no(CRTK_robot *robot, int joint, float displacement){
+  if(!is_auto())
+    return typed();
+
+  int settled = settle(robot);
+  if(settled <= 0)
+    return settled;
+
+  if(joint < 0 || joint >= robot->arm.get_num_joints()){
+    ROS_ERROR("Cannot check joint %d, answering N.", joint);
+    return -1;
+  }
+
+  float start[MAX_JOINTS];
+  robot->arm.get_start_jpos(start, MAX_JOINTS);
+  double moved = std::fabs(state().last.js_pos[joint] - start[joint]);
+  double expected = std::fabs(displacement);
+  double floor = robot->arm.is_prismatic(joint) ? state().dist_tol : state().angle_tol;
+
+  char what[32];
+  snprintf(what, sizeof(what), "joint %d", joint);
+  return verdict(std::fabs(moved - expected) <= allowed(expected, floor), what, moved, expected);
+}
+
+
+
+/**
+ * @brief      Checks for a Y/N answer to "did the arm get there?". In auto
+ *             mode the answer is whether every joint ended up at jpos, within
+ *             confirm_angle (or confirm_dist for prismatic joints).
+ *
+ * @param      robot  The robot
+ * @param[in]  jpos   The expected joint positions, one per joint
+ *
+ * @return     1 for yes, -1 for no, 0 if there is no answer yet
+ */
+int CRTK_confirm::yes_no(CRTK_robot *robot, const float *jpos){
+  if(!is_auto())
+    return typed();
+
+  int settled = settle(robot);
+  if(settled <= 0)
+    return settled;
+
+  const confirm_state &s = state();
+  int worst = 0;
+  double worst_excess = -1e9;
+  bool ok = 1;
+  for(int i=0; i<robot->arm.get_num_joints(); i++){
+    double floor = robot->arm.is_prismatic(i) ? s.dist_tol : s.angle_tol;
+    double excess = std::fabs(s.last.js_pos[i] - jpos[i]) - floor;
+    if(excess > 0)
+      ok = 0;
+    if(excess > worst_excess){
+      worst_excess = excess;
+      worst = i;
+    }
+  }
+
+  char what[32];
+  snprintf(what, sizeof(what), "joint %d", worst);
+  return verdict(ok, what, s.last.js_pos[worst], jpos[worst]);
+}
+
+
+
+/**
+ * @brief      Checks for a Y/N answer to "did the arm move that way?". In
+ *             auto mode the answer is whether the measured_cp origin moved by
+ *             displacement (in the base frame) from start.
+ *
+ * @param      robot         The robot
+ * @param[in]  start         The pose the motion started from, e.g.
+ *                           arm.get_start_tf()
+ * @param[in]  displacement  The expected translation (m)
+ *
+ * @return     1 for yes, -1 for no, 0 if there is no answer yet
+ */
+int CRTK_confirm::yes_no(CRTK_robot *robot, const tf::Transform& start, const tf::Vector3& displacement){
+  if(!is_auto())
+    return typed();
+
+  int settled = settle(robot);
+  if(settled <= 0)
+    return settled;
+
+  tf::Vector3 moved = state().last.cp.getOrigin() - start.getOrigin();
+  double expected = displacement.length();
+  double error = (moved - displacement).length();
+  return verdict(error <= allowed(expected, state().dist_tol), "tool tip", moved.length(), expected);
+}
+
+
+
+/**
+ * @brief      Checks for a Y/N answer to "did the arm rotate?". In auto
+ *             mode the answer is whether the measured_cp orientation turned
+ *             by about angle from start, about any axis.
+ *
+ * @param      robot  The robot
+ * @param[in]  start  The pose the motion started from, e.g.
+ *                    arm.get_start_tf()
+ * @param[in]  angle  The expected rotation (rad)
+ *
+ * @return     1 for yes, -1 for no, 0 if there is no answer yet
+ */
+int CRTK_confirm::yes_no(CRTK_robot *robot, const tf::Transform& start, float angle){
+  if(!is_auto())
+    return typed();
+
+  int settled = settle(robot);
+  if(settled <= 0)
+    return settled;
+
+  double turned = rotation_between(start.getRotation(), state().last.cp.getRotation()).length();
+  double expected = std::fabs(angle);
+  return verdict(std::fabs(turned - expected) <= allowed(expected, state().angle_tol), "tool orientation", turned, expected);
+}
+
+
+
+/**
+ * @brief      Tracks how far the arm gets from where it was on the first
+ *             call, for motions that end where they started. Call it every
+ *             tick of the motion; yes_no_peak() checks the result. Does
+ *             nothing unless prompts are automatic.
+ *
+ * @param      robot  The robot
+ */
+void CRTK_confirm::watch(CRTK_robot *robot){
+  if(!is_auto())
+    return;
+
+  confirm_state &s = state();
+  tf::Transform cp = robot->arm.get_measured_cp();
+  if(!s.watching){
+    s.watching    = 1;
+    s.watch_start = cp;
+    s.peak_pos    = tf::Vector3(0,0,0);
+    s.peak_rot    = tf::Vector3(0,0,0);
+    return;
+  }
+
+  s.peak_pos.setMax((cp.getOrigin() - s.watch_start.getOrigin()).absolute());
+  s.peak_rot.setMax(rotation_between(s.watch_start.getRotation(), cp.getRotation()).absolute());
+}
+
+
+
+/**
+ * @brief      Checks for a Y/N answer to a motion that returns to its start,
+ *             like tracing a cube. In auto mode the answer is whether the
+ *             largest excursion along and about each base axis since the
+ *             first watch() matches.
+ *
+ * @param      robot        The robot
+ * @param[in]  translation  The expected largest excursion along x, y, z (m)
+ * @param[in]  rotation     The expected largest rotation about x, y, z (rad)
+ *
+ * @return     1 for yes, -1 for no, 0 if there is no answer yet
+ */
+int CRTK_confirm::yes_no_peak(CRTK_robot *robot, const tf::Vector3& translation, const tf::Vector3& rotation){
+  if(!is_auto())
+    return typed();
+
+  watch(robot);
+  int settled = settle(robot);
+  if(settled <= 0){
+    if(settled < 0)
+      state().watching = 0;
+    return settled;
+  }
+
+  confirm_state &s = state();
+  s.watching = 0;
+
+  static const char *axes[] = {"x", "y", "z"};
+  double pos_tol = allowed(translation.absolute().length(), s.dist_tol);
+  double rot_tol = allowed(rotation.absolute().length(), s.angle_tol);
+  char what[32];
+  for(int i=0; i<3; i++){
+    if(std::fabs(s.peak_pos[i] - std::fabs(translation[i])) > pos_tol){
+      snprintf(what, sizeof(what), "tool tip along %s", axes[i]);
+      return verdict(0, what, s.peak_pos[i], std::fabs(translation[i]));
+    }
+    if(std::fabs(s.peak_rot[i] - std::fabs(rotation[i])) > rot_tol){
+      snprintf(what, sizeof(what), "tool orientation about %s", axes[i]);
+      return verdict(0, what, s.peak_rot[i], std::fabs(rotation[i]));
+    }
+  }
+  return verdict(1, "tool", s.peak_pos.length() + s.peak_rot.length(),
+    translation.absolute().length() + rotation.absolute().length());
+}
+
+
+
+/**
+ * @brief      Takes a typed Y/N answer
+ *
+ * @return     1 for yes, -1 for no, 0 if there is no answer yet
+ */
+int CRTK_confirm::typed(){
+  std::string line;
+  if(!pop(&line))
+    return 0;
+  if(line == "Y" || line == "y")
+    return 1;
+  if(line == "N" || line == "n")
+    return -1;
+  ROS_INFO("Please answer Y or N.");
+  return 0;
+}
+
+
+
+/**
+ * @brief      Waits for the arm to come to rest. The last still sample is
+ *             left in the state for the caller to check.
+ *
+ * @param      robot  The robot
+ *
+ * @return     1 once settled, -1 if still moving after confirm_timeout, 0
+ *             to keep waiting
+ */
+int CRTK_confirm::settle(CRTK_robot *robot){
+  confirm_state &s = state();
+  ros::Time now = CRTK_clock::now();
+  CRTK_motion::snapshot snap = robot->arm.get_measured_snapshot();
+
+  if(!s.checking){
+    s.checking    = 1;
+    s.check_start = now;
+    s.still_since = now;
+    s.last_time   = now;
+    s.last        = snap;
+    return 0;
+  }
+
+  double dt = (now - s.last_time).toSec();
+  if(dt <= 0)
+    return 0;
+
+  bool moving = 0;
+  int num_joints = robot->arm.get_num_joints();
+  for(int i=0; i<num_joints; i++){
+    if(std::fabs(snap.js_pos[i] - s.last.js_pos[i]) > s.jvel_tol * dt)
+      moving = 1;
+  }
+  if(snap.cp.getOrigin().distance(s.last.cp.getOrigin()) > s.vel_tol * dt)
+    moving = 1;
+
+  if(moving)
+    s.still_since = now;
+  s.last_time = now;
+  s.last      = snap;
+
+  if((now - s.still_since).toSec() >= s.settle){
+    s.checking = 0;
+    return 1;
+  }
+  if((now - s.check_start).toSec() >= s.timeout){
+    s.checking = 0;
+    ROS_WARN("Arm still moving after %.1f s, answering N.", s.timeout);
+    return -1;
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief      Logs and returns an automatic answer
+ *
+ * @param[in]  ok        Whether the motion matched
+ * @param[in]  what      What was measured
+ * @param[in]  measured  The measured motion
+ * @param[in]  expected  The expected motion
+ *
+ * @return     1 for yes, -1 for no
+ */
+int CRTK_confirm::verdict(bool ok, const char *what, double measured, double expected){
+  if(ok)
+    ROS_INFO("Arm settled, %s at %.4f (expected %.4f), answering Y.", what, measured, expected);
+  else
+    ROS_WARN("Arm settled, %s at %.4f (expected %.4f), answering N.", what, measured, expected);
+  return ok ? 1 : -1;
+}
+
+
+
+/**
+ * @brief      Queues an answer, as if it was typed in.
+ *
+ * @param[in]  line  The answer
+ */
+void CRTK_confirm::push(const std::string& line){
+  confirm_state &s = state();
+  std::lock_guard<std::mutex> lock(s.mtx);
+  s.lines.push_back(line);
+}
+
+
+
+/**
+ * @brief      Queues answers published on the confirm topic
+ *
+ * @param[in]  msg   The message from ROS
+ */
+void CRTK_confirm::confirm_cb(const std_msgs::String::ConstPtr& msg){
+  push(msg->data);
+}
+
+
+
+/**
+ * @brief      Takes the oldest queued answer
+ *
+ * @param      line  The answer
+ *
+ * @return     false if there is none
+ */
+bool CRTK_confirm::pop(std::string *line){
+  confirm_state &s = state();
+  std::lock_guard<std::mutex> lock(s.mtx);
+  if(s.lines.empty())
+    return 0;
+  *line = s.lines.front();
+  s.lines.pop_front();
+  return 1;
+}
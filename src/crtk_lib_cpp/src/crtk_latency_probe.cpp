@@ -0,0 +1,125 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford,
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_latency_probe.cpp
+ *
+ * \brief Nodelet that listens to a robot's servo_* topics and reports the
+ *  transport latency (receive time - header stamp) of each one. Run it with
+ *  "nodelet standalone" to measure the node (TCP) path, or load it into the
+ *  app's manager to measure the intra-process path.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include <nodelet/nodelet.h>
+#include <pluginlib/class_list_macros.h>
+#include <geometry_msgs/TransformStamped.h>
+#include <sensor_msgs/JointState.h>
+#include <ros/ros.h>
+
+#define REPORT_COUNT 5000   // messages per topic between reports
+
+class CRTK_latency_probe : public nodelet::Nodelet{
+  public:
+    CRTK_latency_probe(){};
+    ~CRTK_latency_probe(){};
+
+  private:
+    struct latency_stat{
+      std::string topic;
+      int count;
+      double sum;
+      double max;
+      ros::Subscriber sub;
+    };
+
+    enum {PROBE_CR, PROBE_CP, PROBE_CV, PROBE_JR, PROBE_JP, PROBE_JV, PROBE_NUM};
+    latency_stat stats[PROBE_NUM];
+
+    virtual void onInit();
+    void add_sample(int, const ros::Time&);
+    void cp_cb(const geometry_msgs::TransformStamped::ConstPtr&);
+    void cr_cb(const geometry_msgs::TransformStamped::ConstPtr&);
+    void cv_cb(const geometry_msgs::TransformStamped::ConstPtr&);
+    void jr_cb(const sensor_msgs::JointState::ConstPtr&);
+    void jp_cb(const sensor_msgs::JointState::ConstPtr&);
+    void jv_cb(const sensor_msgs::JointState::ConstPtr&);
+};
+
+
+/**
+ * @brief      Subscribes to the servo topics of the r_space robot
+ */
+void CRTK_latency_probe::onInit(){
+  ros::NodeHandle &n = getPrivateNodeHandle();
+
+  std::string r_space;
+  if(!n.getParam("r_space", r_space))
+    NODELET_ERROR("No Robot namespace provided in nodelet parameters!");
+
+  const char *names[PROBE_NUM] = {"servo_cr", "servo_cp", "servo_cv", "servo_jr", "servo_jp", "servo_jv"};
+  for(int i=0;i<PROBE_NUM;i++){
+    stats[i].topic = "/" + r_space + "/" + names[i];
+    stats[i].count = 0;
+    stats[i].sum = 0;
+    stats[i].max = 0;
+  }
+
+  stats[PROBE_CR].sub = n.subscribe(stats[PROBE_CR].topic, 10, &CRTK_latency_probe::cr_cb, this);
+  stats[PROBE_CP].sub = n.subscribe(stats[PROBE_CP].topic, 10, &CRTK_latency_probe::cp_cb, this);
+  stats[PROBE_CV].sub = n.subscribe(stats[PROBE_CV].topic, 10, &CRTK_latency_probe::cv_cb, this);
+  stats[PROBE_JR].sub = n.subscribe(stats[PROBE_JR].topic, 10, &CRTK_latency_probe::jr_cb, this);
+  stats[PROBE_JP].sub = n.subscribe(stats[PROBE_JP].topic, 10, &CRTK_latency_probe::jp_cb, this);
+  stats[PROBE_JV].sub = n.subscribe(stats[PROBE_JV].topic, 10, &CRTK_latency_probe::jv_cb, this);
+}
+
+
+/**
+ * @brief      Accumulates one latency sample and reports every REPORT_COUNT samples
+ *
+ * @param[in]  index  The probe index
+ * @param[in]  stamp  The message header stamp
+ */
+void CRTK_latency_probe::add_sample(int index, const ros::Time &stamp){
+  latency_stat &s = stats[index];
+  double latency = (ros::Time::now() - stamp).toSec();
+
+  s.count++;
+  s.sum += latency;
+  if(latency > s.max) s.max = latency;
+
+  if(s.count >= REPORT_COUNT){
+    NODELET_INFO("%s latency over %d msgs: mean %.1f us, max %.1f us",
+      s.topic.c_str(), s.count, 1e6*s.sum/s.count, 1e6*s.max);
+    s.count = 0;
+    s.sum = 0;
+    s.max = 0;
+  }
+}
+
+void CRTK_latency_probe::cr_cb(const geometry_msgs::TransformStamped::ConstPtr& msg){ add_sample(PROBE_CR, msg->header.stamp); }
+void CRTK_latency_probe::cp_cb(const geometry_msgs::TransformStamped::ConstPtr& msg){ add_sample(PROBE_CP, msg->header.stamp); }
+void CRTK_latency_probe::cv_cb(const geometry_msgs::TransformStamped::ConstPtr& msg){ add_sample(PROBE_CV, msg->header.stamp); }
+void CRTK_latency_probe::jr_cb(const sensor_msgs::JointState::ConstPtr& msg){ add_sample(PROBE_JR, msg->header.stamp); }
+void CRTK_latency_probe::jp_cb(const sensor_msgs::JointState::ConstPtr& msg){ add_sample(PROBE_JP, msg->header.stamp); }
+void CRTK_latency_probe::jv_cb(const sensor_msgs::JointState::ConstPtr& msg){ add_sample(PROBE_JV, msg->header.stamp); }
+
+PLUGINLIB_EXPORT_CLASS(CRTK_latency_probe, nodelet::Nodelet)
@@ -0,0 +1,367 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * crtk_recorder.cpp
+ *
+ * \brief Class file for the CRTK stream recorder
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include "crtk_recorder.h"
+#include "crtk_clock.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// records per mapped window: 24 MiB, a whole number of pages
+#define WINDOW_RECORDS 65536
+#define WINDOW_BYTES ((off_t)WINDOW_RECORDS * (off_t)sizeof(CRTK_record))
+
+static_assert(sizeof(CRTK_record) == 384, "CRTK_record layout changed, bump CRTK_RECORD_VERSION");
+static_assert(sizeof(CRTK_record_file_header) <= sizeof(CRTK_record), "file header must fit in one record");
+
+
+CRTK_recorder::CRTK_recorder():ring(NULL),ring_size(0),head(0),tail(0),dropped(0),written(0),
+  running(false),fd(-1),window(NULL),window_index(0),file_records(0){
+}
+
+
+CRTK_recorder::~CRTK_recorder(){
+  close();
+}
+
+
+/**
+ * @brief      Creates the file and starts recording. Call before the
+ *             callbacks and the control loop start.
+ *
+ * @param[in]  path        The file path, truncated if it exists
+ * @param[in]  robot_name  The robot name, stored in the file header
+ * @param[in]  num_joints  The number of joints, stored in the file header
+ * @param[in]  slots       The ring size in records, rounded up to a power of two
+ *
+ * @return     success 0, fail -1
+ */
+char CRTK_recorder::open(const std::string& path, const std::string& robot_name, int num_joints, int slots){
+  close();
+
+  fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if(fd < 0){
+    ROS_ERROR("Cannot open record file %s: %s", path.c_str(), strerror(errno));
+    return -1;
+  }
+  window = NULL;
+  if(map_window(0) < 0){
+    ::close(fd);
+    fd = -1;
+    return -1;
+  }
+
+  CRTK_record_file_header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CRTK_RECORD_MAGIC, sizeof(CRTK_RECORD_MAGIC));
+  header.version = CRTK_RECORD_VERSION;
+  header.record_size = sizeof(CRTK_record);
+  header.num_joints = num_joints;
+  header.start_wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+  header.start_t_ns = CRTK_clock::now().toNSec();
+  strncpy(header.robot_name, robot_name.c_str(), sizeof(header.robot_name) - 1);
+  memset(&window[0], 0, sizeof(CRTK_record));
+  memcpy(&window[0], &header, sizeof(header));
+  file_records = 1;
+
+  for(ring_size = 1; ring_size < (uint64_t)std::max(slots, 2); ring_size <<= 1);
+  ring = new slot[ring_size];
+  for(uint64_t i=0;i<ring_size;i++)
+    ring[i].seq.store(i, std::memory_order_relaxed);
+  head = 0;
+  tail = 0;
+  dropped = 0;
+  written = 0;
+
+  running = true;
+  flusher = std::thread(&CRTK_recorder::flush_loop, this);
+  ROS_INFO("Recording %s to %s (%lu record buffer).", robot_name.c_str(), path.c_str(), (unsigned long)ring_size);
+  return 0;
+}
+
+
+/**
+ * @brief      Flushes what is left and closes the file. Call once the
+ *             callbacks and the control loop have stopped.
+ */
+void CRTK_recorder::close(){
+  if(fd < 0)
+    return;
+
+  running = false;
+  if(flusher.joinable())
+    flusher.join();
+
+  munmap(window, WINDOW_BYTES);
+  window = NULL;
+  if(ftruncate(fd, (off_t)file_records * (off_t)sizeof(CRTK_record)) != 0)
+    ROS_ERROR("Cannot trim record file: %s", strerror(errno));
+  ::close(fd);
+  fd = -1;
+
+  delete[] ring;
+  ring = NULL;
+  ROS_INFO("Recorder closed: %lu records written, %lu dropped.", written.load(), dropped.load());
+}
+
+
+/**
+ * @brief      Checks if the recorder is recording
+ */
+bool CRTK_recorder::is_open() const{
+  return running.load(std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief      Claims the next ring slot and fills the record header.
+ *             Never blocks: if the flush thread is behind, the record is
+ *             dropped.
+ *
+ * @return     the slot, NULL if not recording or the ring is full
+ */
+CRTK_recorder::slot* CRTK_recorder::claim(CRTK_record_type type, const ros::Time& stamp, int count){
+  if(!running.load(std::memory_order_relaxed))
+    return NULL;
+
+  uint64_t pos = head.load(std::memory_order_relaxed);
+  slot *s;
+  for(;;){
+    s = &ring[pos & (ring_size - 1)];
+    int64_t diff = (int64_t)(s->seq.load(std::memory_order_acquire) - pos);
+    if(diff == 0){
+      if(head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if(diff < 0){
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return NULL;
+    }
+    else
+      pos = head.load(std::memory_order_relaxed);
+  }
+
+  s->pos = pos;
+  s->rec.t_ns = CRTK_clock::now().toNSec();
+  s->rec.stamp_ns = stamp.isZero() ? 0 : stamp.toNSec();
+  s->rec.dropped = dropped.load(std::memory_order_relaxed);
+  s->rec.type = type;
+  s->rec.count = count;
+  return s;
+}
+
+
+/**
+ * @brief      Hands a filled slot to the flush thread
+ */
+void CRTK_recorder::commit(slot *s){
+  s->seq.store(s->pos + 1, std::memory_order_release);
+}
+
+
+/**
+ * @brief      Records a sample of count values
+ *
+ * @param[in]  type    The record type
+ * @param[in]  stamp   The message stamp
+ * @param[in]  values  The values
+ * @param[in]  count   The number of values
+ */
+void CRTK_recorder::record(CRTK_record_type type, const ros::Time& stamp, const double* values, int count){
+  count = std::min(count, CRTK_RECORD_VALUES);
+  slot *s = claim(type, stamp, count);
+  if(!s)
+    return;
+  for(int i=0;i<count;i++)
+    s->rec.value[i] = values[i];
+  commit(s);
+}
+
+
+/**
+ * @brief      record for float values
+ */
+void CRTK_recorder::record(CRTK_record_type type, const ros::Time& stamp, const float* values, int count){
+  count = std::min(count, CRTK_RECORD_VALUES);
+  slot *s = claim(type, stamp, count);
+  if(!s)
+    return;
+  for(int i=0;i<count;i++)
+    s->rec.value[i] = values[i];
+  commit(s);
+}
+
+
+/**
+ * @brief      Records a pose as x y z qx qy qz qw
+ *
+ * @param[in]  type   The record type
+ * @param[in]  stamp  The message stamp
+ * @param[in]  tf     The pose
+ */
+void CRTK_recorder::record(CRTK_record_type type, const ros::Time& stamp, const tf::Transform& tf){
+  slot *s = claim(type, stamp, 7);
+  if(!s)
+    return;
+  const tf::Vector3 &p = tf.getOrigin();
+  tf::Quaternion q = tf.getRotation();
+  double *v = s->rec.value;
+  v[0] = p.x(); v[1] = p.y(); v[2] = p.z();
+  v[3] = q.x(); v[4] = q.y(); v[5] = q.z(); v[6] = q.w();
+  commit(s);
+}
+
+
+/**
+ * @brief      Records a joint state. Missing velocities or efforts are NaN.
+ *
+ * @param[in]  stamp  The message stamp
+ * @param[in]  pos    The positions
+ * @param[in]  vel    The velocities, or NULL
+ * @param[in]  eff    The efforts, or NULL
+ * @param[in]  count  The number of joints
+ */
+void CRTK_recorder::record_js(const ros::Time& stamp, const double* pos, const double* vel, const double* eff, int count){
+  count = std::min(count, (int)MAX_JOINTS);
+  slot *s = claim(CRTK_RECORD_MEASURED_JS, stamp, count);
+  if(!s)
+    return;
+  double *v = s->rec.value;
+  for(int i=0;i<count;i++){
+    v[i] = pos[i];
+    v[count + i] = vel ? vel[i] : NAN;
+    v[2*count + i] = eff ? eff[i] : NAN;
+  }
+  commit(s);
+}
+
+
+/**
+ * @brief      Gets the number of records written to the file
+ */
+unsigned long CRTK_recorder::get_written() const{
+  return written.load(std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief      Gets the number of records dropped because the ring was full
+ */
+unsigned long CRTK_recorder::get_dropped() const{
+  return dropped.load(std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief      Background thread: moves filled slots into the file. Runs at
+ *             normal priority on any CPU even if the loop that created it
+ *             was made real-time.
+ */
+void CRTK_recorder::flush_loop(){
+  struct sched_param param;
+  memset(&param, 0, sizeof(param));
+  pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  for(long i=0;i<cpus && i<CPU_SETSIZE;i++)
+    CPU_SET(i, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+
+  while(running.load()){
+    if(drain() == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  drain();
+}
+
+
+/**
+ * @brief      Copies every filled slot, in order, to the file
+ *
+ * @return     The number of records copied
+ */
+int CRTK_recorder::drain(){
+  int out = 0;
+  for(;;){
+    slot *s = &ring[tail & (ring_size - 1)];
+    if(s->seq.load(std::memory_order_acquire) != tail + 1)
+      break;
+
+    if(file_records / WINDOW_RECORDS != window_index && map_window(file_records / WINDOW_RECORDS) < 0){
+      running = false;
+      break;
+    }
+    memcpy(&window[file_records % WINDOW_RECORDS], &s->rec, sizeof(CRTK_record));
+    file_records++;
+    written.fetch_add(1, std::memory_order_relaxed);
+
+    s->seq.store(tail + ring_size, std::memory_order_release);
+    tail++;
+    out++;
+  }
+  return out;
+}
+
+
+/**
+ * @brief      Grows the file and maps its window-th window
+ *
+ * @param[in]  index  The window index
+ *
+ * @return     success 0, fail -1
+ */
+char CRTK_recorder::map_window(uint64_t index){
+  if(window)
+    munmap(window, WINDOW_BYTES);
+  window = NULL;
+
+  if(ftruncate(fd, (off_t)(index + 1) * WINDOW_BYTES) != 0){
+    ROS_ERROR("Cannot grow record file: %s. Recording stopped.", strerror(errno));
+    return -1;
+  }
+  void *map = mmap(NULL, WINDOW_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, (off_t)index * WINDOW_BYTES);
+  if(map == MAP_FAILED){
+    ROS_ERROR("Cannot map record file: %s. Recording stopped.", strerror(errno));
+    return -1;
+  }
+  window = (CRTK_record*)map;
+  window_index = index;
+  return 0;
+}
@@ -31,6 +31,13 @@
  */
 
 #include "crtk_robot.h"
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <chrono>
+
+static int64_t steady_now_ns(){
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
 /**
  * @brief      Constructs the robot object.
@@ -42,8 +49,32 @@
 CRTK_robot::CRTK_robot(ros::NodeHandle n, std::string robot_ns):state(n, robot_ns){
 
   robot_name = robot_ns;
+  measured_js_rejected = 0;
+  measured_js_stamp_ns = 0;
+  measured_cp_stamp_ns = 0;
+  servo_sent = 0;
+  last_move_status = CRTK_MOVE_IDLE;
+  move_status_ticks = 0;
+  for(int i=0;i<CRTK_SERVO_NUM;i++)
+    servo_dropped[i] = 0;
   init_param(n);
+  init_recorder(n);
   init_ros(n);  
+  init_msg_pools();
+  init_diagnostics(n);
+}
+
+/**
+ * @brief      Stops every callback that records before closing the
+ *             recorder. Subscriber::shutdown() waits for a callback that is
+ *             already running.
+ */
+CRTK_robot::~CRTK_robot(){
+  state.sub.shutdown();
+  sub_measured_cp.shutdown();
+  sub_measured_js.shutdown();
+  state.set_recorder(NULL);
+  recorder.close();
 }
 
 /**
@@ -66,10 +97,12 @@ bool CRTK_robot::init_param(ros::NodeHandle n){
     ROS_INFO("Robot namespace: %s, Grasper namespace: %s",robot_name.c_str(),grasper_name.c_str());
 
 
-  double tmp_max_joints;
+  double tmp_max_joints = MAX_JOINTS;
   if(!n.getParam("/"+robot_name+"/num_joints", tmp_max_joints))
     ROS_ERROR("Cannot read num_joints from the %s's yaml file.", robot_name.c_str());
-  max_joints = (unsigned int) tmp_max_joints;
+  if(arm.set_num_joints((int)tmp_max_joints) < 0)
+    ROS_ERROR("Using %d joints for %s.", MAX_JOINTS, robot_name.c_str());
+  max_joints = arm.get_num_joints();
 
   float home_jpos[MAX_JOINTS];
   XmlRpc::XmlRpcValue tmp_home_pos;
@@ -118,9 +151,37 @@ bool CRTK_robot::init_param(ros::NodeHandle n){
     arm.set_home_pos(home_quat, home_pos);
 
   if(set_new_home_jpos)
-    arm.set_home_jpos(home_jpos, MAX_JOINTS);
+    arm.set_home_jpos(home_jpos, max_joints);
+
+  // interp_* render delay (0 follows the setpoint rate) and stall timeout (s)
+  double interp_delay = 0, interp_timeout = 0.1;
+  n.getParam("interp_delay", interp_delay);
+  n.getParam("interp_timeout", interp_timeout);
+  arm.set_interp_delay(interp_delay);
+  arm.set_interp_timeout(interp_timeout);
+
+  // optional go_to_jpos_otg limits, all three or none
+  std::vector<double> max_jvel, max_jacc, max_jjerk;
+  bool has_jvel  = n.getParam("/"+robot_name+"/max_jvel", max_jvel);
+  bool has_jacc  = n.getParam("/"+robot_name+"/max_jacc", max_jacc);
+  bool has_jjerk = n.getParam("/"+robot_name+"/max_jjerk", max_jjerk);
+  if(has_jvel || has_jacc || has_jjerk){
+    if(max_jvel.size()!=max_joints || max_jacc.size()!=max_joints || max_jjerk.size()!=max_joints)
+      ROS_ERROR("max_jvel, max_jacc and max_jjerk need %d values each. Using default joint limits.",max_joints);
+    else{
+      float vel[MAX_JOINTS], acc[MAX_JOINTS], jerk[MAX_JOINTS];
+      for(int i=0; i<max_joints;i++){
+        vel[i] = max_jvel[i];
+        acc[i] = max_jacc[i];
+        jerk[i] = max_jjerk[i];
+      }
+      if(arm.set_joint_limits(vel, acc, jerk, max_joints) < 0)
+        ROS_ERROR("Using default joint limits for %s.", robot_name.c_str());
+    }
+  }
 
   ROS_INFO("All ROS parameters loaded.");
+  return true;
 }
 
 
@@ -136,10 +197,26 @@ bool CRTK_robot::init_ros(ros::NodeHandle n){
 
   // Set Publisher and Subscribers under the namespace from from the parameter list
   topic = "/" + robot_name + "/measured_cp";
-  sub_measured_cp = n.subscribe(topic, 1, &CRTK_robot::crtk_measured_cp_arm_cb,this);
+  sub_measured_cp = n.subscribe(topic, 1, &CRTK_robot::crtk_measured_cp_arm_cb,this, CRTK_transport::hints(n, topic));
 
   topic = "/" + robot_name + "/measured_js";
-  sub_measured_js = n.subscribe(topic, 1, &CRTK_robot::crtk_measured_js_arm_cb,this);
+  sub_measured_js = n.subscribe(topic, 1, &CRTK_robot::crtk_measured_js_arm_cb,this, CRTK_transport::hints(n, topic));
+
+  // interp setpoints are buffered, so keep a few in the queue
+  topic = "/" + robot_name + "/interp_cp";
+  sub_interp_cp = n.subscribe(topic, 8, &CRTK_robot::crtk_interp_cp_arm_cb,this, CRTK_transport::hints(n, topic));
+
+  topic = "/" + robot_name + "/interp_jp";
+  sub_interp_jp = n.subscribe(topic, 8, &CRTK_robot::crtk_interp_jp_arm_cb,this, CRTK_transport::hints(n, topic));
+
+  topic = "/" + robot_name + "/move_cp";
+  sub_move_cp = n.subscribe(topic, 1, &CRTK_robot::crtk_move_cp_arm_cb,this, CRTK_transport::hints(n, topic));
+
+  topic = "/" + robot_name + "/move_jp";
+  sub_move_jp = n.subscribe(topic, 1, &CRTK_robot::crtk_move_jp_arm_cb,this, CRTK_transport::hints(n, topic));
+
+  topic = "/" + robot_name + "/move_status";
+  pub_move_status = n.advertise<crtk_msgs::StringStamped>(topic, 10);
 
   topic = "/" + robot_name + "/servo_cr";
   pub_servo_cr = n.advertise<geometry_msgs::TransformStamped>(topic, 1);
@@ -175,6 +252,141 @@ bool CRTK_robot::init_ros(ros::NodeHandle n){
 
 
 
+/**
+ * @brief      Starts recording every measured_js, measured_cp,
+ *             operating_state and published servo_* sample to record_file,
+ *             if set. record_buffer sets the ring size in records (default
+ *             8192, about 2 s at 4 streams of 1 kHz).
+ *
+ * @param[in]  n     ROS node handler
+ */
+void CRTK_robot::init_recorder(ros::NodeHandle n){
+  std::string path;
+  int slots = 8192;
+  if(!n.getParam("record_file", path) || path.empty())
+    return;
+  n.getParam("record_buffer", slots);
+
+  if(recorder.open(path, robot_name, max_joints, slots) == 0)
+    state.set_recorder(&recorder);
+}
+
+
+
+/**
+ * @brief      Starts publishing the latency histograms on /diagnostics every
+ *             diagnostics_period seconds (default 1, 0 disables).
+ *
+ * @param[in]  n     ROS node handler
+ */
+void CRTK_robot::init_diagnostics(ros::NodeHandle n){
+  measured_js_rx_ns = 0;
+  last_report_js_rx_ns = 0;
+  last_report_js_rejected = 0;
+
+  double period = 1.0;
+  n.getParam("diagnostics_period", period);
+  if(period <= 0)
+    return;
+
+  pub_diagnostics = n.advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 10);
+  diagnostics_timer = n.createWallTimer(ros::WallDuration(period), &CRTK_robot::publish_diagnostics, this);
+}
+
+
+
+/**
+ * @brief      Pre-sizes the outgoing servo messages so publishing allocates nothing
+ */
+void CRTK_robot::init_msg_pools(){
+  geometry_msgs::TransformStamped cart;
+  pool_servo_cr.init(cart);
+  pool_servo_cp.init(cart);
+  pool_servo_cv.init(cart);
+
+  sensor_msgs::JointState joint_pos, joint_vel;
+  joint_pos.position.resize(max_joints);
+  joint_vel.velocity.resize(max_joints);
+  pool_servo_jr.init(joint_pos);
+  pool_servo_jp.init(joint_pos);
+  pool_servo_jv.init(joint_vel);
+
+  sensor_msgs::JointState grasp_pos, grasp_vel;
+  grasp_pos.name.push_back("grasp");
+  grasp_pos.position.resize(1);
+  grasp_vel.name.push_back("grasp");
+  grasp_vel.velocity.resize(1);
+  pool_servo_jr_grasp.init(grasp_pos);
+  pool_servo_jp_grasp.init(grasp_pos);
+  pool_servo_jv_grasp.init(grasp_vel);
+}
+
+
+
+/**
+ * @brief      Gets the number of servo messages allocated after startup. Stays
+ *             constant in steady state; it only grows when every pooled message
+ *             of a channel is still held by a queue or subscriber.
+ *
+ * @return     The publish allocation count.
+ */
+unsigned long CRTK_robot::get_publish_alloc_count(){
+  return pool_servo_cr.get_alloc_count() + pool_servo_cp.get_alloc_count()
+    + pool_servo_cv.get_alloc_count() + pool_servo_jr.get_alloc_count()
+    + pool_servo_jp.get_alloc_count() + pool_servo_jv.get_alloc_count()
+    + pool_servo_jr_grasp.get_alloc_count() + pool_servo_jp_grasp.get_alloc_count()
+    + pool_servo_jv_grasp.get_alloc_count();
+}
+
+
+
+/**
+ * @brief      Gets how far the robot's input streams have been handled: the
+ *             oldest of the last measured_js, measured_cp and operating_state
+ *             stamps. A stream not received yet is left out, so a driver that
+ *             does not publish one of them is not waited for.
+ *
+ * @return     The stamp, zero before any message
+ */
+ros::Time CRTK_robot::get_input_stamp(){
+  int64_t stamps[3] = {measured_js_stamp_ns.load(std::memory_order_acquire),
+    measured_cp_stamp_ns.load(std::memory_order_acquire), (int64_t)state.get_stamp().toNSec()};
+  int64_t out = 0;
+  for(int i=0;i<3;i++){
+    if(stamps[i] && (!out || stamps[i] < out))
+      out = stamps[i];
+  }
+  ros::Time stamp;
+  stamp.fromNSec(out);
+  return stamp;
+}
+
+
+
+/**
+ * @brief      Gets the number of commands (servo_* and state_command)
+ *             published so far
+ *
+ * @return     The count
+ */
+unsigned long CRTK_robot::get_commands_sent(){
+  return servo_sent.load(std::memory_order_relaxed) + state.get_commands_sent();
+}
+
+
+
+/**
+ * @brief      Gets the number of measured_js messages dropped because their
+ *             size did not match num_joints.
+ *
+ * @return     The rejected count.
+ */
+unsigned long CRTK_robot::get_measured_js_rejected(){
+  return measured_js_rejected.load(std::memory_order_relaxed);
+}
+
+
+
 /**
  * @brief      Sets the state.
  *
@@ -191,10 +403,15 @@ void CRTK_robot::set_state(CRTK_robot_state *new_state){
  *
  * @param[in]  msg   The message
  */
-void CRTK_robot::crtk_measured_cp_arm_cb(geometry_msgs::TransformStamped msg){
+void CRTK_robot::crtk_measured_cp_arm_cb(const geometry_msgs::TransformStamped::ConstPtr& msg){
+  if(!msg->header.stamp.isZero())
+    measured_cp_age.add((ros::Time::now() - msg->header.stamp).toNSec());
+
   tf::Transform in;
-  tf::transformMsgToTF(msg.transform, in);
+  tf::transformMsgToTF(msg->transform, in);
   arm.set_measured_cp(in);
+  recorder.record(CRTK_RECORD_MEASURED_CP, msg->header.stamp, in);
+  measured_cp_stamp_ns.store(msg->header.stamp.toNSec(), std::memory_order_release);
 
 }
 
@@ -204,65 +421,260 @@ void CRTK_robot::crtk_measured_cp_arm_cb(geometry_msgs::TransformStamped msg){
  *
  * @param[in]  msg   The message
  */
-void CRTK_robot::crtk_measured_js_arm_cb(sensor_msgs::JointState msg){
+void CRTK_robot::crtk_measured_js_arm_cb(const sensor_msgs::JointState::ConstPtr& msg){
+
+  measured_js_rx_ns.store(steady_now_ns(), std::memory_order_relaxed);
+  if(!msg->header.stamp.isZero())
+    measured_js_age.add((ros::Time::now() - msg->header.stamp).toNSec());
 
-  int size = msg.position.size();
+  int size = msg->position.size();
 
-  if(size>MAX_JOINTS){
-    ROS_ERROR("Joint state size incorrect.");
+  if(size != (int)max_joints){
+    measured_js_rejected.fetch_add(1, std::memory_order_relaxed);
+    ROS_ERROR_THROTTLE(1, "Joint state size incorrect (expected %d, got %d).", max_joints, size);
+    return;
   }
 
-  float tmp_pos[MAX_JOINTS],tmp_vel[MAX_JOINTS],tmp_eff[MAX_JOINTS];
+  // velocity and effort are optional in JointState; skip them if short
+  const double *vel = (int)msg->velocity.size() >= size ? msg->velocity.data() : NULL;
+  const double *eff = (int)msg->effort.size() >= size ? msg->effort.data() : NULL;
+
+  // single update so readers never see pos/vel/eff from different messages
+  arm.set_measured_js(msg->position.data(),vel,eff,size); 
+  recorder.record_js(msg->header.stamp, msg->position.data(), vel, eff, size);
+  measured_js_stamp_ns.store(msg->header.stamp.toNSec(), std::memory_order_release);
+}
 
-  for(int i=0;i<size ;i++){
-    tmp_pos[i] = msg.position[i];
-    tmp_vel[i] = msg.velocity[i];
-    tmp_eff[i] = msg.effort[i];
+
+/**
+ * @brief      arm1 callback function for interp_cp. An unstamped setpoint is
+ *             stamped on receipt.
+ *
+ * @param[in]  msg   The message
+ */
+void CRTK_robot::crtk_interp_cp_arm_cb(const geometry_msgs::TransformStamped::ConstPtr& msg){
+  tf::Transform in;
+  tf::transformMsgToTF(msg->transform, in);
+  arm.send_interp_cp(in, msg->header.stamp.isZero() ? ros::Time::now() : msg->header.stamp);
+}
+
+
+/**
+ * @brief      arm1 callback function for interp_jp. An unstamped setpoint is
+ *             stamped on receipt.
+ *
+ * @param[in]  msg   The message
+ */
+void CRTK_robot::crtk_interp_jp_arm_cb(const sensor_msgs::JointState::ConstPtr& msg){
+  int size = msg->position.size();
+  if(size > (int)max_joints){
+    ROS_ERROR_THROTTLE(1, "interp_jp size incorrect (expected at most %d, got %d).", max_joints, size);
+    return;
+  }
+
+  float jpos[MAX_JOINTS];
+  for(int i=0;i<size;i++)
+    jpos[i] = msg->position[i];
+  arm.send_interp_jp(jpos, msg->header.stamp.isZero() ? ros::Time::now() : msg->header.stamp, size);
+}
+
+
+/**
+ * @brief      arm1 callback function for move_cp
+ *
+ * @param[in]  msg   The message
+ */
+void CRTK_robot::crtk_move_cp_arm_cb(const geometry_msgs::TransformStamped::ConstPtr& msg){
+  tf::Transform in;
+  tf::transformMsgToTF(msg->transform, in);
+  arm.move_cp(in);
+}
+
+
+/**
+ * @brief      arm1 callback function for move_jp. Fewer positions than
+ *             joints leave the rest where they are.
+ *
+ * @param[in]  msg   The message
+ */
+void CRTK_robot::crtk_move_jp_arm_cb(const sensor_msgs::JointState::ConstPtr& msg){
+  int size = msg->position.size();
+  if(size > (int)max_joints){
+    ROS_ERROR("move_jp size incorrect (expected at most %d, got %d). Move not started.", max_joints, size);
+    return;
   }
 
-  arm.set_measured_js_pos(tmp_pos,MAX_JOINTS); 
-  arm.set_measured_js_vel(tmp_vel,MAX_JOINTS); 
-  arm.set_measured_js_eff(tmp_eff,MAX_JOINTS); 
+  float jpos[MAX_JOINTS];
+  for(int i=0;i<size;i++)
+    jpos[i] = msg->position[i];
+  arm.move_jp(jpos, size);
 }
 
 
 /**
- * @brief      Checks all types of motion commands to publish to the robot.
+ * @brief      Publishes every pending motion command in one pass.
+ *
+ *             The arm and the grasper each take at most one servo command per
+ *             tick, since the servo modes of one device exclude each other.
+ *             Within a device the first updated channel in CRTK_servo_channel
+ *             order wins (cr, cp, cv, jr, jp, jv); the other updated channels
+ *             of that device are dropped and counted, not held over to the
+ *             next tick. Several sends on one channel within a tick coalesce
+ *             to the last one (counted by CRTK_motion::get_servo_superseded).
  */
 void CRTK_robot::check_motion_commands_to_publish(){
 
-  if(arm.get_servo_cr_updated()){ 
-    publish_servo_cr();
-  }  
+  char arm_sent = 0;
+  char grasp_sent = 0;
 
-  else if(arm.get_servo_cp_updated()){ 
-    publish_servo_cp();
-  }  
+  for(int i=0;i<CRTK_SERVO_NUM;i++){
+    CRTK_servo_channel channel = (CRTK_servo_channel)i;
+    if(!arm.get_servo_updated(channel))
+      continue;
 
-  else if(arm.get_servo_cv_updated()){ 
-    publish_servo_cv();
-  }  
+    char &sent = (channel >= CRTK_SERVO_JR_GRASP) ? grasp_sent : arm_sent;
+    if(sent){
+      servo_dropped[channel].fetch_add(1, std::memory_order_relaxed);
+      arm.reset_servo_updated(channel);
+      continue;
+    }
 
-  else if(arm.get_servo_jr_updated()){
-    publish_servo_jr();
-  }
-  else if(arm.get_servo_jr_grasp_updated()){
-    publish_servo_jr_grasp();
+    publish_servo(channel);
+    sent = 1;
   }
+}
+
 
-  else if(arm.get_servo_jp_updated()){
-    publish_servo_jp();
-  }
-  else if(arm.get_servo_jp_grasp_updated()){
-    publish_servo_jp_grasp();
-  }
 
-  else if(arm.get_servo_jv_updated()){
-    publish_servo_jv();
+/**
+ * @brief      Publishes the command of one servo channel.
+ *
+ * @param[in]  channel  The servo channel
+ */
+void CRTK_robot::publish_servo(CRTK_servo_channel channel){
+  int64_t rx = measured_js_rx_ns.load(std::memory_order_relaxed);
+  if(rx)
+    measured_js_to_publish.add(steady_now_ns() - rx);
+
+  switch(channel){
+    case CRTK_SERVO_CR:       publish_servo_cr();       break;
+    case CRTK_SERVO_CP:       publish_servo_cp();       break;
+    case CRTK_SERVO_CV:       publish_servo_cv();       break;
+    case CRTK_SERVO_JR:       publish_servo_jr();       break;
+    case CRTK_SERVO_JP:       publish_servo_jp();       break;
+    case CRTK_SERVO_JV:       publish_servo_jv();       break;
+    case CRTK_SERVO_JR_GRASP: publish_servo_jr_grasp(); break;
+    case CRTK_SERVO_JP_GRASP: publish_servo_jp_grasp(); break;
+    case CRTK_SERVO_JV_GRASP: publish_servo_jv_grasp(); break;
+    default: return;
   }
-  else if(arm.get_servo_jv_grasp_updated()){
-    publish_servo_jv_grasp();
+  servo_sent.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+
+/**
+ * @brief      Gets how many commands of a channel were dropped because a
+ *             higher priority channel of the same device went out that tick.
+ *
+ * @param[in]  channel  The servo channel
+ *
+ * @return     The dropped count.
+ */
+unsigned long CRTK_robot::get_servo_dropped(CRTK_servo_channel channel){
+  if(channel < 0 || channel >= CRTK_SERVO_NUM)
+    return 0;
+  return servo_dropped[channel].load(std::memory_order_relaxed);
+}
+
+
+
+/**
+ * @brief      Publishes the measured_* age and measured_js to publish
+ *             histograms of the last diagnostics period on /diagnostics.
+ *             WARN if no measured_js arrived or some were rejected in that
+ *             window. Runs on the spinner, not the control loop.
+ */
+void CRTK_robot::publish_diagnostics(const ros::WallTimerEvent&){
+  diagnostic_msgs::DiagnosticArray msg;
+  diagnostic_msgs::DiagnosticStatus status;
+
+  int64_t js_rx = measured_js_rx_ns.load(std::memory_order_relaxed);
+  unsigned long rejected = measured_js_rejected.load(std::memory_order_relaxed);
+  bool no_js = js_rx == last_report_js_rx_ns;
+  bool new_rejects = rejected != last_report_js_rejected;
+  last_report_js_rx_ns = js_rx;
+  last_report_js_rejected = rejected;
+
+  status.name = "crtk robot " + robot_name;
+  status.hardware_id = robot_name;
+  status.level = (no_js || new_rejects) ? diagnostic_msgs::DiagnosticStatus::WARN : diagnostic_msgs::DiagnosticStatus::OK;
+  if(no_js)
+    status.message = "no measured_js";
+  else if(new_rejects)
+    status.message = "measured_js rejected (wrong size)";
+  else
+    status.message = "OK";
+
+  measured_js_age.report(&status, "measured_js age");
+  measured_cp_age.report(&status, "measured_cp age");
+  measured_js_to_publish.report(&status, "measured_js to publish");
+
+  unsigned long dropped = 0;
+  for(int i=0;i<CRTK_SERVO_NUM;i++)
+    dropped += servo_dropped[i].load(std::memory_order_relaxed);
+
+  char buf[32];
+  diagnostic_msgs::KeyValue kv;
+  snprintf(buf, sizeof(buf), "%lu", rejected);
+  kv.key = "measured_js rejected total";
+  kv.value = buf;
+  status.values.push_back(kv);
+  snprintf(buf, sizeof(buf), "%lu", dropped);
+  kv.key = "servo dropped total";
+  kv.value = buf;
+  status.values.push_back(kv);
+  snprintf(buf, sizeof(buf), "%lu", get_publish_alloc_count());
+  kv.key = "publish allocations total";
+  kv.value = buf;
+  status.values.push_back(kv);
+  if(recorder.is_open()){
+    snprintf(buf, sizeof(buf), "%lu", recorder.get_written());
+    kv.key = "record written total";
+    kv.value = buf;
+    status.values.push_back(kv);
+    snprintf(buf, sizeof(buf), "%lu", recorder.get_dropped());
+    kv.key = "record dropped total";
+    kv.value = buf;
+    status.values.push_back(kv);
   }
+
+  msg.header.stamp = ros::Time::now();
+  msg.status.push_back(status);
+  pub_diagnostics.publish(msg);
+}
+
+
+
+/**
+ * @brief      Publishes the move status as "<status> <progress>", e.g.
+ *             "active 0.420". Sent on every change and at 10 Hz while a
+ *             move is active.
+ *
+ * @param[in]  status  The status
+ */
+void CRTK_robot::publish_move_status(CRTK_move_status status){
+  static const char *names[] = {"idle", "active", "done", "failed", "canceled"};
+  char text[32];
+  snprintf(text, sizeof(text), "%s %.3f", names[status], arm.get_move_progress());
+
+  crtk_msgs::StringStamped msg;
+  msg.header.stamp = ros::Time::now();
+  msg.string = text;
+  pub_move_status.publish(msg);
+
+  last_move_status = status;
+  move_status_ticks = 0;
 }
 
 
@@ -271,6 +683,15 @@ void CRTK_robot::check_motion_commands_to_publish(){
  * @brief      Initiate CRTK command publishing
  */
 void CRTK_robot::run(){
+  ros::Time now = ros::Time::now();
+  arm.interp_tick(now);
+
+  // a move goal overrides interp_* setpoints for the ticks it runs
+  CRTK_move_status move = arm.move_tick(now, state.get_enabled());
+  move_status_ticks++;
+  if(move != last_move_status || (move == CRTK_MOVE_ACTIVE && move_status_ticks >= LOOP_RATE/10))
+    publish_move_status(move);
+
   check_motion_commands_to_publish(); 
 }
 
@@ -280,11 +701,13 @@ void CRTK_robot::run(){
  * @brief      publish servo_cr_command
  */
 void CRTK_robot::publish_servo_cr(){
-  geometry_msgs::TransformStamped msg;
+  geometry_msgs::TransformStamped::Ptr msg = pool_servo_cr.get();
 
-  msg.header.stamp = msg.header.stamp.now();
+  msg->header.stamp = ros::Time::now();
   tf::Transform cmd = arm.get_servo_cr_command(); 
-  tf::transformTFToMsg(cmd,msg.transform);
+  tf::transformTFToMsg(cmd,msg->transform);
+
+  recorder.record(CRTK_record_type(CRTK_RECORD_SERVO + CRTK_SERVO_CR), msg->header.stamp, cmd);
 
   pub_servo_cr.publish(msg);
   arm.reset_servo_cr_updated();
@@ -297,11 +720,13 @@ void CRTK_robot::publish_servo_cr(){
  * @brief      publish servo_cp command
  */
 void CRTK_robot::publish_servo_cp(){
-  geometry_msgs::TransformStamped msg;
+  geometry_msgs::TransformStamped::Ptr msg = pool_servo_cp.get();
 
-  msg.header.stamp = msg.header.stamp.now();
+  msg->header.stamp = ros::Time::now();
   tf::Transform cmd = arm.get_servo_cp_command(); 
-  tf::transformTFToMsg(cmd,msg.transform);
+  tf::transformTFToMsg(cmd,msg->transform);
+
+  recorder.record(CRTK_record_type(CRTK_RECORD_SERVO + CRTK_SERVO_CP), msg->header.stamp, cmd);
 
   pub_servo_cp.publish(msg);
   arm.reset_servo_cp_updated();
@@ -313,11 +738,13 @@ void CRTK_robot::publish_servo_cp(){
  * @brief      publish servo_cv command
  */
 void CRTK_robot::publish_servo_cv(){
-  geometry_msgs::TransformStamped msg;
+  geometry_msgs::TransformStamped::Ptr msg = pool_servo_cv.get();
 
-  msg.header.stamp = msg.header.stamp.now();
+  msg->header.stamp = ros::Time::now();
   tf::Transform cmd = arm.get_servo_cv_command(); 
-  tf::transformTFToMsg(cmd,msg.transform);
+  tf::transformTFToMsg(cmd,msg->transform);
+
+  recorder.record(CRTK_record_type(CRTK_RECORD_SERVO + CRTK_SERVO_CV), msg->header.stamp, cmd);
 
   pub_servo_cv.publish(msg);
   arm.reset_servo_cv_updated();
@@ -329,12 +756,13 @@ void CRTK_robot::publish_servo_cv(){
  * @brief      publish servo_jr grasper command
  */
 void CRTK_robot::publish_servo_jr_grasp(){
-  sensor_msgs::JointState msg;
+  sensor_msgs::JointState::Ptr msg = pool_servo_jr_grasp.get();
 
-  msg.header.stamp = msg.header.stamp.now();
+  msg->header.stamp = ros::Time::now();
   float cmd = arm.get_servo_jr_grasp_command(); 
-  msg.position.push_back(cmd);
-  msg.name.push_back("grasp");
+  msg->position[0] = cmd;
+
+  recorder.record(CRTK_record_type(CRTK_RECORD_SERVO + CRTK_SERVO_JR_GRASP), msg->header.stamp, &cmd, 1);
 
   pub_servo_jr_grasp.publish(msg);
   arm.reset_servo_jr_grasp_updated();
@@ -346,12 +774,13 @@ void CRTK_robot::publish_servo_jr_grasp(){
  * @brief      publish servo_jv grasper command
  */
 void CRTK_robot::publish_servo_jv_grasp(){
-  sensor_msgs::JointState msg;
+  sensor_msgs::JointState::Ptr msg = pool_servo_jv_grasp.get();
 
-  msg.header.stamp = msg.header.stamp.now();
+  msg->header.stamp = ros::Time::now();
   float cmd = arm.get_servo_jv_grasp_command(); 
-  msg.velocity.push_back(cmd);
-  msg.name.push_back("grasp");
+  msg->velocity[0] = cmd;
+
+  recorder.record(CRTK_record_type(CRTK_RECORD_SERVO + CRTK_SERVO_JV_GRASP), msg->header.stamp, &cmd, 1);
 
   pub_servo_jv_grasp.publish(msg);
   arm.reset_servo_jv_grasp_updated();
@@ -364,18 +793,20 @@ void CRTK_robot::publish_servo_jv_grasp(){
  */
 void CRTK_robot::publish_servo_jr(){
   
-  sensor_msgs::JointState msg;
+  sensor_msgs::JointState::Ptr msg = pool_servo_jr.get();
 
-  msg.header.stamp = msg.header.stamp.now();
+  msg->header.stamp = ros::Time::now();
   float cmd[MAX_JOINTS];
 
-  arm.get_servo_jr_command(cmd, MAX_JOINTS); 
+  arm.get_servo_jr_command(cmd, max_joints); 
+
+  for(unsigned int j=0;j<max_joints;j++)
+    msg->position[j] = cmd[j];
+
+  recorder.record(CRTK_record_type(CRTK_RECORD_SERVO + CRTK_SERVO_JR), msg->header.stamp, cmd, max_joints);
 
-  for(int j=0;j<MAX_JOINTS;j++)
-    msg.position.push_back(cmd[j]);
-    
-    pub_servo_jr.publish(msg);
-    arm.reset_servo_jr_updated();
+  pub_servo_jr.publish(msg);
+  arm.reset_servo_jr_updated();
 }
 
 
@@ -385,18 +816,20 @@ void CRTK_robot::publish_servo_jr(){
  */
 void CRTK_robot::publish_servo_jv(){
   
-  sensor_msgs::JointState msg;
+  sensor_msgs::JointState::Ptr msg = pool_servo_jv.get();
 
-  msg.header.stamp = msg.header.stamp.now();
+  msg->header.stamp = ros::Time::now();
   float cmd[MAX_JOINTS];
 
-  arm.get_servo_jv_command(cmd, MAX_JOINTS); 
+  arm.get_servo_jv_command(cmd, max_joints); 
 
-  for(int j=0;j<MAX_JOINTS;j++)
-    msg.velocity.push_back(cmd[j]);
-    
-    pub_servo_jv.publish(msg);
-    arm.reset_servo_jv_updated();
+  for(unsigned int j=0;j<max_joints;j++)
+    msg->velocity[j] = cmd[j];
+
+  recorder.record(CRTK_record_type(CRTK_RECORD_SERVO + CRTK_SERVO_JV), msg->header.stamp, cmd, max_joints);
+
+  pub_servo_jv.publish(msg);
+  arm.reset_servo_jv_updated();
 }
 
 
@@ -405,12 +838,13 @@ void CRTK_robot::publish_servo_jv(){
  * @brief      publish servo jp grasper command
  */
 void CRTK_robot::publish_servo_jp_grasp(){
-  sensor_msgs::JointState msg;
+  sensor_msgs::JointState::Ptr msg = pool_servo_jp_grasp.get();
 
-  msg.header.stamp = msg.header.stamp.now();
+  msg->header.stamp = ros::Time::now();
   float cmd = arm.get_servo_jp_grasp_command(); 
-  msg.position.push_back(cmd);
-  msg.name.push_back("grasp");
+  msg->position[0] = cmd;
+
+  recorder.record(CRTK_record_type(CRTK_RECORD_SERVO + CRTK_SERVO_JP_GRASP), msg->header.stamp, &cmd, 1);
 
   pub_servo_jp_grasp.publish(msg);
   arm.reset_servo_jp_grasp_updated();
@@ -423,15 +857,17 @@ void CRTK_robot::publish_servo_jp_grasp(){
  */
 void CRTK_robot::publish_servo_jp(){
   
-  sensor_msgs::JointState msg;
+  sensor_msgs::JointState::Ptr msg = pool_servo_jp.get();
 
-  msg.header.stamp = msg.header.stamp.now();
+  msg->header.stamp = ros::Time::now();
   float cmd[MAX_JOINTS];
 
-  arm.get_servo_jp_command(cmd, MAX_JOINTS); 
+  arm.get_servo_jp_command(cmd, max_joints); 
+
+  for(unsigned int j=0;j<max_joints;j++)
+    msg->position[j] = cmd[j];
 
-  for(int j=0;j<MAX_JOINTS;j++)
-    msg.position.push_back(cmd[j]);
+  recorder.record(CRTK_record_type(CRTK_RECORD_SERVO + CRTK_SERVO_JP), msg->header.stamp, cmd, max_joints);
 
   pub_servo_jp.publish(msg);
   arm.reset_servo_jp_updated();
@@ -452,7 +888,7 @@ int main(int argc, char **argv){
   ros::init(argc, argv, "crtk_robot_library_wtf");  
 
   static ros::NodeHandle n("~"); 
-  ros::Rate loop_rate(LOOP_RATE); 
+  CRTK_rt_loop loop_rate(n, LOOP_RATE); 
 
   std::string r_space;
   if(!n.getParam("r_space", r_space))
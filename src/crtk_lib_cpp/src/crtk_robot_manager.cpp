@@ -0,0 +1,324 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_robot_manager.cpp
+ *
+ * \brief Class file for the multi-arm manager
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include "crtk_robot_manager.h"
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <chrono>
+
+static int64_t steady_now_ns(){
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/**
+ * @brief      Constructs the manager for the arms listed in the r_spaces
+ *             parameter.
+ *
+ * @param[in]  n     ros node handle
+ */
+CRTK_robot_manager::CRTK_robot_manager(ros::NodeHandle n):n(n){
+  std::vector<std::string> r_spaces;
+  int threads = 0;
+
+  if(!n.getParam("r_spaces", r_spaces))
+    ROS_ERROR("No robot namespaces (r_spaces) provided!");
+  n.getParam("arm_threads", threads);
+
+  init(r_spaces, threads);
+}
+
+
+/**
+ * @brief      Constructs the manager for the given arms.
+ *
+ * @param[in]  n            ros node handle
+ * @param[in]  r_spaces     The robot namespaces
+ * @param[in]  arm_threads  The number of worker threads
+ */
+CRTK_robot_manager::CRTK_robot_manager(ros::NodeHandle n, const std::vector<std::string> &r_spaces,
+  int arm_threads):n(n){
+  init(r_spaces, arm_threads);
+}
+
+
+/**
+ * @brief      Creates one CRTK_robot per namespace.
+ *
+ * @param[in]  r_spaces     The robot namespaces
+ * @param[in]  arm_threads  The number of worker threads
+ */
+void CRTK_robot_manager::init(const std::vector<std::string> &r_spaces, int arm_threads){
+  generation = 0;
+  stopping = false;
+  next_arm = 0;
+  arms_done = 0;
+  worst_skew_ns = 0;
+
+  names = r_spaces;
+  for(unsigned int i=0;i<names.size();i++)
+    arms.push_back(new CRTK_robot(n, names[i]));
+
+  // more threads than arms would only wait
+  num_threads = arm_threads;
+  if(num_threads < 0)
+    num_threads = 0;
+  if(num_threads > (int)arms.size() - 1)
+    num_threads = arms.size() > 1 ? arms.size() - 1 : 0;
+
+  double max_skew = 0.0002;
+  n.getParam("max_publish_skew", max_skew);
+  max_skew_ns = (int64_t)(max_skew * 1e9);
+
+  double period = 1.0;
+  n.getParam("diagnostics_period", period);
+  if(period > 0){
+    pub_diagnostics = n.advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 10);
+    diagnostics_timer = n.createWallTimer(ros::WallDuration(period),
+      &CRTK_robot_manager::publish_diagnostics, this);
+  }
+
+  ROS_INFO("Managing %d arms with %d worker threads.", (int)arms.size(), num_threads);
+}
+
+
+/**
+ * @brief      Stops the workers and releases the arms.
+ */
+CRTK_robot_manager::~CRTK_robot_manager(){
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    stopping = true;
+  }
+  pool_wake.notify_all();
+  for(unsigned int i=0;i<workers.size();i++)
+    workers[i].join();
+
+  for(unsigned int i=0;i<arms.size();i++)
+    delete arms[i];
+}
+
+
+/**
+ * @brief      Gets the number of arms.
+ *
+ * @return     The number of arms.
+ */
+int CRTK_robot_manager::get_num_arms(){
+  return arms.size();
+}
+
+
+/**
+ * @brief      Gets an arm by index.
+ *
+ * @param[in]  index  The arm index (order of r_spaces)
+ *
+ * @return     The arm, NULL if out of range
+ */
+CRTK_robot* CRTK_robot_manager::get_arm(int index){
+  if(index < 0 || index >= (int)arms.size()){
+    ROS_ERROR("No arm %d (have %d).", index, (int)arms.size());
+    return NULL;
+  }
+  return arms[index];
+}
+
+
+/**
+ * @brief      Gets an arm by robot namespace.
+ *
+ * @param[in]  r_space  The robot namespace
+ *
+ * @return     The arm, NULL if not managed
+ */
+CRTK_robot* CRTK_robot_manager::get_arm(const std::string &r_space){
+  for(unsigned int i=0;i<names.size();i++)
+    if(names[i] == r_space)
+      return arms[i];
+
+  ROS_ERROR("No arm %s.", r_space.c_str());
+  return NULL;
+}
+
+
+/**
+ * @brief      Sets the app function run for every arm each tick. It may run
+ *             on a worker thread, concurrently for different arms, so it
+ *             must only touch the arm it is given (and no function statics).
+ *
+ * @param[in]  in    The step function
+ */
+void CRTK_robot_manager::set_step(const arm_step &in){
+  step = in;
+}
+
+
+/**
+ * @brief      Starts the worker threads.
+ */
+void CRTK_robot_manager::start_workers(){
+  for(int i=0;i<num_threads;i++)
+    workers.push_back(std::thread(&CRTK_robot_manager::worker, this));
+}
+
+
+/**
+ * @brief      Worker thread: steps arms whenever a new tick starts.
+ */
+void CRTK_robot_manager::worker(){
+  unsigned long seen = 0;
+
+  for(;;){
+    {
+      std::unique_lock<std::mutex> lock(pool_mutex);
+      pool_wake.wait(lock, [&]{ return stopping || generation != seen; });
+      if(stopping)
+        return;
+      seen = generation;
+    }
+    step_arms();
+  }
+}
+
+
+/**
+ * @brief      Claims and steps arms until none are left this tick.
+ */
+void CRTK_robot_manager::step_arms(){
+  int num_arms = arms.size();
+  int i;
+
+  while((i = next_arm.fetch_add(1)) < num_arms){
+    int64_t start = steady_now_ns();
+    if(step)
+      step(arms[i], tick_time);
+    step_hist.add(steady_now_ns() - start);
+
+    if(arms_done.fetch_add(1) + 1 == num_arms){
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      pool_done.notify_one();
+    }
+  }
+}
+
+
+/**
+ * @brief      One tick: steps every arm, then publishes every arm's pending
+ *             commands back to back.
+ *
+ * @param[in]  current_time  The current time
+ */
+void CRTK_robot_manager::run(const ros::Time &current_time){
+  int num_arms = arms.size();
+  if(!num_arms)
+    return;
+
+  if(num_threads && workers.empty())
+    start_workers();
+
+  tick_time = current_time;
+  arms_done = 0;
+  next_arm = 0;
+
+  if(workers.empty())
+    step_arms();
+  else{
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      generation++;
+    }
+    pool_wake.notify_all();
+    step_arms();
+
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    pool_done.wait(lock, [&]{ return arms_done.load() >= num_arms; });
+  }
+
+  int64_t first = steady_now_ns();
+  for(int i=0;i<num_arms;i++)
+    arms[i]->run();
+  int64_t skew = steady_now_ns() - first;
+
+  skew_hist.add(skew);
+  if(skew > worst_skew_ns.load(std::memory_order_relaxed))
+    worst_skew_ns.store(skew, std::memory_order_relaxed);
+  if(max_skew_ns > 0 && skew > max_skew_ns)
+    ROS_WARN_THROTTLE(1, "Publishing %d arms took %.1f us (limit %.1f us)",
+      num_arms, skew/1e3, max_skew_ns/1e3);
+}
+
+
+/**
+ * @brief      Runs all arms at LOOP_RATE on the calling thread until shutdown.
+ */
+void CRTK_robot_manager::spin(){
+  CRTK_rt_loop loop_rate(n, LOOP_RATE);
+  for(size_t i=0;i<arms.size();i++)
+    loop_rate.follow(arms[i]);
+
+  while(ros::ok()){
+    ros::spinOnce();
+    run(CRTK_clock::now());
+    loop_rate.sleep();
+  }
+}
+
+
+/**
+ * @brief      Gets the longest time publishing all arms took so far.
+ *
+ * @return     The max publish skew in seconds.
+ */
+double CRTK_robot_manager::get_max_publish_skew(){
+  return worst_skew_ns.load(std::memory_order_relaxed) / 1e9;
+}
+
+
+/**
+ * @brief      Publishes the per-arm step time and publish skew histograms of
+ *             the last diagnostics period on /diagnostics.
+ */
+void CRTK_robot_manager::publish_diagnostics(const ros::WallTimerEvent&){
+  diagnostic_msgs::DiagnosticArray msg;
+  diagnostic_msgs::DiagnosticStatus status;
+
+  status.name = "crtk manager " + n.getNamespace();
+  status.hardware_id = status.name;
+  status.level = diagnostic_msgs::DiagnosticStatus::OK;
+  status.message = "OK";
+
+  step_hist.report(&status, "arm step");
+  skew_hist.report(&status, "publish skew");
+
+  msg.header.stamp = ros::Time::now();
+  msg.status.push_back(status);
+  pub_diagnostics.publish(msg);
+}
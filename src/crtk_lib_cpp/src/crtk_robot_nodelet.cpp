@@ -0,0 +1,81 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford,
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_robot_nodelet.cpp
+ *
+ * \brief Class file for the CRTK_robot nodelet base
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include "crtk_robot_nodelet.h"
+
+
+/**
+ * @brief      Constructs the nodelet. The robot is created in onInit().
+ */
+CRTK_robot_nodelet::CRTK_robot_nodelet():robot(NULL),running(false){
+}
+
+
+/**
+ * @brief      Stops the loop thread and releases the robot.
+ */
+CRTK_robot_nodelet::~CRTK_robot_nodelet(){
+  running = false;
+  if(loop_thread.joinable())
+    loop_thread.join();
+  delete robot;
+}
+
+
+/**
+ * @brief      Creates the robot for the r_space namespace and starts the loop thread
+ */
+void CRTK_robot_nodelet::onInit(){
+  ros::NodeHandle &n = getPrivateNodeHandle();
+
+  std::string r_space;
+  if(!n.getParam("r_space", r_space))
+    NODELET_ERROR("No Robot namespace provided in nodelet parameters!");
+
+  robot = new CRTK_robot(n, r_space);
+
+  running = true;
+  loop_thread = std::thread(&CRTK_robot_nodelet::run_loop, this);
+}
+
+
+/**
+ * @brief      Runs the app loop at LOOP_RATE until the nodelet is unloaded
+ */
+void CRTK_robot_nodelet::run_loop(){
+  CRTK_rt_loop loop_rate(getPrivateNodeHandle(), LOOP_RATE);
+  loop_rate.follow(robot, NULL);   // the manager's threads run the callbacks
+
+  while(running && ros::ok()){
+    loop(CRTK_clock::now());
+    robot->run();
+    loop_rate.sleep();
+  }
+}
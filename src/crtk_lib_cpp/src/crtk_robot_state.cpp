@@ -36,34 +36,67 @@
 #include <sstream>
 
 CRTK_robot_state::CRTK_robot_state(){
-  is_disabled   = 0;
-  is_enabled    = 0;
-  is_paused     = 0;
-  is_fault      = 0;
-  is_homing     = 0;
-  is_busy       = 0;
-  is_ready      = 0;
-  is_homed      = 0;
-
-  has_connected = 0;
+  clear_flags();
+  recorder      = NULL;
+  stamp_ns      = 0;
+  commands_sent = 0;
 }
 
 CRTK_robot_state::CRTK_robot_state(ros::NodeHandle n, std::string robot_ns){
 
   robot_name    = robot_ns;
-  is_disabled   = 0;
-  is_enabled    = 0;
-  is_paused     = 0;
-  is_fault      = 0;
-  is_homing     = 0;
-  is_busy       = 0;
-  is_ready      = 0;
-  is_homed      = 0;
-
-  has_connected = 0;
+  clear_flags();
+  recorder      = NULL;
+  stamp_ns      = 0;
+  commands_sent = 0;
   init_ros(n);
 }
 
+CRTK_robot_state::CRTK_robot_state(const CRTK_robot_state& in){
+  *this = in;
+}
+
+
+/**
+ * @brief      Copies the state, taking one coherent snapshot of its flags
+ *
+ * @param[in]  in    The state to copy
+ *
+ * @return     this state
+ */
+CRTK_robot_state& CRTK_robot_state::operator=(const CRTK_robot_state& in){
+  if(this == &in)
+    return *this;
+
+  robot_name = in.robot_name;
+  pub        = in.pub;
+  sub        = in.sub;
+  flags.store(in.flags.load());
+  recorder   = in.recorder.load();
+  stamp_ns   = in.stamp_ns.load();
+  commands_sent = in.commands_sent.load();
+  return *this;
+}
+
+
+/**
+ * @brief      Resets every flag, as before the first operating_state
+ */
+void CRTK_robot_state::clear_flags(){
+  CRTK_robot_state_flags f;
+  f.is_disabled   = 0;
+  f.is_enabled    = 0;
+  f.is_paused     = 0;
+  f.is_fault      = 0;
+  f.is_homing     = 0;
+  f.is_busy       = 0;
+  f.is_ready      = 0;
+  f.is_homed      = 0;
+
+  f.has_connected = 0;
+  flags.store(f);
+}
+
 
 /**
  * @brief      initializes ros pubs and subs
@@ -81,7 +114,7 @@ bool CRTK_robot_state::init_ros(ros::NodeHandle n){
   pub = n.advertise<crtk_msgs::StringStamped>(topic, 1);
 
   topic = "/" + robot_name + "/operating_state";
-  sub = n.subscribe(topic, 1, &CRTK_robot_state::operating_state_cb,this);
+  sub = n.subscribe(topic, 1, &CRTK_robot_state::operating_state_cb,this, CRTK_transport::hints(n, topic));
 
   return true;
 }
@@ -92,35 +125,34 @@ bool CRTK_robot_state::init_ros(ros::NodeHandle n){
  *
  * @param[in]  msg   The message from ROS
  */
-void CRTK_robot_state::operating_state_cb(crtk_msgs::operating_state msg){
+void CRTK_robot_state::operating_state_cb(const crtk_msgs::operating_state::ConstPtr& msg){
 
-  std::string state = msg.state;
+  const std::string &state = msg->state;
+  CRTK_robot_state_flags f;
 
-  if (state =="DISABLED"){
-    set_disabled_state();
-  }
-  else if (state =="ENABLED"){
-    set_enabled_state();
-  }
+  // anything unknown is a fault
+  f.is_disabled = state == "DISABLED";
+  f.is_enabled  = state == "ENABLED";
+  f.is_paused   = state == "PAUSED";
+  f.is_fault    = !f.is_disabled && !f.is_enabled && !f.is_paused;
 
-  else if (state =="PAUSED"){
-    set_paused_state();
-  }
-  else if (state =="FAULT"){
-    set_fault_state();
-  }
-  else{
-    set_fault_state();
-  }
+  f.is_homed    = msg->is_homed;
+  f.is_busy     = msg->is_busy;
+  f.is_homing   = f.is_busy && !f.is_homed;
+  // set_ready(msg.is_ready);
+  f.is_ready    = !f.is_busy && f.is_homed && f.is_enabled;
 
+  f.has_connected = 1;
 
-  set_homed(msg.is_homed);
-  set_busy(msg.is_busy);
-  set_homing();
-  // set_ready(msg.is_ready);
-  ready_logic();
+  // one write, so the loop sees all of this message or none of it
+  flags.store(f);
 
-  set_connected(1);
+  CRTK_recorder *rec = recorder.load(std::memory_order_acquire);
+  if(rec){
+    double values[3] = {(double)state_of(f), (double)msg->is_homed, (double)msg->is_busy};
+    rec->record(CRTK_RECORD_OPERATING_STATE, msg->header.stamp, values, 3);
+  }
+  stamp_ns.store(msg->header.stamp.toNSec(), std::memory_order_release);
 
   static int count = 0;
   ++count;
@@ -129,6 +161,41 @@ void CRTK_robot_state::operating_state_cb(crtk_msgs::operating_state msg){
 
 
 
+/**
+ * @brief      Records every operating_state received from now on, NULL to stop
+ *
+ * @param      rec   The recorder
+ */
+void CRTK_robot_state::set_recorder(CRTK_recorder *rec){
+  recorder.store(rec, std::memory_order_release);
+}
+
+
+
+/**
+ * @brief      Gets the stamp of the last operating_state received
+ *
+ * @return     The stamp, zero before the first one
+ */
+ros::Time CRTK_robot_state::get_stamp(){
+  ros::Time out;
+  out.fromNSec(stamp_ns.load(std::memory_order_acquire));
+  return out;
+}
+
+
+
+/**
+ * @brief      Gets the number of state commands published so far
+ *
+ * @return     The count
+ */
+unsigned long CRTK_robot_state::get_commands_sent(){
+  return commands_sent.load(std::memory_order_relaxed);
+}
+
+
+
 /**
  * @brief      send crtk robot state transition command
  *
@@ -179,25 +246,51 @@ void CRTK_robot_state::crtk_command_pb(CRTK_robot_command command){
   }
   msg_command.header.stamp = msg_command.header.stamp.now();
   pub.publish(msg_command);
+  commands_sent.fetch_add(1, std::memory_order_relaxed);
   ++count;
 
 }
 
 
 
+/**
+ * @brief      Gets one coherent snapshot of all state flags. Use this
+ *             instead of several get_* calls when the flags have to agree.
+ *
+ * @return     The flags.
+ */
+CRTK_robot_state_flags CRTK_robot_state::get_flags(){
+  return flags.load();
+}
+
+
+
 /**
  * @brief      Gets the robot state.
  *
  * @return     The state.
  */
 CRTK_robot_state_enum CRTK_robot_state::get_state(){
-  if(is_disabled){
+  return state_of(flags.load());
+}
+
+
+
+/**
+ * @brief      Maps a set of flags to the robot state.
+ *
+ * @param[in]  f     The flags
+ *
+ * @return     The state.
+ */
+CRTK_robot_state_enum CRTK_robot_state::state_of(const CRTK_robot_state_flags& f){
+  if(f.is_disabled){
     return CRTK_DISABLED;
   }
-  else if(is_enabled){
+  else if(f.is_enabled){
     return CRTK_ENABLED;
   }
-  else if(is_paused){
+  else if(f.is_paused){
     return CRTK_PAUSED;
   }
   else{
@@ -213,8 +306,11 @@ CRTK_robot_state_enum CRTK_robot_state::get_state(){
  * @return     is_homing flag
  */
 bool CRTK_robot_state::set_homing(){
-  is_homing = is_busy && !is_homed;
-  return is_homing;
+  CRTK_robot_state_flags *f = flags.write_begin();
+  f->is_homing = f->is_busy && !f->is_homed;
+  bool out = f->is_homing;
+  flags.write_end();
+  return out;
 }
 
 
@@ -227,8 +323,9 @@ bool CRTK_robot_state::set_homing(){
  * @return     is_busy flag
  */
 bool CRTK_robot_state::set_busy(bool new_state){
-  is_busy = new_state;
-  return is_busy;
+  flags.write_begin()->is_busy = new_state;
+  flags.write_end();
+  return new_state;
 }
 
 
@@ -241,8 +338,9 @@ bool CRTK_robot_state::set_busy(bool new_state){
  * @return     is_homed flag
  */
 bool CRTK_robot_state::set_homed(bool new_state){
-  is_homed = new_state;
-  return is_homed;
+  flags.write_begin()->is_homed = new_state;
+  flags.write_end();
+  return new_state;
 }
 
 
@@ -253,8 +351,27 @@ bool CRTK_robot_state::set_homed(bool new_state){
  * @return     is_ready flag
  */
 bool CRTK_robot_state::ready_logic(){
-  is_ready = !is_busy && is_homed && is_enabled;
-  return is_ready;
+  CRTK_robot_state_flags *f = flags.write_begin();
+  f->is_ready = !f->is_busy && f->is_homed && f->is_enabled;
+  bool out = f->is_ready;
+  flags.write_end();
+  return out;
+}
+
+
+
+/**
+ * @brief      Sets the robot to one of the four exclusive states.
+ *
+ * @param[in]  state  The state
+ */
+void CRTK_robot_state::set_exclusive_state(CRTK_robot_state_enum state){
+  CRTK_robot_state_flags *f = flags.write_begin();
+  f->is_disabled   = state == CRTK_DISABLED;
+  f->is_enabled    = state == CRTK_ENABLED;
+  f->is_paused     = state == CRTK_PAUSED;
+  f->is_fault      = state == CRTK_FAULT;
+  flags.write_end();
 }
 
 
@@ -265,11 +382,7 @@ bool CRTK_robot_state::ready_logic(){
  * @return     0
  */
 bool CRTK_robot_state::set_disabled_state(){
-  is_disabled   = 1;
-  is_enabled    = 0;
-  is_paused     = 0;
-  is_fault      = 0;
-
+  set_exclusive_state(CRTK_DISABLED);
   return 0;
 }
 
@@ -281,11 +394,7 @@ bool CRTK_robot_state::set_disabled_state(){
  * @return     0
  */
 bool CRTK_robot_state::set_enabled_state(){
-  is_disabled   = 0;
-  is_enabled    = 1;
-  is_paused     = 0;
-  is_fault      = 0;
-
+  set_exclusive_state(CRTK_ENABLED);
   return 0;
 }
 
@@ -297,11 +406,7 @@ bool CRTK_robot_state::set_enabled_state(){
  * @return     0
  */
 bool CRTK_robot_state::set_paused_state(){
-  is_disabled   = 0;
-  is_enabled    = 0;
-  is_paused     = 1;
-  is_fault      = 0;
-
+  set_exclusive_state(CRTK_PAUSED);
   return 0;
 }
 
@@ -313,11 +418,7 @@ bool CRTK_robot_state::set_paused_state(){
  * @return     0
  */
 bool CRTK_robot_state::set_fault_state(){
-  is_disabled   = 0;
-  is_enabled    = 0;
-  is_paused     = 0;
-  is_fault      = 1;
-
+  set_exclusive_state(CRTK_FAULT);
   return 0;
 }
 
@@ -331,8 +432,9 @@ bool CRTK_robot_state::set_fault_state(){
  * @return     0
  */
 bool CRTK_robot_state::set_connected(bool val){
-  if(val == 0 || val == 1)
-    has_connected = val;
+  flags.write_begin()->has_connected = val;
+  flags.write_end();
+  return 0;
 }
 
 
@@ -343,12 +445,13 @@ bool CRTK_robot_state::set_connected(bool val){
  * @return     char version of the robot state
  */
 char CRTK_robot_state::state_char(){
+  CRTK_robot_state_flags f = flags.load();
   char out;
 
-  if(is_disabled)       out = 'D';
-  else if (is_enabled)  out = 'E';
-  else if (is_paused)   out = 'P';
-  else if (is_fault)    out = 'F';
+  if(f.is_disabled)       out = 'D';
+  else if (f.is_enabled)  out = 'E';
+  else if (f.is_paused)   out = 'P';
+  else if (f.is_fault)    out = 'F';
   else out = 'N'; //no connection?
 
   return out;
@@ -362,27 +465,29 @@ char CRTK_robot_state::state_char(){
  * @return     The disabled flag.
  */
 bool CRTK_robot_state::get_disabled(){
-  return is_disabled;
+  return flags.load().is_disabled;
 }
 
 
+
 /**
  * @brief      Gets the enabled flag.
  *
  * @return     The enabled flag.
  */
 bool CRTK_robot_state::get_enabled(){
-  return is_enabled;
+  return flags.load().is_enabled;
 }
 
 
+
 /**
  * @brief      Gets the paused flag.
  *
  * @return     The paused flag.
  */
 bool CRTK_robot_state::get_paused(){
-  return is_paused;
+  return flags.load().is_paused;
 }
 
 
@@ -393,7 +498,7 @@ bool CRTK_robot_state::get_paused(){
  * @return     The fault flag.
  */
 bool CRTK_robot_state::get_fault(){
-  return is_fault;
+  return flags.load().is_fault;
 }
 
 
@@ -404,7 +509,7 @@ bool CRTK_robot_state::get_fault(){
  * @return     The homing flag.
  */
 bool CRTK_robot_state::get_homing(){
-  return is_homing;
+  return flags.load().is_homing;
 }
 
 
@@ -415,7 +520,7 @@ bool CRTK_robot_state::get_homing(){
  * @return     The busy flag.
  */
 bool CRTK_robot_state::get_busy(){
-  return is_busy;
+  return flags.load().is_busy;
 }
 
 
@@ -426,7 +531,7 @@ bool CRTK_robot_state::get_busy(){
  * @return     The ready flag.
  */
 bool CRTK_robot_state::get_ready(){
-  return is_ready;
+  return flags.load().is_ready;
 }
 
 
@@ -437,7 +542,7 @@ bool CRTK_robot_state::get_ready(){
  * @return     The homed flag.
  */
 bool CRTK_robot_state::get_homed(){
-  return is_homed;
+  return flags.load().is_homed;
 }
 
 
@@ -448,5 +553,5 @@ bool CRTK_robot_state::get_homed(){
  * @return     The connected flag.
  */
 bool CRTK_robot_state::get_connected(){
-  return has_connected;
+  return flags.load().has_connected;
 }
@@ -0,0 +1,474 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * crtk_rt_loop.cpp
+ *
+ * \brief Class file for the absolute-deadline loop timer
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include "crtk_rt_loop.h"
+#include "crtk_robot.h"
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <crtk_msgs/StringStamped.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstring>
+
+#define NSEC_PER_SEC 1000000000LL
+
+static int64_t timespec_to_ns(const struct timespec &t){
+  return (int64_t)t.tv_sec * NSEC_PER_SEC + t.tv_nsec;
+}
+
+static struct timespec ns_to_timespec(int64_t ns){
+  struct timespec t;
+  t.tv_sec = ns / NSEC_PER_SEC;
+  t.tv_nsec = ns % NSEC_PER_SEC;
+  return t;
+}
+
+static int64_t monotonic_now_ns(){
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return timespec_to_ns(t);
+}
+
+
+/**
+ * @brief      Constructs the loop timer without any real-time settings.
+ *
+ * @param[in]  rate  The loop rate (Hz)
+ */
+CRTK_rt_loop::CRTK_rt_loop(double rate){
+  init(rate);
+}
+
+
+/**
+ * @brief      Constructs the loop timer, applies the rt_priority, rt_cpu
+ *             and rt_mlockall parameters to the calling thread and starts
+ *             the diagnostics timer.
+ *
+ * @param[in]  n     ros node handle to read the parameters from
+ * @param[in]  rate  The loop rate (Hz)
+ */
+CRTK_rt_loop::CRTK_rt_loop(const ros::NodeHandle &n, double rate){
+  int priority = 0;
+  int cpu = -1;
+  bool lock_memory = false;
+  double diagnostics_period = 1.0;
+
+  n.getParam("rt_priority", priority);
+  n.getParam("rt_cpu", cpu);
+  n.getParam("rt_mlockall", lock_memory);
+  n.getParam("diagnostics_period", diagnostics_period);
+
+  set_realtime(priority, cpu, lock_memory);
+  init(rate);
+  n.getParam("lockstep_timeout", lockstep_timeout);
+
+  if(diagnostics_period > 0){
+    ros::NodeHandle pub_n(n);
+    diagnostics_name = "crtk loop " + n.getNamespace();
+    pub_diagnostics = pub_n.advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 10);
+    diagnostics_timer = n.createWallTimer(ros::WallDuration(diagnostics_period),
+      &CRTK_rt_loop::publish_diagnostics, this);
+  }
+}
+
+
+/**
+ * @brief      Sets the period and starts the first cycle now.
+ *
+ * @param[in]  rate  The loop rate (Hz)
+ */
+void CRTK_rt_loop::init(double rate){
+  if(rate <= 0){
+    ROS_ERROR("Loop rate must be positive (got %f). Using 1 Hz.", rate);
+    rate = 1;
+  }
+  period_ns = (int64_t)(NSEC_PER_SEC / rate + 0.5);
+  sim_time = ros::Time::isSimTime();
+  follow_queue = NULL;
+  lockstep_timeout = 1.0;
+  acked_sent = 0;
+  if(sim_time){
+    // several loops can share a node (nodelets), so the key is per loop
+    static std::atomic<unsigned int> instances(0);
+    char id[16];
+    snprintf(id, sizeof(id), "#%u", instances.fetch_add(1));
+    ack_key = ros::this_node::getName() + id;
+    pub_clock_ack = ros::NodeHandle().advertise<crtk_msgs::StringStamped>("/clock_ack", 10);
+  }
+
+  cycles = 0;
+  overruns = 0;
+  stale = 0;
+  max_overrun_ns = 0;
+  last_report_overruns = 0;
+  reset();
+}
+
+
+/**
+ * @brief      Tells a lockstep clock not to wait for this loop any more
+ *             (best effort, the clock also gives up on it after its timeout)
+ */
+CRTK_rt_loop::~CRTK_rt_loop(){
+  if(!sim_time)
+    return;
+  // the followed robots may already be gone
+  char buf[48];
+  snprintf(buf, sizeof(buf), " %lu 0", acked_sent);
+  crtk_msgs::StringStamped ack;
+  ack.header.stamp = ros::TIME_MAX;
+  ack.string = ack_key + buf;
+  pub_clock_ack.publish(ack);
+}
+
+
+/**
+ * @brief      Runs in step with the robot under a lockstep clock: the acks
+ *             count the commands published to it, so the clock handles them
+ *             before its next step, and sleep() only returns once the
+ *             robot's measured_* of the new step are in. Does nothing on
+ *             wall time.
+ *
+ * @param      robot  The robot, simulated by the node driving the clock
+ * @param      queue  The queue the robot's callbacks are on, spun while
+ *                    waiting; NULL if other threads spin it (nodelets)
+ */
+void CRTK_rt_loop::follow(CRTK_robot *robot, ros::CallbackQueue *queue){
+  followed.push_back(robot);
+  follow_queue = queue;
+}
+
+
+/**
+ * @brief      follow for a client with only the operating state
+ */
+void CRTK_rt_loop::follow(CRTK_robot_state *state, ros::CallbackQueue *queue){
+  followed_states.push_back(state);
+  follow_queue = queue;
+}
+
+
+/**
+ * @brief      Restarts the schedule: the current cycle ends one period from now.
+ */
+void CRTK_rt_loop::reset(){
+  last_wake_ns = monotonic_now_ns();
+  next = ns_to_timespec(last_wake_ns + period_ns);
+  if(sim_time)
+    sim_next = ros::Time::now() + ros::Duration().fromNSec(period_ns);
+}
+
+
+/**
+ * @brief      Sleeps until the end of the current cycle. A cycle that ran past
+ *             its deadline is counted as an overrun and the next cycle starts
+ *             right away; if it ran late by a full period or more, the missed
+ *             deadlines are skipped rather than run back to back.
+ *
+ * @return     true if the deadline was met, false on overrun
+ */
+bool CRTK_rt_loop::sleep(){
+  int64_t now = monotonic_now_ns();
+  compute_hist.add(now - last_wake_ns);
+  cycles.fetch_add(1, std::memory_order_relaxed);
+
+  if(sim_time){
+    ros::Time sim_now = ros::Time::now();
+    bool met = sim_now <= sim_next;
+    if(!met){
+      // behind (or the clock jumped): start over from now
+      overruns.fetch_add(1, std::memory_order_relaxed);
+      sim_next = sim_now;
+    }
+
+    ros::Time done;
+    done.fromNSec(sim_next.toNSec() - 1);
+    publish_ack(done);
+
+    // ros::Time::sleepUntil polls every 1 ms of wall time, which would cap
+    // a lockstep clock at real time for a 1 kHz loop
+    while(ros::ok() && ros::Time::now() < sim_next)
+      ros::WallDuration(0, 10000).sleep();
+    wait_inputs();
+
+    sim_next = sim_next + ros::Duration().fromNSec(period_ns);
+    record_wake(monotonic_now_ns());
+    return met;
+  }
+
+  int64_t deadline = timespec_to_ns(next);
+  int64_t late = now - deadline;
+
+  if(late > 0){
+    unsigned long n_over = overruns.fetch_add(1, std::memory_order_relaxed) + 1;
+    int64_t worst = max_overrun_ns.load(std::memory_order_relaxed);
+    if(late > worst){
+      worst = late;
+      max_overrun_ns.store(late, std::memory_order_relaxed);
+    }
+    ROS_WARN_THROTTLE(1, "Loop overran its deadline by %.1f us (%lu of %lu cycles late, worst %.1f us)",
+      late/1e3, n_over, cycles.load(std::memory_order_relaxed), worst/1e3);
+
+    if(late >= period_ns)
+      deadline += (late / period_ns) * period_ns;
+    next = ns_to_timespec(deadline + period_ns);
+    record_wake(now);
+    return false;
+  }
+
+  while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR);
+
+  next = ns_to_timespec(deadline + period_ns);
+  record_wake(monotonic_now_ns());
+  return true;
+}
+
+
+/**
+ * @brief      Acks on /clock_ack: this loop is done up to done, with the
+ *             commands it has published so far and the inputs it ran on.
+ *
+ * @param[in]  done  The sim time the loop is done up to
+ */
+void CRTK_rt_loop::publish_ack(const ros::Time& done){
+  unsigned long sent = 0;
+  for(size_t i=0;i<followed.size();i++)
+    sent += followed[i]->get_commands_sent();
+  for(size_t i=0;i<followed_states.size();i++)
+    sent += followed_states[i]->get_commands_sent();
+
+  acked_sent = sent;
+
+  char buf[48];
+  snprintf(buf, sizeof(buf), " %lu %llu", sent, (unsigned long long)input_stamp().toNSec());
+
+  crtk_msgs::StringStamped ack;
+  ack.header.stamp = done;
+  ack.string = ack_key + buf;
+  pub_clock_ack.publish(ack);
+}
+
+
+/**
+ * @brief      Gets the oldest input stamp of the followed robots
+ *
+ * @return     The stamp, zero if none has received anything yet
+ */
+ros::Time CRTK_rt_loop::input_stamp(){
+  ros::Time out;
+  for(size_t i=0;i<followed.size() + followed_states.size();i++){
+    ros::Time in = i < followed.size() ? followed[i]->get_input_stamp()
+      : followed_states[i - followed.size()]->get_stamp();
+    if(!in.isZero() && (out.isZero() || in < out))
+      out = in;
+  }
+  return out;
+}
+
+
+/**
+ * @brief      Waits, up to lockstep_timeout seconds, until the followed
+ *             robots hold their inputs for the current sim time. The
+ *             simulator publishes them before the clock, but on other
+ *             connections, so they may still be on the way.
+ */
+void CRTK_rt_loop::wait_inputs(){
+  if(followed.empty() && followed_states.empty())
+    return;
+
+  ros::Time now = ros::Time::now();
+  ros::WallTime give_up = ros::WallTime::now() + ros::WallDuration(lockstep_timeout);
+  for(;;){
+    ros::Time in = input_stamp();
+    if(!ros::ok() || in.isZero() || in >= now)
+      return;
+    if(give_up < ros::WallTime::now()){
+      unsigned long n_stale = stale.fetch_add(1, std::memory_order_relaxed) + 1;
+      ROS_WARN_THROTTLE(1, "No measured_* for %.3f after %.1f s, running on older ones (%lu stale ticks).",
+        now.toSec(), lockstep_timeout, n_stale);
+      return;
+    }
+    if(follow_queue)
+      follow_queue->callAvailable(ros::WallDuration(0, 10000));
+    else
+      ros::WallDuration(0, 10000).sleep();
+  }
+}
+
+
+/**
+ * @brief      Starts a new cycle and records the period of the last one.
+ *
+ * @param[in]  wake_ns  The wake up time (CLOCK_MONOTONIC ns)
+ */
+void CRTK_rt_loop::record_wake(int64_t wake_ns){
+  period_hist.add(wake_ns - last_wake_ns);
+  last_wake_ns = wake_ns;
+}
+
+
+/**
+ * @brief      Publishes the loop period and compute time histograms of the
+ *             last diagnostics period on /diagnostics. WARN if any cycle
+ *             overran in that window. Runs on the spinner, not the loop.
+ */
+void CRTK_rt_loop::publish_diagnostics(const ros::WallTimerEvent&){
+  diagnostic_msgs::DiagnosticArray msg;
+  diagnostic_msgs::DiagnosticStatus status;
+
+  unsigned long n_over = overruns.load(std::memory_order_relaxed);
+  unsigned long window_over = n_over - last_report_overruns;
+  last_report_overruns = n_over;
+
+  char buf[64];
+  status.name = diagnostics_name;
+  status.hardware_id = diagnostics_name;
+  status.level = window_over ? diagnostic_msgs::DiagnosticStatus::WARN : diagnostic_msgs::DiagnosticStatus::OK;
+  snprintf(buf, sizeof(buf), "%lu overruns", window_over);
+  status.message = window_over ? buf : "OK";
+
+  snprintf(buf, sizeof(buf), "%.1f", 1e6*get_period());
+  diagnostic_msgs::KeyValue kv;
+  kv.key = "target period (us)";
+  kv.value = buf;
+  status.values.push_back(kv);
+
+  period_hist.report(&status, "period");
+  compute_hist.report(&status, "compute");
+
+  snprintf(buf, sizeof(buf), "%lu", n_over);
+  kv.key = "overruns total";
+  kv.value = buf;
+  status.values.push_back(kv);
+
+  msg.header.stamp = ros::Time::now();
+  msg.status.push_back(status);
+  pub_diagnostics.publish(msg);
+}
+
+
+/**
+ * @brief      Applies real-time settings to the calling thread.
+ *
+ * @param[in]  priority     SCHED_FIFO priority (1-99), 0 to leave it alone
+ * @param[in]  cpu          CPU to pin to, -1 to leave it alone
+ * @param[in]  lock_memory  call mlockall(MCL_CURRENT | MCL_FUTURE)
+ *
+ * @return     success 0, fail -1 (each failure is reported, the rest still applied)
+ */
+char CRTK_rt_loop::set_realtime(int priority, int cpu, bool lock_memory){
+  char out = 0;
+  int err;
+
+  if(lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0){
+    ROS_ERROR("mlockall failed: %s", strerror(errno));
+    out = -1;
+  }
+
+  if(cpu >= 0){
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if(err){
+      ROS_ERROR("Cannot pin loop to CPU %d: %s", cpu, strerror(err));
+      out = -1;
+    }
+  }
+
+  if(priority > 0){
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+    err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if(err){
+      ROS_ERROR("Cannot set SCHED_FIFO priority %d: %s (check rtprio in /etc/security/limits.conf)",
+        priority, strerror(err));
+      out = -1;
+    }
+    else
+      ROS_INFO("Loop running SCHED_FIFO at priority %d", priority);
+  }
+
+  return out;
+}
+
+
+/**
+ * @brief      Gets the number of completed cycles.
+ *
+ * @return     The cycle count.
+ */
+unsigned long CRTK_rt_loop::get_cycles(){
+  return cycles.load(std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief      Gets the number of cycles that missed their deadline.
+ *
+ * @return     The overrun count.
+ */
+unsigned long CRTK_rt_loop::get_overruns(){
+  return overruns.load(std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief      Gets the number of lockstep ticks that ran without the inputs
+ *             of their step (see follow()).
+ *
+ * @return     The stale tick count.
+ */
+unsigned long CRTK_rt_loop::get_stale(){
+  return stale.load(std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief      Gets the worst overrun so far.
+ *
+ * @return     The max overrun in seconds.
+ */
+double CRTK_rt_loop::get_max_overrun(){
+  return max_overrun_ns.load(std::memory_order_relaxed) / 1e9;
+}
+
+
+/**
+ * @brief      Gets the loop period.
+ *
+ * @return     The period in seconds.
+ */
+double CRTK_rt_loop::get_period(){
+  return period_ns / 1e9;
+}
@@ -0,0 +1,126 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * crtk_suite.cpp
+ *
+ * \brief Class file for the CRTK test suite results
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include "crtk_suite.h"
+#include <cstdio>
+
+namespace {
+
+struct suite_state{
+  suite_state():exit_when_done(0),file(NULL),errors(0){};
+
+  bool exit_when_done;
+  FILE *file;
+  ros::WallTime last;
+  int errors;
+};
+
+suite_state &state(){
+  static suite_state s;
+  return s;
+}
+
+}
+
+
+
+/**
+ * @brief      Reads the result_file and exit_when_done parameters. Test
+ *             times are measured from here.
+ *
+ * @param[in]  n     ros node handle the parameters are read from
+ */
+void CRTK_suite::init(const ros::NodeHandle& n){
+  suite_state &s = state();
+  std::string path;
+
+  n.getParam("exit_when_done", s.exit_when_done);
+  if(n.getParam("result_file", path) && path != ""){
+    s.file = fopen(path.c_str(), "w");
+    if(!s.file)
+      ROS_ERROR("Could not open result_file %s.", path.c_str());
+  }
+  s.last = ros::WallTime::now();
+}
+
+
+
+/**
+ * @brief      Records the outcome of one test
+ *
+ * @param[in]  test    The test name
+ * @param[in]  status  The test status, > 0 passed, < 0 failed
+ */
+void CRTK_suite::result(const std::string& test, int status){
+  suite_state &s = state();
+  ros::WallTime now = ros::WallTime::now();
+
+  if(s.file){
+    fprintf(s.file, "{\"test\": \"%s\", \"status\": %d, \"time\": %.3f}\n",
+      test.c_str(), status, (now - s.last).toSec());
+    fflush(s.file);
+  }
+  s.last = now;
+}
+
+
+
+/**
+ * @brief      Records the end of the suite and shuts the node down if
+ *             exit_when_done is set
+ *
+ * @param[in]  errors  The number of failed tests
+ */
+void CRTK_suite::done(int errors){
+  suite_state &s = state();
+  s.errors = errors;
+
+  if(s.file){
+    fprintf(s.file, "{\"done\": true, \"errors\": %d}\n", errors);
+    fclose(s.file);
+    s.file = NULL;
+  }
+  if(s.exit_when_done){
+    ROS_INFO("Suite done with %i errors, exiting.", errors);
+    ros::shutdown();
+  }
+}
+
+
+
+/**
+ * @brief      The exit code for the node
+ *
+ * @return     0 if every test passed, 1 otherwise
+ */
+int CRTK_suite::exit_code(){
+  return state().errors ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * crtk_transport.cpp
+ *
+ * \brief Class file for the CRTK transport hints
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include "crtk_transport.h"
+#include <sstream>
+#include <algorithm>
+
+
+/**
+ * @brief      Gets the transport hints for a topic from the transport and
+ *             transport_<topic> parameters.
+ *
+ * @param[in]  n      ros node handle the parameters are read from
+ * @param[in]  topic  The topic, only its last name is used (measured_js for
+ *                    /arm1/measured_js)
+ *
+ * @return     The transport hints.
+ */
+ros::TransportHints CRTK_transport::hints(const ros::NodeHandle& n, const std::string& topic){
+  std::string name = topic.substr(topic.find_last_of('/') + 1);
+  std::string spec = "tcp_nodelay";
+  n.getParam("transport", spec);
+  n.getParam("transport_" + name, spec);
+
+  bool ok;
+  ros::TransportHints out = parse(spec, &ok);
+  if(!ok)
+    ROS_ERROR("Unknown transport in \"%s\" for %s (use tcp, tcp_nodelay or udp).", spec.c_str(), topic.c_str());
+  else if(spec != "tcp_nodelay")
+    ROS_INFO("%s transport: %s", topic.c_str(), spec.c_str());
+  return out;
+}
+
+
+/**
+ * @brief      Builds transport hints from a preference list such as
+ *             "udp tcp_nodelay". Unknown entries are skipped.
+ *
+ * @param[in]  spec  The transports, separated by spaces or commas
+ * @param      ok    Set to false if an entry was unknown
+ *
+ * @return     The transport hints.
+ */
+ros::TransportHints CRTK_transport::parse(const std::string& spec, bool *ok){
+  ros::TransportHints out;
+  std::string list = spec;
+  std::replace(list.begin(), list.end(), ',', ' ');
+  std::istringstream in(list);
+  std::string item;
+
+  if(ok) *ok = true;
+  while(in >> item){
+    if(item == "tcp")
+      out.tcp();
+    else if(item == "tcp_nodelay")
+      out.tcp().tcpNoDelay();
+    else if(item == "udp" || item == "unreliable")
+      out.udp();
+    else if(ok)
+      *ok = false;
+  }
+  return out;
+}
@@ -0,0 +1,152 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * crtk_record_to_csv.cpp
+ *
+ * \brief Converts a CRTK_recorder file to CSV on stdout. With a record type
+ *  only that stream is written, with named columns; without one every
+ *  record is written as type, count and its values.
+ *
+ *  rosrun crtk_lib_cpp crtk_record_to_csv arm1.crtk measured_js > arm1_js.csv
+ *
+ *  Times are in seconds: t since the recording started (CRTK_clock), stamp
+ *  as sent in the message header (0 if none).
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include <crtk_lib_cpp/crtk_recorder.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+static const char *type_names[CRTK_RECORD_NUM] = {"header", "measured_js", "measured_cp", "operating_state",
+  "servo_cr", "servo_cp", "servo_cv", "servo_jr", "servo_jp", "servo_jv",
+  "servo_jr_grasp", "servo_jp_grasp", "servo_jv_grasp"};
+
+
+/**
+ * @brief      Writes the column names of one record type
+ *
+ * @param[in]  type        The record type
+ * @param[in]  num_joints  The number of joints
+ */
+void print_columns(int type, int num_joints){
+  printf("t,stamp,dropped");
+  switch(type){
+    case CRTK_RECORD_MEASURED_JS:
+      for(int i=0;i<num_joints;i++) printf(",pos_%d", i);
+      for(int i=0;i<num_joints;i++) printf(",vel_%d", i);
+      for(int i=0;i<num_joints;i++) printf(",eff_%d", i);
+      break;
+    case CRTK_RECORD_MEASURED_CP:
+    case CRTK_RECORD_SERVO + CRTK_SERVO_CR:
+    case CRTK_RECORD_SERVO + CRTK_SERVO_CP:
+    case CRTK_RECORD_SERVO + CRTK_SERVO_CV:
+      printf(",x,y,z,qx,qy,qz,qw");
+      break;
+    case CRTK_RECORD_OPERATING_STATE:
+      printf(",state,is_homed,is_busy");
+      break;
+    case CRTK_RECORD_SERVO + CRTK_SERVO_JR_GRASP:
+    case CRTK_RECORD_SERVO + CRTK_SERVO_JP_GRASP:
+    case CRTK_RECORD_SERVO + CRTK_SERVO_JV_GRASP:
+      printf(",grasp");
+      break;
+    default:
+      for(int i=0;i<num_joints;i++) printf(",joint_%d", i);
+  }
+  printf("\n");
+}
+
+
+/**
+ * @brief      The main function
+ *
+ * @param[in]  argc  The argc
+ * @param      argv  The argv
+ *
+ * @return     0 on success
+ */
+int main(int argc, char **argv){
+  if(argc < 2){
+    fprintf(stderr, "usage: %s <record file> [record type]\n", argv[0]);
+    return 1;
+  }
+
+  int only = -1;
+  if(argc > 2){
+    for(int i=1;i<CRTK_RECORD_NUM;i++)
+      if(std::string(argv[2]) == type_names[i])
+        only = i;
+    if(only < 0){
+      fprintf(stderr, "unknown record type %s\n", argv[2]);
+      return 1;
+    }
+  }
+
+  FILE *in = fopen(argv[1], "rb");
+  if(!in){
+    fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 1;
+  }
+
+  CRTK_record rec;
+  CRTK_record_file_header header;
+  if(fread(&rec, sizeof(rec), 1, in) != 1){
+    fprintf(stderr, "%s is empty\n", argv[1]);
+    return 1;
+  }
+  memcpy(&header, &rec, sizeof(header));
+  if(memcmp(header.magic, CRTK_RECORD_MAGIC, sizeof(CRTK_RECORD_MAGIC)) != 0 ||
+     header.version != CRTK_RECORD_VERSION || header.record_size != sizeof(CRTK_record)){
+    fprintf(stderr, "%s is not a version %d CRTK record file\n", argv[1], CRTK_RECORD_VERSION);
+    return 1;
+  }
+  fprintf(stderr, "%s: %u joints\n", header.robot_name, header.num_joints);
+
+  if(only >= 0)
+    print_columns(only, header.num_joints);
+  else
+    printf("t,stamp,dropped,type,count,values...\n");
+
+  unsigned long records = 0;
+  while(fread(&rec, sizeof(rec), 1, in) == 1){
+    if(rec.type >= CRTK_RECORD_NUM || (only >= 0 && rec.type != only))
+      continue;
+
+    int values = rec.type == CRTK_RECORD_MEASURED_JS ? 3*rec.count : rec.count;
+    if(values > CRTK_RECORD_VALUES)
+      values = CRTK_RECORD_VALUES;
+
+    printf("%.9f,%.9f,%u", 1e-9*(rec.t_ns - header.start_t_ns), 1e-9*rec.stamp_ns, rec.dropped);
+    if(only < 0)
+      printf(",%s,%u", type_names[rec.type], rec.count);
+    for(int i=0;i<values;i++)
+      printf(",%.9g", rec.value[i]);
+    printf("\n");
+    records++;
+  }
+  fprintf(stderr, "%lu records\n", records);
+  fclose(in);
+  return 0;
+}
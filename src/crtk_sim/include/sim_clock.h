@@ -0,0 +1,79 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * sim_clock.h
+ *
+ * \brief Lockstep clock for the simulator. Publishes /clock one step at a
+ *  time, as fast as the nodes driven by it keep up. Every CRTK_rt_loop
+ *  running on sim time acks on /clock_ack the time up to which it is done
+ *  and how many commands it has published to the robots it follows. The
+ *  clock only advances once every loop has caught up and the simulated
+ *  robot has received every command acked, so each step sees the same
+ *  commands whatever the CPU and transport timing.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_SIM_CLOCK_H_
+#define CRTK_SIM_CLOCK_H_
+
+#include <ros/ros.h>
+#include <ros/callback_queue.h>
+#include <crtk_msgs/StringStamped.h>
+#include "sim_robot.h"
+#include <map>
+
+class CRTK_sim_clock{
+public:
+  CRTK_sim_clock(ros::NodeHandle n, double rate);
+  ~CRTK_sim_clock(){};
+
+  ros::Time now();
+  void advance(CRTK_sim_robot&);
+  unsigned long get_late();
+  unsigned long get_stale();
+
+private:
+  // the last ack of one loop
+  struct CRTK_sim_ack{
+    ros::Time done;        // sim time it is done up to
+    unsigned long sent;    // commands it has published so far
+  };
+
+  void clock_ack_cb(const crtk_msgs::StringStamped::ConstPtr&);
+  bool clients_done(CRTK_sim_robot&);
+  void resync(CRTK_sim_robot&);
+  static std::string node_of(const std::string& key);
+
+  ros::Time time;
+  ros::Duration dt;
+  double timeout;          // s of wall time to wait for the clients
+  unsigned long late;      // steps taken without every client done
+  unsigned long stale;     // acks of ticks run on older measured_*
+
+  std::map<std::string, CRTK_sim_ack> acks;   // by loop key
+  std::map<std::string, long> offset;         // per node, received to sent
+  ros::Subscriber sub_clock_ack;
+  ros::Publisher pub_clock;
+};
+
+#endif
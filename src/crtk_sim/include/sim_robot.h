@@ -0,0 +1,153 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * sim_robot.h
+ *
+ * \brief Simulated CRTK robot: serves operating_state, measured_js and
+ *  measured_cp and follows the nine servo_* topics, standing in for the
+ *  Raven driver. The joints and the Cartesian pose are two independent
+ *  plants (there is no kinematics between them); each tracks its goal with
+ *  a first-order lag and a speed limit, integrated in fixed 1/rate steps so
+ *  a run only depends on the commands received.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_SIM_ROBOT_H_
+#define CRTK_SIM_ROBOT_H_
+
+#include <ros/ros.h>
+#include <tf/tf.h>
+#include <sensor_msgs/JointState.h>
+#include <geometry_msgs/TransformStamped.h>
+#include <crtk_msgs/operating_state.h>
+#include <crtk_msgs/StringStamped.h>
+#include <crtk_lib_cpp/defines.h>
+#include <crtk_lib_cpp/crtk_msg_pool.h>
+#include <crtk_lib_cpp/crtk_transport.h>
+#include <map>
+
+// one simulated joint; the grasper is one more of these
+struct CRTK_sim_joint{
+  double pos;
+  double vel;
+  double goal;
+  double vel_cmd;          // servo_jv, applied to goal until vel_until
+  unsigned long vel_until; // tick
+};
+
+class CRTK_sim_robot{
+public:
+  CRTK_sim_robot(ros::NodeHandle n, std::string robot_ns, double rate);
+  ~CRTK_sim_robot(){};
+
+  void step();
+  void publish(const ros::Time&);
+
+  CRTK_robot_state_enum get_state();
+  bool get_homed();
+  bool get_busy();
+  unsigned long get_ignored();
+  unsigned long get_received(const std::string& node);
+
+private:
+  bool init_param(ros::NodeHandle);
+  bool init_ros(ros::NodeHandle);
+
+  void state_command_cb(const ros::MessageEvent<crtk_msgs::StringStamped const>&);
+  void servo_cr_cb(const ros::MessageEvent<geometry_msgs::TransformStamped const>&);
+  void servo_cp_cb(const ros::MessageEvent<geometry_msgs::TransformStamped const>&);
+  void servo_cv_cb(const ros::MessageEvent<geometry_msgs::TransformStamped const>&);
+  void servo_jr_cb(const ros::MessageEvent<sensor_msgs::JointState const>&);
+  void servo_jp_cb(const ros::MessageEvent<sensor_msgs::JointState const>&);
+  void servo_jv_cb(const ros::MessageEvent<sensor_msgs::JointState const>&);
+  void servo_jr_grasp_cb(const ros::MessageEvent<sensor_msgs::JointState const>&);
+  void servo_jp_grasp_cb(const ros::MessageEvent<sensor_msgs::JointState const>&);
+  void servo_jv_grasp_cb(const ros::MessageEvent<sensor_msgs::JointState const>&);
+
+  bool accepting(int length = -1);
+  void set_state(CRTK_robot_state_enum);
+  void start_homing();
+  void stop_homing();
+  void hold();
+  void step_joint(CRTK_sim_joint*, double max_vel);
+  void step_cart();
+  void publish_operating_state(const ros::Time&);
+
+  std::string robot_name;
+  std::string grasper_name;
+  int num_joints;
+  double dt;
+  unsigned long tick;
+
+  // operating state
+  CRTK_robot_state_enum state;
+  bool is_homed;
+  bool is_busy;
+  unsigned long busy_until;   // tick homing completes
+  bool state_changed;
+  unsigned long state_period; // ticks between operating_state messages
+  unsigned long ignored;      // servo_* received while not accepting
+  std::map<std::string, unsigned long> received;  // commands per publishing node
+
+  // plants
+  CRTK_sim_joint joints[MAX_JOINTS+1];   // [num_joints] is the grasper
+  tf::Transform cart_pos;
+  tf::Transform cart_goal;
+  tf::Vector3 cart_lin_vel;              // servo_cv, m/s
+  tf::Vector3 cart_ang_axis;             // servo_cv rotation axis
+  double cart_ang_vel;                   // and rate, rad/s
+  unsigned long cart_vel_until;
+
+  // parameters
+  double tau;             // first-order time constant (s)
+  double max_jvel;        // rad/s (or m/s)
+  double max_grasp_vel;
+  double max_vel;         // Cartesian, m/s
+  unsigned long servo_timeout;  // ticks a servo_*v is held
+  unsigned long home_ticks;
+  double home_jpos[MAX_JOINTS];
+  double home_grasp;
+  tf::Transform home_pos;
+
+  ros::Subscriber sub_state_command;
+  ros::Subscriber sub_servo_cr;
+  ros::Subscriber sub_servo_cp;
+  ros::Subscriber sub_servo_cv;
+  ros::Subscriber sub_servo_jr;
+  ros::Subscriber sub_servo_jp;
+  ros::Subscriber sub_servo_jv;
+  ros::Subscriber sub_servo_jr_grasp;
+  ros::Subscriber sub_servo_jp_grasp;
+  ros::Subscriber sub_servo_jv_grasp;
+
+  ros::Publisher pub_operating_state;
+  ros::Publisher pub_measured_js;
+  ros::Publisher pub_measured_cp;
+  ros::Publisher pub_measured_js_grasp;
+
+  CRTK_msg_pool<sensor_msgs::JointState> pool_measured_js;
+  CRTK_msg_pool<sensor_msgs::JointState> pool_measured_js_grasp;
+  CRTK_msg_pool<geometry_msgs::TransformStamped> pool_measured_cp;
+};
+
+#endif
@@ -0,0 +1,93 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * main.cpp
+ *
+ * \brief Simulated CRTK robot node, a stand-in for the Raven driver
+ *
+ *  rosrun crtk_sim crtk_sim _r_space:=arm1 _rate:=1000
+ *
+ *  With _lockstep:=true it publishes /clock itself and steps as fast as
+ *  the nodes on sim time keep up (see sim_clock.h) instead of at rate.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include <ros/ros.h>
+#include <crtk_lib_cpp/crtk_rt_loop.h>
+#include "sim_robot.h"
+#include "sim_clock.h"
+
+
+
+/**
+ * @brief      The main function: each tick handles the commands received,
+ *             steps the simulated robot and publishes its measured state
+ *
+ * @param[in]  argc  The argc
+ * @param      argv  The argv
+ *
+ * @return     0
+ */
+int main(int argc, char **argv)
+{
+  ros::init(argc, argv, "crtk_sim");
+  static ros::NodeHandle n("~");
+
+  std::string r_space = "arm1";
+  double rate = 1000;
+  if(!n.getParam("r_space", r_space))
+    ROS_WARN("No r_space given, simulating %s.", r_space.c_str());
+  n.getParam("rate", rate);
+  if(rate <= 0){
+    ROS_ERROR("rate must be positive (got %f).", rate);
+    return -1;
+  }
+
+  bool lockstep = false;
+  n.getParam("lockstep", lockstep);
+  if(lockstep && !ros::Time::isSimTime())
+    ROS_WARN("lockstep is set but /use_sim_time is not, the other nodes will not follow the clock.");
+
+  CRTK_sim_robot robot(n, r_space, rate);
+
+  if(lockstep){
+    // each step's measured state goes out before its clock, and the
+    // commands computed from it are all in before the next step
+    CRTK_sim_clock clock(n, rate);
+    while (ros::ok()){
+      robot.publish(clock.now());
+      clock.advance(robot);
+      robot.step();
+    }
+    return 0;
+  }
+
+  CRTK_rt_loop loop_rate(n, rate);
+  while (ros::ok()){
+    ros::spinOnce();
+    robot.step();
+    robot.publish(ros::Time::now());
+    loop_rate.sleep();
+  }
+  return 0;
+}
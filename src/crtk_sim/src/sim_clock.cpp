@@ -0,0 +1,231 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * sim_clock.cpp
+ *
+ * \brief Lockstep clock for the simulator (see sim_clock.h)
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include "sim_clock.h"
+#include <rosgraph_msgs/Clock.h>
+#include <sstream>
+
+/**
+ * @brief      Starts the clock at the current wall time, so stamps still
+ *             read as dates. The first step is published by advance().
+ *
+ * @param[in]  n     ROS node handle (private parameters)
+ * @param[in]  rate  The steps per simulated second (Hz)
+ */
+CRTK_sim_clock::CRTK_sim_clock(ros::NodeHandle n, double rate){
+  ros::WallTime start = ros::WallTime::now();
+  time.fromNSec(start.toNSec());
+  dt.fromNSec((int64_t)(1e9/rate + 0.5));
+  timeout = 1.0;
+  late    = 0;
+  stale   = 0;
+  n.getParam("lockstep_timeout", timeout);
+
+  ros::NodeHandle nq;
+  sub_clock_ack = nq.subscribe("/clock_ack", 100, &CRTK_sim_clock::clock_ack_cb, this);
+  pub_clock = nq.advertise<rosgraph_msgs::Clock>("/clock", 1);
+  ROS_INFO("Lockstep clock at %.0f Hz on %s.", rate, pub_clock.getTopic().c_str());
+}
+
+
+
+/**
+ * @brief      Gets the simulated time
+ *
+ * @return     The time of the current step
+ */
+ros::Time CRTK_sim_clock::now(){
+  return time;
+}
+
+
+
+/**
+ * @brief      Publishes the current step, then handles callbacks until
+ *             every client is done with it and the robot has received the
+ *             commands they acked, up to lockstep_timeout seconds, and
+ *             moves to the next step. Publish the robot's measured state
+ *             for the step before calling this. Without clients the clock
+ *             runs as fast as the CPU allows.
+ *
+ * @param      robot  The simulated robot, whose commands arrive on the
+ *                    global callback queue
+ */
+void CRTK_sim_clock::advance(CRTK_sim_robot &robot){
+  rosgraph_msgs::Clock msg;
+  msg.clock = time;
+  pub_clock.publish(msg);
+
+  ros::CallbackQueue *queue = ros::getGlobalCallbackQueue();
+  ros::WallTime give_up = ros::WallTime::now() + ros::WallDuration(timeout);
+
+  queue->callAvailable();
+  while(ros::ok() && !clients_done(robot)){
+    if(give_up < ros::WallTime::now()){
+      late++;
+      ROS_WARN_THROTTLE(1, "Lockstep clients not done with %.3f after %.1f s, stepping anyway (%lu late steps).",
+        time.toSec(), timeout, late);
+      resync(robot);
+      break;
+    }
+    queue->callAvailable(ros::WallDuration(0.001));
+  }
+
+  time = time + dt;
+}
+
+
+
+/**
+ * @brief      Gets the number of steps taken before every client was done.
+ *             Non-zero means the run was not in lockstep all along.
+ *
+ * @return     The number of late steps
+ */
+unsigned long CRTK_sim_clock::get_late(){
+  return late;
+}
+
+
+
+/**
+ * @brief      Gets the number of client ticks that ran on measured_* older
+ *             than their step. Non-zero means the run was not in lockstep
+ *             all along.
+ *
+ * @return     The number of stale ticks
+ */
+unsigned long CRTK_sim_clock::get_stale(){
+  return stale;
+}
+
+
+
+/**
+ * @brief      Records how far a loop is done. The ack string is
+ *             "<key> <commands sent> <input stamp ns>" (see CRTK_rt_loop).
+ *             An ack done up to the end of time is a loop shutting down.
+ *
+ * @param[in]  msg   The ack
+ */
+void CRTK_sim_clock::clock_ack_cb(const crtk_msgs::StringStamped::ConstPtr& msg){
+  std::istringstream in(msg->string);
+  std::string key;
+  unsigned long sent = 0;
+  unsigned long long input_ns = 0;
+  in >> key >> sent >> input_ns;
+
+  std::map<std::string, CRTK_sim_ack>::iterator it = acks.find(key);
+  if(msg->header.stamp == ros::TIME_MAX){
+    // its last commands are still counted, the loops after it start from 0
+    if(it != acks.end())
+      offset[node_of(key)] -= sent;
+    acks.erase(key);
+    return;
+  }
+
+  // a loop acks a tick while the clock is still at that tick's step
+  if(it != acks.end() && input_ns && input_ns < time.toNSec()){
+    stale++;
+    ROS_WARN_THROTTLE(1, "%s ran on measured_* older than %.3f (%lu stale ticks).",
+      key.c_str(), time.toSec(), stale);
+  }
+
+  CRTK_sim_ack &ack = acks[key];
+  ack.done = msg->header.stamp;
+  ack.sent = sent;
+}
+
+
+
+/**
+ * @brief      Whether every loop is done with the current step and the
+ *             robot has received every command acked by each node. A node
+ *             that has just connected counts as not done until its first
+ *             ack.
+ *
+ * @param      robot  The simulated robot
+ *
+ * @return     true if the clock may advance
+ */
+bool CRTK_sim_clock::clients_done(CRTK_sim_robot &robot){
+  std::map<std::string, unsigned long> sent;
+  for(std::map<std::string, CRTK_sim_ack>::iterator it = acks.begin(); it != acks.end(); ++it){
+    if(it->second.done < time)
+      return false;
+    sent[node_of(it->first)] += it->second.sent;
+  }
+  if(sent.size() < sub_clock_ack.getNumPublishers())
+    return false;
+
+  for(std::map<std::string, unsigned long>::iterator it = sent.begin(); it != sent.end(); ++it){
+    if((long)robot.get_received(it->first) + offset[it->first] < (long)it->second)
+      return false;
+  }
+  return true;
+}
+
+
+
+/**
+ * @brief      After a timeout, forgets the loops that did not ack (they
+ *             wait for the clock again on their next ack) and takes the
+ *             commands lost so far as received, so one dropped message
+ *             does not stall every later step.
+ *
+ * @param      robot  The simulated robot
+ */
+void CRTK_sim_clock::resync(CRTK_sim_robot &robot){
+  std::map<std::string, unsigned long> sent;
+  for(std::map<std::string, CRTK_sim_ack>::iterator it = acks.begin(); it != acks.end();){
+    sent[node_of(it->first)] += it->second.sent;
+    if(it->second.done < time)
+      acks.erase(it++);
+    else
+      ++it;
+  }
+  for(std::map<std::string, unsigned long>::iterator it = sent.begin(); it != sent.end(); ++it){
+    long missing = (long)it->second - (long)robot.get_received(it->first) - offset[it->first];
+    if(missing > 0)
+      offset[it->first] += missing;
+  }
+}
+
+
+
+/**
+ * @brief      Gets the node a loop key belongs to
+ *
+ * @param[in]  key   The loop key, node name#instance
+ *
+ * @return     The node name
+ */
+std::string CRTK_sim_clock::node_of(const std::string& key){
+  return key.substr(0, key.rfind('#'));
+}
@@ -0,0 +1,688 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * sim_robot.cpp
+ *
+ * \brief Simulated CRTK robot (see sim_robot.h)
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include "sim_robot.h"
+#include <cmath>
+
+/**
+ * @brief      Sets up the simulated robot named robot_ns, at rest in its
+ *             home pose, disabled and not homed.
+ *
+ * @param[in]  n         ROS node handle (private parameters)
+ * @param[in]  robot_ns  The robot namespace
+ * @param[in]  rate      The rate step() is called at (Hz)
+ */
+CRTK_sim_robot::CRTK_sim_robot(ros::NodeHandle n, std::string robot_ns, double rate){
+  robot_name    = robot_ns;
+  dt            = 1.0/rate;
+  tick          = 0;
+
+  state         = CRTK_DISABLED;
+  is_homed      = 0;
+  is_busy       = 0;
+  busy_until    = 0;
+  state_changed = 1;
+  ignored       = 0;
+
+  init_param(n);
+
+  for(int i=0;i<=num_joints;i++){
+    CRTK_sim_joint &j = joints[i];
+    j.pos = j.goal = (i < num_joints) ? home_jpos[i] : home_grasp;
+    j.vel = j.vel_cmd = 0;
+    j.vel_until = 0;
+  }
+  cart_pos = cart_goal = home_pos;
+  cart_lin_vel = tf::Vector3(0,0,0);
+  cart_ang_axis = tf::Vector3(1,0,0);
+  cart_ang_vel = 0;
+  cart_vel_until = 0;
+
+  init_ros(n);
+}
+
+
+
+/**
+ * @brief      Reads the robot's yaml parameters (grasper_name, num_joints,
+ *             home_jpos, home_pos, home_quat), as the library does, and the
+ *             simulator's own private ones. Missing values fall back to a
+ *             7 joint arm homed at zero.
+ *
+ * @param[in]  n     ROS node handle
+ *
+ * @return     success
+ */
+bool CRTK_sim_robot::init_param(ros::NodeHandle n){
+  if(!n.getParam("/"+robot_name+"/grasper_name", grasper_name)){
+    grasper_name = robot_name + "_grasp";
+    ROS_WARN("No grasper_name for %s, using %s.", robot_name.c_str(), grasper_name.c_str());
+  }
+
+  num_joints = 7;
+  n.getParam("/"+robot_name+"/num_joints", num_joints);
+  if(num_joints < 1 || num_joints > MAX_JOINTS){
+    ROS_ERROR("num_joints must be 1 to %d (got %d), using %d.", MAX_JOINTS, num_joints, MAX_JOINTS);
+    num_joints = MAX_JOINTS;
+  }
+
+  std::vector<double> jpos, pos, quat;
+  n.getParam("/"+robot_name+"/home_jpos", jpos);
+  n.getParam("/"+robot_name+"/home_pos", pos);
+  n.getParam("/"+robot_name+"/home_quat", quat);
+  if(!jpos.empty() && (int)jpos.size() != num_joints)
+    ROS_ERROR("Wrong length for home_jpos parameter. (desired %d, actual %d)", num_joints, (int)jpos.size());
+  for(int i=0;i<num_joints;i++)
+    home_jpos[i] = ((int)jpos.size() == num_joints) ? jpos[i] : 0;
+
+  home_pos.setIdentity();
+  if(pos.size() == 3)
+    home_pos.setOrigin(tf::Vector3(pos[0],pos[1],pos[2]));
+  if(quat.size() == 4)
+    home_pos.setRotation(tf::Quaternion(quat[0],quat[1],quat[2],quat[3]).normalized());
+
+  double home_time = 1.0, timeout = 0.1, state_rate = 10;
+  tau           = 0.01;
+  max_jvel      = 3.0;
+  max_grasp_vel = 3.0;
+  max_vel       = 0.5;
+  home_grasp    = 0;
+  n.getParam("tau", tau);
+  n.getParam("max_jvel", max_jvel);
+  n.getParam("max_grasp_vel", max_grasp_vel);
+  n.getParam("max_vel", max_vel);
+  n.getParam("home_time", home_time);
+  n.getParam("home_grasp", home_grasp);
+  n.getParam("servo_timeout", timeout);
+  n.getParam("state_rate", state_rate);
+  if(tau < dt) tau = dt;
+
+  home_ticks    = (unsigned long)std::ceil(home_time/dt);
+  servo_timeout = (unsigned long)std::ceil(timeout/dt);
+  state_period  = state_rate > 0 ? (unsigned long)std::ceil(1.0/(state_rate*dt)) : 0;
+
+  // in lockstep the clients wait for every step's operating_state as well
+  // as its measured_* (see CRTK_rt_loop::follow)
+  bool lockstep = false;
+  n.getParam("lockstep", lockstep);
+  if(lockstep)
+    state_period = 1;
+
+  ROS_INFO("Simulating %s (%d joints) and %s at %.0f Hz.", robot_name.c_str(), num_joints, grasper_name.c_str(), 1.0/dt);
+  return true;
+}
+
+
+
+/**
+ * @brief      Sets up publishers, subscribers and the pre-sized measured_*
+ *             messages
+ *
+ * @param[in]  n     ROS node handle
+ *
+ * @return     success
+ */
+bool CRTK_sim_robot::init_ros(ros::NodeHandle n){
+  std::string topic;
+  std::string robot = "/" + robot_name + "/";
+  std::string grasp = "/" + grasper_name + "/";
+
+  pub_operating_state   = n.advertise<crtk_msgs::operating_state>(robot + "operating_state", 1, true);
+  pub_measured_js       = n.advertise<sensor_msgs::JointState>(robot + "measured_js", 1);
+  pub_measured_cp       = n.advertise<geometry_msgs::TransformStamped>(robot + "measured_cp", 1);
+  pub_measured_js_grasp = n.advertise<sensor_msgs::JointState>(grasp + "measured_js", 1);
+
+  topic = robot + "state_command";
+  sub_state_command = n.subscribe(topic, 10, &CRTK_sim_robot::state_command_cb, this, CRTK_transport::hints(n, topic));
+
+  topic = robot + "servo_cr";
+  sub_servo_cr = n.subscribe(topic, 1, &CRTK_sim_robot::servo_cr_cb, this, CRTK_transport::hints(n, topic));
+  topic = robot + "servo_cp";
+  sub_servo_cp = n.subscribe(topic, 1, &CRTK_sim_robot::servo_cp_cb, this, CRTK_transport::hints(n, topic));
+  topic = robot + "servo_cv";
+  sub_servo_cv = n.subscribe(topic, 1, &CRTK_sim_robot::servo_cv_cb, this, CRTK_transport::hints(n, topic));
+  topic = robot + "servo_jr";
+  sub_servo_jr = n.subscribe(topic, 1, &CRTK_sim_robot::servo_jr_cb, this, CRTK_transport::hints(n, topic));
+  topic = robot + "servo_jp";
+  sub_servo_jp = n.subscribe(topic, 1, &CRTK_sim_robot::servo_jp_cb, this, CRTK_transport::hints(n, topic));
+  topic = robot + "servo_jv";
+  sub_servo_jv = n.subscribe(topic, 1, &CRTK_sim_robot::servo_jv_cb, this, CRTK_transport::hints(n, topic));
+  topic = grasp + "servo_jr";
+  sub_servo_jr_grasp = n.subscribe(topic, 1, &CRTK_sim_robot::servo_jr_grasp_cb, this, CRTK_transport::hints(n, topic));
+  topic = grasp + "servo_jp";
+  sub_servo_jp_grasp = n.subscribe(topic, 1, &CRTK_sim_robot::servo_jp_grasp_cb, this, CRTK_transport::hints(n, topic));
+  topic = grasp + "servo_jv";
+  sub_servo_jv_grasp = n.subscribe(topic, 1, &CRTK_sim_robot::servo_jv_grasp_cb, this, CRTK_transport::hints(n, topic));
+
+  sensor_msgs::JointState js;
+  js.name.resize(num_joints);
+  js.position.resize(num_joints);
+  js.velocity.resize(num_joints);
+  js.effort.resize(num_joints);
+  for(int i=0;i<num_joints;i++){
+    char name[16];
+    snprintf(name, sizeof(name), "joint_%d", i);
+    js.name[i] = name;
+  }
+  pool_measured_js.init(js);
+
+  sensor_msgs::JointState js_grasp;
+  js_grasp.name.push_back("grasp");
+  js_grasp.position.resize(1);
+  js_grasp.velocity.resize(1);
+  js_grasp.effort.resize(1);
+  pool_measured_js_grasp.init(js_grasp);
+
+  geometry_msgs::TransformStamped cp;
+  cp.header.frame_id = robot_name + "_base";
+  cp.child_frame_id = robot_name;
+  pool_measured_cp.init(cp);
+
+  return true;
+}
+
+
+
+/**
+ * @brief      Advances the robot by one 1/rate step: finishes homing when
+ *             its time is up, integrates servo_*v commands into the goals
+ *             and moves every joint and the pose towards its goal.
+ */
+void CRTK_sim_robot::step(){
+  tick++;
+
+  if(is_busy && tick >= busy_until){
+    // homing ends exactly at home
+    stop_homing();
+    is_homed = 1;
+    for(int i=0;i<=num_joints;i++){
+      joints[i].pos = joints[i].goal;
+      joints[i].vel = 0;
+    }
+    cart_pos = cart_goal;
+    state_changed = 1;
+    ROS_INFO("%s homed.", robot_name.c_str());
+  }
+
+  for(int i=0;i<num_joints;i++)
+    step_joint(&joints[i], max_jvel);
+  step_joint(&joints[num_joints], max_grasp_vel);
+  step_cart();
+}
+
+
+
+/**
+ * @brief      Moves a joint one step towards its goal: a first-order lag of
+ *             time constant tau, limited to max_vel
+ *
+ * @param      j        The joint
+ * @param[in]  max_vel  The speed limit
+ */
+void CRTK_sim_robot::step_joint(CRTK_sim_joint *j, double max_vel){
+  if(tick <= j->vel_until)
+    j->goal += j->vel_cmd*dt;
+
+  double v = (j->goal - j->pos)*(1.0 - std::exp(-dt/tau))/dt;
+  if(v > max_vel)  v = max_vel;
+  if(v < -max_vel) v = -max_vel;
+
+  j->pos += v*dt;
+  j->vel = v;
+}
+
+
+
+/**
+ * @brief      Moves the pose one step towards its goal. Translation is
+ *             lagged and speed limited like a joint; orientation is lagged
+ *             along the shortest rotation.
+ */
+void CRTK_sim_robot::step_cart(){
+  double alpha = 1.0 - std::exp(-dt/tau);
+
+  if(tick <= cart_vel_until){
+    cart_goal.setOrigin(cart_goal.getOrigin() + cart_lin_vel*dt);
+    if(cart_ang_vel != 0)
+      cart_goal.setRotation((tf::Quaternion(cart_ang_axis, cart_ang_vel*dt)*cart_goal.getRotation()).normalized());
+  }
+
+  tf::Vector3 move = (cart_goal.getOrigin() - cart_pos.getOrigin())*alpha;
+  double len = move.length();
+  if(len > max_vel*dt)
+    move = move*(max_vel*dt/len);
+  cart_pos.setOrigin(cart_pos.getOrigin() + move);
+  cart_pos.setRotation(cart_pos.getRotation().slerp(cart_goal.getRotation(), alpha).normalized());
+}
+
+
+
+/**
+ * @brief      Publishes measured_js (arm and grasper) and measured_cp, and
+ *             operating_state on change and every 1/state_rate.
+ *
+ * @param[in]  stamp  The stamp
+ */
+void CRTK_sim_robot::publish(const ros::Time& stamp){
+  sensor_msgs::JointState::Ptr js = pool_measured_js.get();
+  js->header.stamp = stamp;
+  for(int i=0;i<num_joints;i++){
+    js->position[i] = joints[i].pos;
+    js->velocity[i] = joints[i].vel;
+    js->effort[i]   = 0;
+  }
+  pub_measured_js.publish(js);
+
+  sensor_msgs::JointState::Ptr js_grasp = pool_measured_js_grasp.get();
+  js_grasp->header.stamp = stamp;
+  js_grasp->position[0] = joints[num_joints].pos;
+  js_grasp->velocity[0] = joints[num_joints].vel;
+  js_grasp->effort[0]   = 0;
+  pub_measured_js_grasp.publish(js_grasp);
+
+  geometry_msgs::TransformStamped::Ptr cp = pool_measured_cp.get();
+  cp->header.stamp = stamp;
+  tf::transformTFToMsg(cart_pos, cp->transform);
+  pub_measured_cp.publish(cp);
+
+  if(state_changed || (state_period && tick % state_period == 0))
+    publish_operating_state(stamp);
+}
+
+
+
+/**
+ * @brief      Publishes operating_state
+ *
+ * @param[in]  stamp  The stamp
+ */
+void CRTK_sim_robot::publish_operating_state(const ros::Time& stamp){
+  crtk_msgs::operating_state msg;
+  msg.header.stamp = stamp;
+  switch(state){
+    case CRTK_ENABLED:  msg.state = "ENABLED";  break;
+    case CRTK_DISABLED: msg.state = "DISABLED"; break;
+    case CRTK_PAUSED:   msg.state = "PAUSED";   break;
+    default:            msg.state = "FAULT";    break;
+  }
+  msg.is_homed = is_homed;
+  msg.is_busy  = is_busy;
+  pub_operating_state.publish(msg);
+  state_changed = 0;
+}
+
+
+
+/**
+ * @brief      Applies a state_command. The Raven's start button press is
+ *             taken as given, so enable and home act at once:
+ *               enable   disabled -> enabled, homing first if not homed
+ *               home     disabled/enabled -> enabled and homing
+ *               pause    enabled -> paused
+ *               resume   paused -> enabled
+ *               disable  any -> disabled
+ *               unhome   any -> disabled, not homed
+ *             Leaving enabled while homing leaves the robot not homed.
+ *
+ * @param[in]  event  The message and its publisher
+ */
+void CRTK_sim_robot::state_command_cb(const ros::MessageEvent<crtk_msgs::StringStamped const>& event){
+  crtk_msgs::StringStamped::ConstPtr msg = event.getConstMessage();
+  received[event.getPublisherName()]++;
+  const std::string &cmd = msg->string;
+
+  if(cmd == "enable"){
+    if(state == CRTK_DISABLED){
+      set_state(CRTK_ENABLED);
+      if(!is_homed)
+        start_homing();
+    }
+  }
+  else if(cmd == "home"){
+    if(state == CRTK_DISABLED || state == CRTK_ENABLED){
+      set_state(CRTK_ENABLED);
+      start_homing();
+    }
+  }
+  else if(cmd == "pause"){
+    if(state == CRTK_ENABLED)
+      set_state(CRTK_PAUSED);
+  }
+  else if(cmd == "resume"){
+    if(state == CRTK_PAUSED)
+      set_state(CRTK_ENABLED);
+  }
+  else if(cmd == "disable"){
+    set_state(CRTK_DISABLED);
+  }
+  else if(cmd == "unhome"){
+    set_state(CRTK_DISABLED);
+    is_homed = 0;
+  }
+  else{
+    ROS_WARN("Unknown state_command '%s'.", cmd.c_str());
+    return;
+  }
+  state_changed = 1;
+  ROS_INFO("state_command %s: %s%s%s", cmd.c_str(),
+    state == CRTK_ENABLED ? "ENABLED" : state == CRTK_PAUSED ? "PAUSED" : "DISABLED",
+    is_homed ? ", homed" : "", is_busy ? ", busy" : "");
+}
+
+
+
+/**
+ * @brief      Changes the operating state. Anything but enabled stops the
+ *             arm where it is and aborts homing.
+ *
+ * @param[in]  new_state  The new state
+ */
+void CRTK_sim_robot::set_state(CRTK_robot_state_enum new_state){
+  state = new_state;
+  if(state != CRTK_ENABLED){
+    if(is_busy){
+      stop_homing();
+      is_homed = 0;
+    }
+    hold();
+  }
+}
+
+
+
+/**
+ * @brief      Starts homing: busy for home_time while moving to the home pose
+ */
+void CRTK_sim_robot::start_homing(){
+  is_busy = 1;
+  is_homed = 0;
+  busy_until = tick + home_ticks;
+
+  hold();
+  for(int i=0;i<num_joints;i++)
+    joints[i].goal = home_jpos[i];
+  joints[num_joints].goal = home_grasp;
+  cart_goal = home_pos;
+}
+
+
+
+/**
+ * @brief      Ends homing, finished or not
+ */
+void CRTK_sim_robot::stop_homing(){
+  is_busy = 0;
+  busy_until = 0;
+}
+
+
+
+/**
+ * @brief      Stops every joint and the pose where they are
+ */
+void CRTK_sim_robot::hold(){
+  for(int i=0;i<=num_joints;i++){
+    joints[i].goal = joints[i].pos;
+    joints[i].vel_until = 0;
+  }
+  cart_goal = cart_pos;
+  cart_vel_until = 0;
+}
+
+
+
+/**
+ * @brief      Whether servo_* commands are followed: enabled, homed and not
+ *             busy, and a joint command of the right length. Counts the
+ *             ones ignored.
+ *
+ * @param[in]  length  The joint command length, -1 if not a joint command
+ *
+ * @return     true if the command should be applied
+ */
+bool CRTK_sim_robot::accepting(int length){
+  if(state != CRTK_ENABLED || !is_homed || is_busy){
+    ignored++;
+    return false;
+  }
+  if(length >= 0 && length != num_joints){
+    ignored++;
+    ROS_ERROR_THROTTLE(1, "servo_j* size incorrect (expected %d, got %d).", num_joints, length);
+    return false;
+  }
+  return true;
+}
+
+
+
+/**
+ * @brief      servo_cr: moves the goal pose by a translation and rotation
+ *
+ * @param[in]  event  The message and its publisher
+ */
+void CRTK_sim_robot::servo_cr_cb(const ros::MessageEvent<geometry_msgs::TransformStamped const>& event){
+  geometry_msgs::TransformStamped::ConstPtr msg = event.getConstMessage();
+  received[event.getPublisherName()]++;
+  if(!accepting()) return;
+  tf::Transform in;
+  tf::transformMsgToTF(msg->transform, in);
+  cart_goal.setOrigin(cart_goal.getOrigin() + in.getOrigin());
+  cart_goal.setRotation((in.getRotation()*cart_goal.getRotation()).normalized());
+}
+
+
+
+/**
+ * @brief      servo_cp: sets the goal pose
+ *
+ * @param[in]  event  The message and its publisher
+ */
+void CRTK_sim_robot::servo_cp_cb(const ros::MessageEvent<geometry_msgs::TransformStamped const>& event){
+  geometry_msgs::TransformStamped::ConstPtr msg = event.getConstMessage();
+  received[event.getPublisherName()]++;
+  if(!accepting()) return;
+  tf::transformMsgToTF(msg->transform, cart_goal);
+  cart_vel_until = 0;
+}
+
+
+
+/**
+ * @brief      servo_cv: moves the goal pose at a velocity (translation in
+ *             m/s, rotation as the turn per second) for servo_timeout
+ *
+ * @param[in]  event  The message and its publisher
+ */
+void CRTK_sim_robot::servo_cv_cb(const ros::MessageEvent<geometry_msgs::TransformStamped const>& event){
+  geometry_msgs::TransformStamped::ConstPtr msg = event.getConstMessage();
+  received[event.getPublisherName()]++;
+  if(!accepting()) return;
+  tf::Transform in;
+  tf::transformMsgToTF(msg->transform, in);
+  tf::Quaternion q = in.getRotation();
+  cart_lin_vel  = in.getOrigin();
+  cart_ang_vel  = q.getAngleShortestPath();
+  cart_ang_axis = q.getAxis();
+  if(q.w() < 0)
+    cart_ang_axis = -cart_ang_axis;
+  cart_vel_until = tick + servo_timeout;
+}
+
+
+
+/**
+ * @brief      servo_jr: moves the joint goals by an increment
+ *
+ * @param[in]  event  The message and its publisher
+ */
+void CRTK_sim_robot::servo_jr_cb(const ros::MessageEvent<sensor_msgs::JointState const>& event){
+  sensor_msgs::JointState::ConstPtr msg = event.getConstMessage();
+  received[event.getPublisherName()]++;
+  if(!accepting(msg->position.size())) return;
+  for(int i=0;i<num_joints;i++)
+    joints[i].goal += msg->position[i];
+}
+
+
+
+/**
+ * @brief      servo_jp: sets the joint goals
+ *
+ * @param[in]  event  The message and its publisher
+ */
+void CRTK_sim_robot::servo_jp_cb(const ros::MessageEvent<sensor_msgs::JointState const>& event){
+  sensor_msgs::JointState::ConstPtr msg = event.getConstMessage();
+  received[event.getPublisherName()]++;
+  if(!accepting(msg->position.size())) return;
+  for(int i=0;i<num_joints;i++){
+    joints[i].goal = msg->position[i];
+    joints[i].vel_until = 0;
+  }
+}
+
+
+
+/**
+ * @brief      servo_jv: moves the joint goals at a velocity for servo_timeout
+ *
+ * @param[in]  event  The message and its publisher
+ */
+void CRTK_sim_robot::servo_jv_cb(const ros::MessageEvent<sensor_msgs::JointState const>& event){
+  sensor_msgs::JointState::ConstPtr msg = event.getConstMessage();
+  received[event.getPublisherName()]++;
+  if(!accepting(msg->velocity.size())) return;
+  for(int i=0;i<num_joints;i++){
+    joints[i].vel_cmd = msg->velocity[i];
+    joints[i].vel_until = tick + servo_timeout;
+  }
+}
+
+
+
+/**
+ * @brief      servo_jr for the grasper
+ *
+ * @param[in]  event  The message and its publisher
+ */
+void CRTK_sim_robot::servo_jr_grasp_cb(const ros::MessageEvent<sensor_msgs::JointState const>& event){
+  sensor_msgs::JointState::ConstPtr msg = event.getConstMessage();
+  received[event.getPublisherName()]++;
+  if(!accepting() || msg->position.empty()) return;
+  joints[num_joints].goal += msg->position[0];
+}
+
+
+
+/**
+ * @brief      servo_jp for the grasper
+ *
+ * @param[in]  event  The message and its publisher
+ */
+void CRTK_sim_robot::servo_jp_grasp_cb(const ros::MessageEvent<sensor_msgs::JointState const>& event){
+  sensor_msgs::JointState::ConstPtr msg = event.getConstMessage();
+  received[event.getPublisherName()]++;
+  if(!accepting() || msg->position.empty()) return;
+  joints[num_joints].goal = msg->position[0];
+  joints[num_joints].vel_until = 0;
+}
+
+
+
+/**
+ * @brief      servo_jv for the grasper
+ *
+ * @param[in]  event  The message and its publisher
+ */
+void CRTK_sim_robot::servo_jv_grasp_cb(const ros::MessageEvent<sensor_msgs::JointState const>& event){
+  sensor_msgs::JointState::ConstPtr msg = event.getConstMessage();
+  received[event.getPublisherName()]++;
+  if(!accepting() || msg->velocity.empty()) return;
+  joints[num_joints].vel_cmd = msg->velocity[0];
+  joints[num_joints].vel_until = tick + servo_timeout;
+}
+
+
+
+/**
+ * @brief      Gets the operating state.
+ *
+ * @return     The state.
+ */
+CRTK_robot_state_enum CRTK_sim_robot::get_state(){
+  return state;
+}
+
+
+
+/**
+ * @brief      Gets the homed flag.
+ *
+ * @return     The homed flag.
+ */
+bool CRTK_sim_robot::get_homed(){
+  return is_homed;
+}
+
+
+
+/**
+ * @brief      Gets the busy flag.
+ *
+ * @return     The busy flag.
+ */
+bool CRTK_sim_robot::get_busy(){
+  return is_busy;
+}
+
+
+
+/**
+ * @brief      Gets the number of servo_* commands ignored because the robot
+ *             was not enabled and homed, or the size was wrong.
+ *
+ * @return     The ignored count.
+ */
+unsigned long CRTK_sim_robot::get_ignored(){
+  return ignored;
+}
+
+
+
+/**
+ * @brief      Gets the number of commands (servo_* and state_command)
+ *             received from a node, ignored or not
+ *
+ * @param[in]  node  The publishing node name
+ *
+ * @return     The count
+ */
+unsigned long CRTK_sim_robot::get_received(const std::string& node){
+  std::map<std::string, unsigned long>::iterator it = received.find(node);
+  return it == received.end() ? 0 : it->second;
+}
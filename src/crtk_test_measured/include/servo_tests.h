@@ -37,7 +37,7 @@
 
 
 // This function loops through all the crtk tests
-int servo_testing(CRTK_robot*, time_t);
+int servo_testing(CRTK_robot*, ros::Time);
 
 // 1 Motion measured query testing
 //    1-1 (measured_js functionality) Move all joints in series manually.
@@ -45,7 +45,7 @@ int servo_testing(CRTK_robot*, time_t);
 //      Pass: Check that each joint velocity has a non-zero value.
 //    1-2 (measured_cp functionality) Move tool to the right manually.
 //      Pass: Check that the correct axis has been mostly moved in.
-int test_1(CRTK_robot *, time_t);
+int test_1(CRTK_robot *, ros::Time);
 
 
 #endif
\ No newline at end of file
@@ -38,6 +38,7 @@
 #include <crtk_lib_cpp/crtk_robot_state.h>
 #include <crtk_lib_cpp/crtk_robot.h>
 #include <crtk_lib_cpp/crtk_motion.h>
+#include <crtk_lib_cpp/crtk_suite.h>
 #include <crtk_msgs/operating_state.h>
 #include <crtk_msgs/StringStamped.h>
 #include <sstream>
@@ -71,28 +72,30 @@ using namespace std;
 int main(int argc, char **argv)
 {
 
-  time_t current_time;
+  ros::Time current_time;
   ros::init(argc, argv, "crtk_test_servo_all");
   static ros::NodeHandle n("~"); 
-  ros::Rate loop_rate(LOOP_RATE); 
+  CRTK_suite::init(n);
+  CRTK_rt_loop loop_rate(n, LOOP_RATE); 
 
   std::string r_space;
   if(!n.getParam("r_space", r_space))
     ROS_ERROR("No Robot namespace provided in command line!");
   CRTK_robot robot(n,r_space);
+  loop_rate.follow(&robot);
 
   int count = 0;
 
   ROS_INFO("Please launch stand alone roscore.");
   while (ros::ok()){
-    current_time = time(NULL);
+    current_time = CRTK_clock::now();
     servo_testing(&robot, current_time);
     robot.run();
     ros::spinOnce();
     loop_rate.sleep();
     ++count;
   }
-  return 0;
+  return CRTK_suite::exit_code();
 }
 
 
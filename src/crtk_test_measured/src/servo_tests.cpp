@@ -36,6 +36,8 @@
 #include <crtk_msgs/operating_state.h>
 #include <crtk_msgs/StringStamped.h>
 #include <crtk_lib_cpp/crtk_robot_state.h>
+#include <crtk_lib_cpp/crtk_confirm.h>
+#include <crtk_lib_cpp/crtk_suite.h>
 #include <sstream>
 #include <ctime>
 #include <iostream>
@@ -60,8 +62,8 @@ static int start_test = 1;
  *
  * @return     errors
  */
-int servo_testing( CRTK_robot* robot, time_t current_time){
-  static time_t start_time = current_time;
+int servo_testing( CRTK_robot* robot, ros::Time current_time){
+  static ros::Time start_time = current_time;
   static int current_test = 0;
   static int finished = 0;
   static int errors = 0;
@@ -75,7 +77,7 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
   }
 
   // wait for a beat
-  if (current_time - start_time < 2){
+  if ((current_time - start_time).toSec() < 2){
         return 0;
   }
   else if (current_test == 0 && !finished){
@@ -97,10 +99,12 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         errors += 1;
         current_test ++;
         ROS_ERROR("test_1 fail: %i", test_status);
+        CRTK_suite::result("test_1", test_status);
       }
       else if (test_status > 0) {
         current_test ++;
         ROS_INFO("test_1 passed: %i", test_status);
+        CRTK_suite::result("test_1", test_status);
       }
       break;
     }
@@ -112,6 +116,7 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         robot->state.crtk_command_pb(command);
         ROS_ERROR("We failed some things.");
         finished = 1;
+        CRTK_suite::done(errors);
       }
       else if(finished == 0 && errors == 0){
         // After all tests, send estop command!
@@ -119,6 +124,7 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         robot->state.crtk_command_pb(command);
         ROS_INFO("We finished everything. Good job!!");
         finished = 1;
+        CRTK_suite::done(errors);
       }
     }
 
@@ -145,11 +151,10 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
  *
  * @return     success
  */
-int test_1(CRTK_robot *robot, time_t current_time){
+int test_1(CRTK_robot *robot, ros::Time current_time){
   static int current_step = 1;
-  static time_t pause_start;
+  static ros::Time pause_start;
   int out=0;
-  std::string start;
   float pos_thresh = 10 DEG_TO_RAD;
   float vel_thresh = 10 DEG_TO_RAD;
 
@@ -182,8 +187,7 @@ int test_1(CRTK_robot *robot, time_t current_time){
     case 4:
     {
       // (4) wait for 'Enter' key press
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
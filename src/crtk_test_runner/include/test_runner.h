@@ -0,0 +1,109 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * test_runner.h
+ *
+ * \brief Runs the crtk_test_* suites concurrently, each against its own
+ *  crtk_sim robot. A pool of workers, each with its own robot and grasper
+ *  namespaces, takes suites from a shared queue: start the simulator,
+ *  enable it, run the suite in scripted mode (_confirm:=auto
+ *  _exit_when_done:=true) and read the per-test results it writes (see
+ *  crtk_suite.h). Results and
+ *  timing from every suite go into one JUnit and one JSON report.
+ *
+ *  With lockstep set, every simulator drives its own sim clock
+ *  (/<r_space>/clock) and the suite follows it, so suites run as fast as
+ *  the CPU allows instead of in real time.
+ *
+ *  \date Oct 16, 2026
+ */
+
+#ifndef CRTK_TEST_RUNNER_H_
+#define CRTK_TEST_RUNNER_H_
+
+#include <ros/ros.h>
+#include <sys/types.h>
+#include <string>
+#include <vector>
+#include <mutex>
+
+struct CRTK_test_case{
+  std::string name;
+  int status;              // > 0 passed, < 0 failed
+  double time;             // s
+};
+
+struct CRTK_suite_job{
+  std::string suite;       // package, same as the executable
+  std::string r_space;
+  std::string log;
+  double time;             // s
+  int exit_code;
+  bool timed_out;
+  bool finished;           // the suite reported its end
+  std::vector<CRTK_test_case> tests;
+
+  int failures() const;
+  bool passed() const;
+};
+
+class CRTK_test_runner{
+public:
+  CRTK_test_runner(ros::NodeHandle n);
+  ~CRTK_test_runner(){};
+
+  int run();
+
+private:
+  void worker(int id);
+  std::string r_space_of(int id);
+  std::string grasper_of(const std::string& r_space);
+  bool check_namespaces();
+  void run_job(CRTK_suite_job*, const std::string& r_space);
+  bool enable_sim(const std::string& r_space);
+  pid_t spawn(const std::vector<std::string>& args, const std::string& log);
+  int wait_for(pid_t pid, double timeout, bool *timed_out);
+  void stop(pid_t pid);
+  void read_results(CRTK_suite_job*, const std::string& file);
+  void write_junit(double wall_time);
+  void write_json(double wall_time);
+
+  ros::NodeHandle n;
+
+  // parameters
+  std::vector<std::string> suites;
+  int workers;
+  double timeout;          // s per suite
+  double enable_timeout;   // s for the simulator to come up enabled and homed
+  bool lockstep;
+  bool had_sim_time;       // /use_sim_time was already set before the run
+  std::string ns_prefix;
+  std::string log_dir;
+  std::string junit_file;
+  std::string json_file;
+
+  std::vector<CRTK_suite_job> jobs;
+  size_t next_job;
+  std::mutex mtx;
+};
+
+#endif
@@ -0,0 +1,57 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * main.cpp
+ *
+ * \brief Parallel runner for the crtk_test_* suites against crtk_sim. Needs
+ *  a running roscore.
+ *
+ *  rosrun crtk_test_runner crtk_test_runner _workers:=4
+ *
+ *  \date Oct 16, 2026
+ */
+
+#include "test_runner.h"
+
+
+
+/**
+ * @brief      The main function
+ *
+ * @param[in]  argc  The argc
+ * @param      argv  The argv
+ *
+ * @return     0 if every suite passed, 1 otherwise
+ */
+int main(int argc, char **argv)
+{
+  ros::init(argc, argv, "crtk_test_runner");
+  static ros::NodeHandle n("~");
+  ros::AsyncSpinner spinner(2);
+  spinner.start();
+
+  CRTK_test_runner runner(n);
+  int failed = runner.run();
+
+  spinner.stop();
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,604 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford, 
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * test_runner.cpp
+ *
+ * \brief Class file for the parallel CRTK test suite runner
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include "test_runner.h"
+#include <crtk_lib_cpp/crtk_robot_state.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+namespace {
+
+const char *default_suites[] = {
+  "crtk_test_measured",
+  "crtk_test_servo_jp",
+  "crtk_test_servo_jr",
+  "crtk_test_servo_jv",
+  "crtk_test_servo_cp",
+  "crtk_test_servo_cr",
+  "crtk_test_servo_cv",
+};
+
+std::string xml_escape(const std::string& in){
+  std::string out;
+  for(size_t i=0; i<in.size(); i++){
+    switch(in[i]){
+      case '&':  out += "&amp;";  break;
+      case '<':  out += "&lt;";   break;
+      case '>':  out += "&gt;";   break;
+      case '"':  out += "&quot;"; break;
+      default:   out += in[i];
+    }
+  }
+  return out;
+}
+
+std::string json_escape(const std::string& in){
+  std::string out;
+  for(size_t i=0; i<in.size(); i++){
+    if(in[i] == '"' || in[i] == '\\')
+      out += '\\';
+    out += in[i];
+  }
+  return out;
+}
+
+}
+
+
+
+/**
+ * @brief      Counts the failed tests
+ *
+ * @return     The number of failed tests
+ */
+int CRTK_suite_job::failures() const{
+  int out = 0;
+  for(size_t i=0; i<tests.size(); i++){
+    if(tests[i].status <= 0)
+      out++;
+  }
+  return out;
+}
+
+
+
+/**
+ * @brief      Whether the suite ran to the end and every test passed
+ *
+ * @return     true if passed
+ */
+bool CRTK_suite_job::passed() const{
+  return finished && !timed_out && exit_code == 0 && failures() == 0;
+}
+
+
+
+/**
+ * @brief      Reads the runner parameters
+ *
+ * @param[in]  n     ros node handle the parameters are read from
+ */
+CRTK_test_runner::CRTK_test_runner(ros::NodeHandle n):n(n){
+  if(!n.getParam("suites", suites))
+    suites.assign(default_suites, default_suites + sizeof(default_suites)/sizeof(default_suites[0]));
+
+  workers = std::max(1, (int)std::thread::hardware_concurrency() / 2);
+  n.getParam("workers", workers);
+  workers = std::max(1, std::min(workers, (int)suites.size()));
+
+  timeout         = 600;
+  enable_timeout  = 30;
+  ns_prefix       = "sim_arm";
+  log_dir         = "/tmp/crtk_test_runner";
+  lockstep        = 0;
+  n.getParam("timeout", timeout);
+  n.getParam("lockstep", lockstep);
+  n.getParam("enable_timeout", enable_timeout);
+  n.getParam("ns_prefix", ns_prefix);
+  n.getParam("log_dir", log_dir);
+  junit_file      = log_dir + "/results.xml";
+  json_file       = log_dir + "/results.json";
+  n.getParam("junit_file", junit_file);
+  n.getParam("json_file", json_file);
+
+  if(mkdir(log_dir.c_str(), 0755) && errno != EEXIST)
+    ROS_ERROR("Could not create log_dir %s.", log_dir.c_str());
+
+  // nodes read /use_sim_time when they start, so set it before any of them
+  bool sim_time = false;
+  had_sim_time = ros::param::get("/use_sim_time", sim_time) && sim_time;
+  if(lockstep)
+    ros::param::set("/use_sim_time", true);
+
+  jobs.resize(suites.size());
+  for(size_t i=0; i<suites.size(); i++){
+    jobs[i].suite     = suites[i];
+    jobs[i].time      = 0;
+    jobs[i].exit_code = -1;
+    jobs[i].timed_out = 0;
+    jobs[i].finished  = 0;
+  }
+  next_job = 0;
+}
+
+
+
+/**
+ * @brief      Runs every suite on the worker pool and writes the reports
+ *
+ * @return     The number of suites that did not pass
+ */
+int CRTK_test_runner::run(){
+  ros::WallTime start = ros::WallTime::now();
+  ROS_INFO("Running %i suites on %i workers%s.", (int)jobs.size(), workers, lockstep ? " in lockstep" : "");
+  if(!check_namespaces())
+    return jobs.size();
+
+  std::vector<std::thread> pool;
+  for(int i=0; i<workers; i++)
+    pool.push_back(std::thread(&CRTK_test_runner::worker, this, i));
+  for(size_t i=0; i<pool.size(); i++)
+    pool[i].join();
+  if(lockstep && !had_sim_time)
+    ros::param::del("/use_sim_time");
+
+  double wall_time = (ros::WallTime::now() - start).toSec();
+  double suite_time = 0;
+  int failed = 0;
+  for(size_t i=0; i<jobs.size(); i++){
+    const CRTK_suite_job &job = jobs[i];
+    suite_time += job.time;
+    if(!job.passed())
+      failed++;
+    ROS_INFO("%-20s %s  %3i/%-3i tests passed  %7.1f s%s", job.suite.c_str(),
+      job.passed() ? "PASS" : "FAIL", (int)job.tests.size() - job.failures(),
+      (int)job.tests.size(), job.time, job.timed_out ? "  (timed out)" : "");
+  }
+  ROS_INFO("%i/%i suites passed in %.1f s wall time (%.1f s of suites, %.1fx).",
+    (int)jobs.size() - failed, (int)jobs.size(), wall_time, suite_time,
+    wall_time > 0 ? suite_time / wall_time : 0);
+
+  write_junit(wall_time);
+  write_json(wall_time);
+  return failed;
+}
+
+
+
+/**
+ * @brief      Takes suites from the queue until it is empty. Each worker
+ *             owns one robot namespace, so its simulators never collide
+ *             with another worker's.
+ *
+ * @param[in]  id    The worker index
+ */
+void CRTK_test_runner::worker(int id){
+  std::string r_space = r_space_of(id);
+
+  while(ros::ok()){
+    CRTK_suite_job *job;
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      if(next_job >= jobs.size())
+        return;
+      job = &jobs[next_job++];
+    }
+    run_job(job, r_space);
+  }
+}
+
+
+
+/**
+ * @brief      Gets the robot namespace of a worker
+ *
+ * @param[in]  id    The worker index
+ *
+ * @return     The robot namespace
+ */
+std::string CRTK_test_runner::r_space_of(int id){
+  std::stringstream r_space;
+  r_space << ns_prefix << id + 1;
+  return r_space.str();
+}
+
+
+
+/**
+ * @brief      Gets the grasper namespace of a worker's simulator
+ *
+ * @param[in]  r_space  The robot namespace of the worker
+ *
+ * @return     The grasper namespace
+ */
+std::string CRTK_test_runner::grasper_of(const std::string& r_space){
+  return r_space + "_grasp";
+}
+
+
+
+/**
+ * @brief      Checks that no two workers share a topic: every namespace a
+ *             worker's simulator and suite use (robot, grasper, and the
+ *             clock topics under the robot) must be neither the same as
+ *             nor nested in one of another worker's.
+ *
+ * @return     true if the workers are independent
+ */
+bool CRTK_test_runner::check_namespaces(){
+  std::vector<std::string> names;
+  std::vector<int> owner;
+  for(int i=0; i<workers; i++){
+    names.push_back("/" + r_space_of(i) + "/");
+    names.push_back("/" + grasper_of(r_space_of(i)) + "/");
+    owner.push_back(i);
+    owner.push_back(i);
+  }
+
+  for(size_t i=0; i<names.size(); i++){
+    for(size_t j=i+1; j<names.size(); j++){
+      if(owner[i] == owner[j])
+        continue;
+      const std::string &a = names[i].size() < names[j].size() ? names[i] : names[j];
+      const std::string &b = names[i].size() < names[j].size() ? names[j] : names[i];
+      if(b.compare(0, a.size(), a) == 0){
+        ROS_ERROR("Workers %i and %i would share topics under %s (ns_prefix %s), not running.",
+          owner[i] + 1, owner[j] + 1, a.c_str(), ns_prefix.c_str());
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+
+
+/**
+ * @brief      Runs one suite against a fresh simulator
+ *
+ * @param      job      The suite
+ * @param[in]  r_space  The robot namespace of the worker
+ */
+void CRTK_test_runner::run_job(CRTK_suite_job *job, const std::string& r_space){
+  std::string results = log_dir + "/" + job->suite + ".jsonl";
+  job->r_space = r_space;
+  job->log     = log_dir + "/" + job->suite + ".log";
+  unlink(results.c_str());
+
+  ROS_INFO("[%s] %s starting.", r_space.c_str(), job->suite.c_str());
+  ros::WallTime start = ros::WallTime::now();
+
+  std::vector<std::string> sim_args;
+  sim_args.push_back("roslaunch");
+  sim_args.push_back("crtk_sim");
+  sim_args.push_back("sim.launch");
+  sim_args.push_back("r_space:=" + r_space);
+  sim_args.push_back("grasper_name:=" + grasper_of(r_space));
+  if(lockstep){
+    sim_args.push_back("lockstep:=true");
+    sim_args.push_back("clock:=/" + r_space + "/clock");
+    sim_args.push_back("clock_ack:=/" + r_space + "/clock_ack");
+  }
+  pid_t sim = spawn(sim_args, log_dir + "/" + job->suite + "_sim.log");
+  if(sim < 0)
+    return;
+
+  if(enable_sim(r_space)){
+    std::vector<std::string> args;
+    args.push_back("rosrun");
+    args.push_back(job->suite);
+    args.push_back(job->suite);
+    args.push_back("__name:=" + job->suite + "_" + r_space);
+    args.push_back("_r_space:=" + r_space);
+    args.push_back("_confirm:=auto");
+    args.push_back("_exit_when_done:=true");
+    args.push_back("_result_file:=" + results);
+    if(lockstep){
+      args.push_back("/clock:=/" + r_space + "/clock");
+      args.push_back("/clock_ack:=/" + r_space + "/clock_ack");
+    }
+    pid_t test = spawn(args, job->log);
+    if(test >= 0)
+      job->exit_code = wait_for(test, timeout, &job->timed_out);
+  }
+  else{
+    ROS_ERROR("[%s] Simulator not enabled after %.0f s, skipping %s.",
+      r_space.c_str(), enable_timeout, job->suite.c_str());
+  }
+
+  stop(sim);
+  job->time = (ros::WallTime::now() - start).toSec();
+  read_results(job, results);
+  ROS_INFO("[%s] %s %s in %.1f s.", r_space.c_str(), job->suite.c_str(),
+    job->passed() ? "passed" : "failed", job->time);
+}
+
+
+
+/**
+ * @brief      Waits for the simulator to come up, then enables it and waits
+ *             until it is homed and ready, as an operator would before
+ *             starting a suite.
+ *
+ * @param[in]  r_space  The robot namespace
+ *
+ * @return     true if the robot is ready
+ */
+bool CRTK_test_runner::enable_sim(const std::string& r_space){
+  CRTK_robot_state state(n, r_space);
+  ros::WallTime start = ros::WallTime::now();
+  ros::WallTime sent;
+
+  while(ros::ok() && (ros::WallTime::now() - start).toSec() < enable_timeout){
+    if(state.get_ready())
+      return 1;
+    if(state.get_connected() && (ros::WallTime::now() - sent).toSec() > 2){
+      std::lock_guard<std::mutex> lock(mtx);   // the command message is shared
+      state.crtk_command_pb(CRTK_ENABLE);
+      sent = ros::WallTime::now();
+    }
+    ros::WallDuration(0.05).sleep();
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief      Starts a process in its own process group, with stdin from
+ *             /dev/null and stdout and stderr going to a log file
+ *
+ * @param[in]  args  The command and its arguments
+ * @param[in]  log   The log file
+ *
+ * @return     The process id, -1 on failure
+ */
+pid_t CRTK_test_runner::spawn(const std::vector<std::string>& args, const std::string& log){
+  std::vector<char*> argv;
+  for(size_t i=0; i<args.size(); i++)
+    argv.push_back(const_cast<char*>(args[i].c_str()));
+  argv.push_back(NULL);
+
+  pid_t pid = fork();
+  if(pid == 0){
+    setpgid(0, 0);
+    int in  = open("/dev/null", O_RDONLY);
+    int out = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(in >= 0)  dup2(in, 0);
+    if(out >= 0){
+      dup2(out, 1);
+      dup2(out, 2);
+    }
+    execvp(argv[0], &argv[0]);
+    _exit(127);
+  }
+  if(pid < 0){
+    ROS_ERROR("Could not start %s.", args[0].c_str());
+    return -1;
+  }
+  setpgid(pid, pid);
+  return pid;
+}
+
+
+
+/**
+ * @brief      Waits for a process to exit, stopping it after the timeout or
+ *             when the runner is shut down
+ *
+ * @param[in]  pid        The process id
+ * @param[in]  timeout    The timeout in s
+ * @param      timed_out  Set if the process had to be stopped
+ *
+ * @return     The exit code, 128 + the signal if it was killed
+ */
+int CRTK_test_runner::wait_for(pid_t pid, double timeout, bool *timed_out){
+  ros::WallTime start = ros::WallTime::now();
+  int status;
+
+  *timed_out = 0;
+  while(waitpid(pid, &status, WNOHANG) == 0){
+    if(!ros::ok() || (ros::WallTime::now() - start).toSec() > timeout){
+      *timed_out = 1;
+      stop(pid);
+      return -1;
+    }
+    ros::WallDuration(0.1).sleep();
+  }
+  if(WIFEXITED(status))
+    return WEXITSTATUS(status);
+  return 128 + WTERMSIG(status);
+}
+
+
+
+/**
+ * @brief      Stops a process group with SIGINT, like Ctrl-C would, and
+ *             kills it if it is still running 10 s later
+ *
+ * @param[in]  pid   The process id, also the process group id
+ */
+void CRTK_test_runner::stop(pid_t pid){
+  int status;
+
+  kill(-pid, SIGINT);
+  for(int i=0; i<100; i++){
+    if(waitpid(pid, &status, WNOHANG) != 0){
+      kill(-pid, SIGKILL);   // stragglers left in the group
+      return;
+    }
+    ros::WallDuration(0.1).sleep();
+  }
+  kill(-pid, SIGKILL);
+  waitpid(pid, &status, 0);
+}
+
+
+
+/**
+ * @brief      Reads the results a suite wrote with CRTK_suite
+ *
+ * @param      job   The suite
+ * @param[in]  file  The result file
+ */
+void CRTK_test_runner::read_results(CRTK_suite_job *job, const std::string& file){
+  std::ifstream in(file.c_str());
+  std::string line;
+  char name[128];
+  int status;
+  double time;
+
+  while(std::getline(in, line)){
+    if(sscanf(line.c_str(), "{\"test\": \"%127[^\"]\", \"status\": %d, \"time\": %lf}", name, &status, &time) == 3){
+      CRTK_test_case test;
+      test.name   = name;
+      test.status = status;
+      test.time   = time;
+      job->tests.push_back(test);
+    }
+    else if(sscanf(line.c_str(), "{\"done\": true, \"errors\": %d}", &status) == 1){
+      job->finished = 1;
+    }
+  }
+}
+
+
+
+/**
+ * @brief      Writes the JUnit report: one testsuite per suite, one testcase
+ *             per test, and an error case for suites that did not finish.
+ *
+ * @param[in]  wall_time  The wall time of the whole run in s
+ */
+void CRTK_test_runner::write_junit(double wall_time){
+  FILE *f = fopen(junit_file.c_str(), "w");
+  if(!f){
+    ROS_ERROR("Could not write %s.", junit_file.c_str());
+    return;
+  }
+
+  int tests = 0, failures = 0, errors = 0;
+  for(size_t i=0; i<jobs.size(); i++){
+    tests    += jobs[i].tests.size() + !jobs[i].finished;
+    failures += jobs[i].failures();
+    errors   += !jobs[i].finished;
+  }
+
+  fprintf(f, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+  fprintf(f, "<testsuites name=\"crtk\" tests=\"%i\" failures=\"%i\" errors=\"%i\" time=\"%.3f\">\n",
+    tests, failures, errors, wall_time);
+
+  for(size_t i=0; i<jobs.size(); i++){
+    const CRTK_suite_job &job = jobs[i];
+    std::string suite = xml_escape(job.suite);
+
+    fprintf(f, "  <testsuite name=\"%s\" tests=\"%i\" failures=\"%i\" errors=\"%i\" time=\"%.3f\">\n",
+      suite.c_str(), (int)job.tests.size() + !job.finished, job.failures(), !job.finished, job.time);
+    fprintf(f, "    <properties>\n");
+    fprintf(f, "      <property name=\"r_space\" value=\"%s\"/>\n", xml_escape(job.r_space).c_str());
+    fprintf(f, "      <property name=\"log\" value=\"%s\"/>\n", xml_escape(job.log).c_str());
+    fprintf(f, "    </properties>\n");
+
+    for(size_t j=0; j<job.tests.size(); j++){
+      const CRTK_test_case &test = job.tests[j];
+      fprintf(f, "    <testcase classname=\"%s\" name=\"%s\" time=\"%.3f\"",
+        suite.c_str(), xml_escape(test.name).c_str(), test.time);
+      if(test.status > 0)
+        fprintf(f, "/>\n");
+      else
+        fprintf(f, ">\n      <failure message=\"status %i\"/>\n    </testcase>\n", test.status);
+    }
+    if(!job.finished){
+      std::stringstream msg;
+      if(job.timed_out)
+        msg << "timed out after " << timeout << " s";
+      else if(job.exit_code < 0)
+        msg << "not started";
+      else
+        msg << "exited with " << job.exit_code << " before the end";
+      fprintf(f, "    <testcase classname=\"%s\" name=\"suite\" time=\"%.3f\">\n", suite.c_str(), job.time);
+      fprintf(f, "      <error message=\"%s\"/>\n    </testcase>\n", xml_escape(msg.str()).c_str());
+    }
+    fprintf(f, "  </testsuite>\n");
+  }
+  fprintf(f, "</testsuites>\n");
+  fclose(f);
+  ROS_INFO("JUnit report: %s", junit_file.c_str());
+}
+
+
+
+/**
+ * @brief      Writes the JSON report
+ *
+ * @param[in]  wall_time  The wall time of the whole run in s
+ */
+void CRTK_test_runner::write_json(double wall_time){
+  FILE *f = fopen(json_file.c_str(), "w");
+  if(!f){
+    ROS_ERROR("Could not write %s.", json_file.c_str());
+    return;
+  }
+
+  bool passed = 1;
+  for(size_t i=0; i<jobs.size(); i++)
+    passed = passed && jobs[i].passed();
+
+  fprintf(f, "{\n  \"passed\": %s,\n  \"wall_time\": %.3f,\n  \"workers\": %i,\n  \"lockstep\": %s,\n  \"suites\": [",
+    passed ? "true" : "false", wall_time, workers, lockstep ? "true" : "false");
+  for(size_t i=0; i<jobs.size(); i++){
+    const CRTK_suite_job &job = jobs[i];
+    fprintf(f, "%s\n    {\"name\": \"%s\", \"r_space\": \"%s\", \"passed\": %s, \"finished\": %s, "
+      "\"timed_out\": %s, \"exit_code\": %i, \"time\": %.3f, \"log\": \"%s\", \"tests\": [",
+      i ? "," : "", json_escape(job.suite).c_str(), json_escape(job.r_space).c_str(),
+      job.passed() ? "true" : "false", job.finished ? "true" : "false",
+      job.timed_out ? "true" : "false", job.exit_code, job.time, json_escape(job.log).c_str());
+    for(size_t j=0; j<job.tests.size(); j++){
+      const CRTK_test_case &test = job.tests[j];
+      fprintf(f, "%s\n      {\"name\": \"%s\", \"status\": %i, \"time\": %.3f}",
+        j ? "," : "", json_escape(test.name).c_str(), test.status, test.time);
+    }
+    fprintf(f, "%s]}", job.tests.empty() ? "" : "\n    ");
+  }
+  fprintf(f, "\n  ]\n}\n");
+  fclose(f);
+  ROS_INFO("JSON report: %s", json_file.c_str());
+}
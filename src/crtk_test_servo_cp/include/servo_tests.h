@@ -37,21 +37,21 @@
 
 
 // This function loops through all the crtk tests
-int servo_testing(CRTK_robot*, time_t);
+int servo_testing(CRTK_robot*, ros::Time);
 
 // 3-1 Absolute (command: servo_cp) Axis motion Test
 // (functionality) move along X axis for 2 cm (both arms)
 // 		Pass: Ask user
 // (functionality) move along Z axis for 2 cm (both arms)
 // 		Pass: Ask user
-int test_3_1(CRTK_robot *, time_t);
+int test_3_1(CRTK_robot *, ros::Time);
 
 // 3-2 Absolute (command: servo_cp) Axis rotation Test
 // (functionality) rotate along X axis for 45 degrees (both arms)
 //    Pass: Ask user
 // (functionality) rotate along Z axis for 45 degrees (both arms)
 //    Pass: Ask user
-int test_3_2(CRTK_robot *, time_t);
+int test_3_2(CRTK_robot *, ros::Time);
 
 
 
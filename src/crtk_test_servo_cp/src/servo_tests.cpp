@@ -36,6 +36,8 @@
 #include <crtk_msgs/operating_state.h>
 #include <crtk_msgs/StringStamped.h>
 #include <crtk_lib_cpp/crtk_robot_state.h>
+#include <crtk_lib_cpp/crtk_confirm.h>
+#include <crtk_lib_cpp/crtk_suite.h>
 #include <sstream>
 #include <ctime>
 #include <iostream>
@@ -59,8 +61,8 @@ static int start_test = 1;
  *
  * @return     errors
  */
-int servo_testing( CRTK_robot* robot, time_t current_time){
-  static time_t start_time = current_time;
+int servo_testing( CRTK_robot* robot, ros::Time current_time){
+  static ros::Time start_time = current_time;
   static int current_test = 0;
   static int finished = 0;
   static int errors = 0;
@@ -74,7 +76,7 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
   }
 
   // wait for a beat
-  if (current_time - start_time < 2){
+  if ((current_time - start_time).toSec() < 2){
         return 0;
   }
   else if (current_test == 0 && !finished){
@@ -97,10 +99,12 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         errors += 1;
         current_test ++;
         ROS_ERROR("test_3_1 fail: %i", test_status);
+        CRTK_suite::result("test_3_1", test_status);
       }
       else if (test_status > 0) {
         current_test ++;
         ROS_INFO("test_3_1 passed: %i", test_status);
+        CRTK_suite::result("test_3_1", test_status);
       }
       break;
     }
@@ -112,10 +116,12 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         errors += 1;
         current_test ++;
         ROS_ERROR("test_3_2 fail: %i", test_status);
+        CRTK_suite::result("test_3_2", test_status);
       }
       else if (test_status > 0) {
         current_test ++;
         ROS_INFO("test_3_2 passed: %i", test_status);
+        CRTK_suite::result("test_3_2", test_status);
       }
       break;
     }
@@ -127,6 +133,7 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         robot->state.crtk_command_pb(command);
         ROS_ERROR("We failed some things.");
         finished = 1;
+        CRTK_suite::done(errors);
       }
       else if(finished == 0 && errors == 0){
         // After all tests, send estop command!
@@ -134,6 +141,7 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         robot->state.crtk_command_pb(command);
         ROS_INFO("We finished everything. Good job!!");
         finished = 1;
+        CRTK_suite::done(errors);
       }
     }
 
@@ -158,11 +166,11 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
  *
  * @return     success 1, fail otherwise
  */
-int test_3_1(CRTK_robot *robot, time_t current_time){
+int test_3_1(CRTK_robot *robot, ros::Time current_time){
   static int current_step = 1;
-  static time_t pause_start;
+  static ros::Time pause_start;
   int out = 0;
-  std::string start, s;
+  std::string s;
   float pos_thresh = 10 DEG_TO_RAD;
   float vel_thresh = 10 DEG_TO_RAD;
   float dist = 0.025; // 25 mm total
@@ -182,8 +190,7 @@ int test_3_1(CRTK_robot *robot, time_t current_time){
     case 2:
     {
       // (2) wait for 'Enter' key press
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
@@ -200,7 +207,7 @@ int test_3_1(CRTK_robot *robot, time_t current_time){
         pause_start = current_time;
         started = 1;
       }
-      else if(current_time - pause_start > 1){
+      else if((current_time - pause_start).toSec() > 1){
         started = 0;
         current_step++;
       }
@@ -252,18 +259,16 @@ int test_3_1(CRTK_robot *robot, time_t current_time){
     case 8:    case 14:
     {
       // (8) take user input yes or no
-      getline(std::cin,start);
-      if(start == "Y" || start == "y"){
+      tf::Vector3 move_vec = (current_step == 8) ? -vec_z : vec_x;
+      int answer = CRTK_confirm::yes_no(robot, robot->arm.get_start_tf(), move_vec*dist);
+      if(answer > 0){
         out = 1;
         out = step_success(out, &current_step);
       }
-      else if(start == "N" || start == "n"){
+      else if(answer < 0){
         out = -1;
         out = step_success(out, &current_step);
       }
-      else{
-        current_step --;
-      }
       if(current_step == 15 && out == 1)
         return 1; // at the end of test 2
       break;
@@ -287,11 +292,11 @@ int test_3_1(CRTK_robot *robot, time_t current_time){
  *
  * @return     success 1, fail otherwise
  */
-int test_3_2(CRTK_robot *robot, time_t current_time){
+int test_3_2(CRTK_robot *robot, ros::Time current_time){
   static int current_step = 1;
-  static time_t pause_start;
+  static ros::Time pause_start;
   int out = 0;
-  std::string start, s;
+  std::string s;
   float pos_thresh = 10 DEG_TO_RAD;
   float vel_thresh = 10 DEG_TO_RAD;
   float angle = 45 DEG_TO_RAD; // 45 degrees total
@@ -311,8 +316,7 @@ int test_3_2(CRTK_robot *robot, time_t current_time){
     case 2:
     {
       // (2) wait for 'Enter' key press
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
@@ -329,7 +333,7 @@ int test_3_2(CRTK_robot *robot, time_t current_time){
         pause_start = current_time;
         started = 1;
       }
-      else if(current_time - pause_start > 1){
+      else if((current_time - pause_start).toSec() > 1){
         started = 0;
         current_step++;
       }
@@ -381,18 +385,15 @@ int test_3_2(CRTK_robot *robot, time_t current_time){
     case 8:    case 14: 
     {
       // (8) take user input yes or no
-      getline(std::cin,start);
-      if(start == "Y" || start == "y"){
+      int answer = CRTK_confirm::yes_no(robot, robot->arm.get_start_tf(), angle);
+      if(answer > 0){
         out = 1;
         out = step_success(out, &current_step);
       }
-      else if(start == "N" || start == "n"){
+      else if(answer < 0){
         out = -1;
         out = step_success(out, &current_step);
       }
-      else{
-        current_step --;
-      }
       if(current_step == 15 && out == 1)
         return 1; // at the end of test 2
       break;
@@ -37,7 +37,7 @@
 
 
 // This function loops through all the crtk tests
-int servo_testing(CRTK_robot*, time_t);
+int servo_testing(CRTK_robot*, ros::Time);
 
 
 // 2-1 Relative (command: servo_cr) Axis motion Test
@@ -47,22 +47,22 @@ int servo_testing(CRTK_robot*, time_t);
 // 		Pass: Check raven state
 // (functionality) move along Z axis for 2 secs (both arms)
 // 		Pass: Check raven state
-int test_2_1(CRTK_robot *, time_t);
+int test_2_1(CRTK_robot *, ros::Time);
 
 
 // 2-2 Relative (command: servo_cr) Cube tracing Test
 // (functionality) Trace a cube
 //    Pass: Ask user!
-int test_2_2(CRTK_robot *, time_t);
+int test_2_2(CRTK_robot *, ros::Time);
  
 // 2-3 Relative (command: servo_cr) Orientation axis test
 // (functionality) rotate about X,Y,Z axis for 1 secs (30 deg)
 // Pass: ask user!
-int test_2_3(CRTK_robot *, time_t);
+int test_2_3(CRTK_robot *, ros::Time);
 
 // 2-4 Relative (command: servo_cr for grasper) Grasper test
 // (functionality) clapping with grasper for 2 sec (max = 30 deg)
 // Pass: ask user!
-int test_2_4(CRTK_robot *, time_t);
+int test_2_4(CRTK_robot *, ros::Time);
 
 #endif
\ No newline at end of file
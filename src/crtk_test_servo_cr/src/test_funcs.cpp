@@ -28,6 +28,7 @@
  */
 
 #include "test_funcs.h"
+#include <crtk_lib_cpp/crtk_motion_stats.h>
 #include <cmath>
 
 
@@ -60,31 +61,30 @@ int crtk_state_check(CRTK_robot_state_enum desired, CRTK_robot_state_enum actual
  *
  * @return     success 1, fail -1
  */
-int check_joint_motion_and_vel(CRTK_robot* robot, float pos_thresh, float vel_thresh, long current_time, int check_time){
+int check_joint_motion_and_vel(CRTK_robot* robot, float pos_thresh, float vel_thresh, ros::Time current_time, int check_time){
   static int start = 1;
   double scale;
-  static time_t start_time;
   static float start_pos[MAX_JOINTS];
   static float curr_pos[MAX_JOINTS],curr_vel[MAX_JOINTS]; 
   static int pos_done[MAX_JOINTS],vel_done[MAX_JOINTS];
-  static float max_vel[MAX_JOINTS]; 
+  static CRTK_motion_stats stats;
 
   if (start){
+    char name[96];
+    snprintf(name, sizeof(name), "Joint motion check (pos_thresh %f, vel_thresh %f)", fabs(pos_thresh), fabs(vel_thresh));
     robot->arm.get_measured_js_pos(start_pos, MAX_JOINTS);
-    start_time = current_time;
+    stats.start(name, robot->arm.get_num_joints(), current_time);
 
-    ROS_INFO(" pos_thresh = %f",fabs(pos_thresh));
-    ROS_INFO(" vel_thresh = %f",fabs(vel_thresh));
     for(int i=0;i<MAX_JOINTS;i++){
       pos_done[i] = 0;
       vel_done[i] = 0;
-      max_vel[i] = 0;
     }
     start = 0;
   }
 
   robot->arm.get_measured_js_pos(curr_pos, MAX_JOINTS);
   robot->arm.get_measured_js_vel(curr_vel, MAX_JOINTS);
+  stats.tick(current_time);
 
   //check each joint for motion and velocity greater than threshold
   for(int i = 0; i<MAX_JOINTS; i++){
@@ -94,37 +94,22 @@ int check_joint_motion_and_vel(CRTK_robot* robot, float pos_thresh, float vel_th
     if(fabs(start_pos[i] - curr_pos[i]) > fabs(pos_thresh*scale)) pos_done[i] = 1;
     if(fabs(curr_vel[i]) > vel_thresh*scale) vel_done[i] = 1;
 
-    if(fabs(curr_vel[i]) >= fabs(max_vel[i])) max_vel[i] = curr_vel[i];
+    stats.add(i, curr_pos[i] - start_pos[i], curr_vel[i]);
   }
 
- static int count = 0;
-  if(count % 1500 == 0){
-    ROS_INFO("(pos done)-- %i, %i, %i, %i, %i, %i, %i", pos_done[0],pos_done[1],pos_done[2], pos_done[3],pos_done[4],pos_done[5],pos_done[6]);
-    ROS_INFO("(vel done)-- %i, %i, %i, %i, %i, %i, %i", vel_done[0],vel_done[1],vel_done[2], vel_done[3],vel_done[4],vel_done[5],vel_done[6]);
-    ROS_INFO(" ");
-
-  }
-  count ++;
-
   if((done_sum(pos_done) == MAX_JOINTS) && (done_sum(vel_done) == MAX_JOINTS)){
     //success!
-
-    ROS_INFO("max_vel-- %f, %f, %f, %f, %f, %f, %f", max_vel[0],max_vel[1],max_vel[2],max_vel[3],max_vel[4],max_vel[5],max_vel[6]);
-    ROS_INFO("pos_done %i\tvel_done %i",done_sum(pos_done),done_sum(vel_done));
-    ROS_INFO(" ");
+    stats.report(1);
     start = 1;
     return 1;
   }
   //if no, check time 
-  else if(current_time - start_time > check_time){
+  else if(stats.get_elapsed() > check_time){
     ROS_ERROR("Joint motion and velocity check timeout on step.");
     if (done_sum(pos_done) != MAX_JOINTS) ROS_INFO("robot arm didn't move far enough");
     if (done_sum(vel_done) != MAX_JOINTS) ROS_INFO("robot arm didn't move fast enough");
-
-
-    ROS_INFO("max_vel-- %f, %f, %f, %f, %f, %f, %f", max_vel[0],max_vel[1],max_vel[2],max_vel[3],max_vel[4],max_vel[5],max_vel[6]);
     ROS_INFO("pos_done %i\tvel_done %i",done_sum(pos_done),done_sum(vel_done));
-    ROS_INFO(" ");
+    stats.report(-1);
     start = 1;
     return -1;
   }
@@ -194,10 +179,10 @@ int done_sum(int in[MAX_JOINTS]){
  *
  * @return     success > 0, fail otherwise
  */
-int check_movement_direction(CRTK_motion* arm, CRTK_axis axis, float dist, int check_time, long current_time){
+int check_movement_direction(CRTK_motion* arm, CRTK_axis axis, float dist, int check_time, ros::Time current_time){
   static int start = 1;
-  static float start_pos, max_dist;
-  static time_t start_time;
+  static float start_pos;
+  static CRTK_motion_stats stats;
 
   float curr_pos, curr_dist;
 
@@ -208,37 +193,26 @@ int check_movement_direction(CRTK_motion* arm, CRTK_axis axis, float dist, int c
 
   if(start){
     start_pos = axis_value(arm->get_measured_cp().getOrigin(), axis);
-    start_time = current_time;
+    stats.start("Movement direction check", 1, current_time);
     start = 0;
-    max_dist = 0;
   }
 
   curr_pos = axis_value(arm->get_measured_cp().getOrigin(), axis);
   curr_dist = curr_pos - start_pos;
-
-  // save maxa distance
-  if(fabs(curr_dist)>fabs(max_dist)){
-    max_dist = curr_dist;
-  }
-
-  static int count = 0;
-  count ++;
-  if(count%500 == 0){
-    ROS_INFO("curr_dist = %f",curr_dist);
-    count = 0;
-  }
-
+  stats.tick(current_time);
+  stats.add(0, curr_dist);
 
   // check movement along axis
   if((dist > 0 && curr_dist > dist) || (dist < 0 && curr_dist < dist)){
-    ROS_INFO("success!");
+    stats.report(1);
     start = 1;
     return 1;
   }
 
   // check for timeout
-  if(current_time - start_time > check_time){
+  if(stats.get_elapsed() > check_time){
     ROS_ERROR("Check movement timeout.");
+    stats.report(-1);
     start = 1;
     return -1;
   }
@@ -256,11 +230,10 @@ int check_movement_direction(CRTK_motion* arm, CRTK_axis axis, float dist, int c
  *
  * @return     success > 0, fail otherwise
  */
-int check_movement_rotation(CRTK_motion* arm, float angle, int check_time, long current_time, tf::Transform start_pos){
+int check_movement_rotation(CRTK_motion* arm, float angle, int check_time, ros::Time current_time, tf::Transform start_pos){
   static int start = 1;
-  static tf::Quaternion start_ori = start_pos.getRotation();
-  static float max_angle;
-  static time_t start_time;
+  static tf::Quaternion start_ori;
+  static CRTK_motion_stats stats;
 
   tf::Quaternion curr_ori;
   float curr_angle;
@@ -271,42 +244,27 @@ int check_movement_rotation(CRTK_motion* arm, float angle, int check_time, long
   }
 
   if(start){
-    start_time = current_time;
+    start_ori = start_pos.getRotation();
+    stats.start("Movement rotation check", 1, current_time);
     start = 0;
-    max_angle = 0;
-    ROS_INFO("start == 1");
   }
 
   curr_ori = arm->get_measured_cp().getRotation();
-
-  ROS_INFO("start rotation (after): %f, %f, %f, %f",start_pos.getRotation().x(),start_pos.getRotation().y(),start_pos.getRotation().z(),start_pos.getRotation().w());
-  ROS_INFO("curr rotation (after):  %f, %f, %f, %f",curr_ori.x(),curr_ori.y(),curr_ori.z(),curr_ori.w());
   curr_angle = fabs(2*curr_ori.angle(start_ori));
-  ROS_INFO("angle rotated = %f",curr_angle);
-
-  // save maxa distance
-  if(fabs(curr_angle)>fabs(max_angle)){
-    max_angle = curr_angle;
-  }
-
-  static int count = 0;
-  count ++;
-  if(count%500 == 0){
-    ROS_INFO("angle rotated = %f",curr_angle);
-    count = 0;
-  }
-
+  stats.tick(current_time);
+  stats.add(0, curr_angle);
 
   // check movement along axis
   if(fabs(curr_angle) > fabs(angle)){
-    ROS_INFO("success!");
+    stats.report(1);
     start = 1;
     return 1;
   }
 
   // check for timeout
-  if(current_time - start_time > check_time){
+  if(stats.get_elapsed() > check_time){
     ROS_ERROR("Check movement timeout.");
+    stats.report(-1);
     start = 1;
     return -1;
   }
@@ -37,7 +37,7 @@
 
 
 // This function loops through all the crtk tests
-int servo_testing(CRTK_robot*, time_t);
+int servo_testing(CRTK_robot*, ros::Time);
 
 
 // 7-1 Relative (command: servo_cv) Axis motion Test
@@ -47,17 +47,17 @@ int servo_testing(CRTK_robot*, time_t);
 // 		Pass: Check raven state
 // (functionality) move along Z axis for 2 secs (both arms)
 // 		Pass: Check raven state
-int test_7_1(CRTK_robot *, time_t);
+int test_7_1(CRTK_robot *, ros::Time);
 
 
 // 7-2 Relative (command: servo_cv) Cube tracing Test
 // (functionality) Trace a cube
 //    Pass: Ask user!
-int test_7_2(CRTK_robot *, time_t);
+int test_7_2(CRTK_robot *, ros::Time);
  
 // 7-3 Relative (command: servo_cv) Orientation axis test
 // (functionality) rotate about X,Y,Z axis for 1 secs (30 deg)
 // Pass: ask user!
-int test_7_3(CRTK_robot *, time_t);
+int test_7_3(CRTK_robot *, ros::Time);
 
 #endif
\ No newline at end of file
@@ -36,6 +36,8 @@
 #include <crtk_msgs/operating_state.h>
 #include <crtk_msgs/StringStamped.h>
 #include <crtk_lib_cpp/crtk_robot_state.h>
+#include <crtk_lib_cpp/crtk_confirm.h>
+#include <crtk_lib_cpp/crtk_suite.h>
 #include <sstream>
 #include <ctime>
 #include <iostream>
@@ -59,8 +61,8 @@ static int start_test = 1;
  *
  * @return     errors
  */
-int servo_testing( CRTK_robot* robot, time_t current_time){
-  static time_t start_time = current_time;
+int servo_testing( CRTK_robot* robot, ros::Time current_time){
+  static ros::Time start_time = current_time;
   static int current_test = 0;
   static int finished = 0;
   static int errors = 0;
@@ -74,7 +76,7 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
   }
 
   // wait for a beat
-  if (current_time - start_time < 2){
+  if ((current_time - start_time).toSec() < 2){
         return 0;
   }
   else if (current_test == 0 && !finished){
@@ -96,10 +98,12 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         errors += 1;
         current_test ++;
         ROS_ERROR("test_7_1 fail: %i", test_status);
+        CRTK_suite::result("test_7_1", test_status);
       }
       else if (test_status > 0) {
         current_test ++;
         ROS_INFO("test_7_1 passed: %i", test_status);
+        CRTK_suite::result("test_7_1", test_status);
       }
       break;
     }
@@ -111,10 +115,12 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         errors += 1;
         current_test ++;
         ROS_ERROR("test_7_2 fail: %i", test_status);
+        CRTK_suite::result("test_7_2", test_status);
       }
       else if (test_status > 0) {
         current_test ++;
         ROS_INFO("test_7_2 passed: %i", test_status);
+        CRTK_suite::result("test_7_2", test_status);
       }
       break;
     }
@@ -126,10 +132,12 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         errors += 1;
         current_test ++;
         ROS_ERROR("test_7_3 fail: %i", test_status);
+        CRTK_suite::result("test_7_3", test_status);
       }
       else if (test_status > 0) {
         current_test ++;
         ROS_INFO("test_7_3 passed: %i", test_status);
+        CRTK_suite::result("test_7_3", test_status);
       }
       break;
     }
@@ -142,6 +150,7 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         robot->state.crtk_command_pb(command);
         ROS_ERROR("We failed some things.");
         finished = 1;
+        CRTK_suite::done(errors);
       }
       else if(finished == 0 && errors == 0){
         // After all tests, send estop command!
@@ -149,6 +158,7 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
         robot->state.crtk_command_pb(command);
         ROS_INFO("We finished everything. Good job!!");
         finished = 1;
+        CRTK_suite::done(errors);
       }
     }
 
@@ -175,11 +185,11 @@ int servo_testing( CRTK_robot* robot, time_t current_time){
  *
  * @return     success 1, fail otherwise
  */
-int test_7_1(CRTK_robot *robot, time_t current_time){
+int test_7_1(CRTK_robot *robot, ros::Time current_time){
   static int current_step = 1;
-  static time_t pause_start;
+  static ros::Time pause_start;
   int out = 0;
-  std::string start, s;
+  std::string s;
   float pos_thresh = 10 DEG_TO_RAD;
   float vel_thresh = 10 DEG_TO_RAD;
   float dist = 0.02; // 20 mm total
@@ -199,8 +209,7 @@ int test_7_1(CRTK_robot *robot, time_t current_time){
     case 2:
     {
       // (2) wait for 'Enter' key press
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
@@ -260,18 +269,16 @@ int test_7_1(CRTK_robot *robot, time_t current_time){
     case 8:    case 14:
     {
       // (8) take user input yes or no
-      getline(std::cin,start);
-      if(start == "Y" || start == "y"){
+      tf::Vector3 move_vec = (current_step == 8) ? -vec_z : vec_x;
+      int answer = CRTK_confirm::yes_no(robot, robot->arm.get_start_tf(), move_vec*dist);
+      if(answer > 0){
         out = 1;
         out = step_success(out, &current_step);
       }
-      else if(start == "N" || start == "n"){
+      else if(answer < 0){
         out = -1;
         out = step_success(out, &current_step);
       }
-      else{
-        current_step --;
-      }
       if(current_step == 15 && out == 1)
         return 1; // at the end of test 2
       break;
@@ -292,11 +299,11 @@ int test_7_1(CRTK_robot *robot, time_t current_time){
  *
  * @return     success 1, fail otherwise
  */
-int test_7_2(CRTK_robot *robot, time_t current_time){
+int test_7_2(CRTK_robot *robot, ros::Time current_time){
   static int current_step = 1;
-  static time_t pause_start;
+  static ros::Time pause_start;
   int out = 0;
-  std::string start, s;
+  std::string s;
 
   float dist = 0.01; // 10 mm total
   int duration = 1;
@@ -308,6 +315,7 @@ int test_7_2(CRTK_robot *robot, time_t current_time){
   static CRTK_axis prev_axis = CRTK_Z;
 
   static char edge_count = 0;
+  static tf::Vector3 traced(0,0,0); // largest excursion along each axis, for (9)
 
   switch(current_step)
   {
@@ -323,8 +331,7 @@ int test_7_2(CRTK_robot *robot, time_t current_time){
     case 2:
     {
       // (2) wait for 'Enter' key press
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
@@ -358,7 +365,9 @@ int test_7_2(CRTK_robot *robot, time_t current_time){
     }
     case 6:
     {
+      CRTK_confirm::watch(robot);
       rand_cube_dir(&curr_vertex, &move_vec, &prev_axis);
+      traced.setMax(move_vec.absolute() * dist);
       robot->arm.start_motion(current_time);
       ROS_INFO("\t step 7 length ->  %f", move_vec.length());
 
@@ -368,12 +377,13 @@ int test_7_2(CRTK_robot *robot, time_t current_time){
     }
     case 7:
     {
+      CRTK_confirm::watch(robot);
       out = 0;
       if(!out) out = robot->arm.send_servo_cv_time(move_vec,dist,duration,current_time);
       else           robot->arm.send_servo_cv(tf::Transform());
 
       out = step_success(out, &current_step);
-      if(out && edge_count < 11) current_step = 7; 
+      if(out && edge_count < 11) current_step = 6; 
       break;
     }
     case 8:
@@ -386,18 +396,15 @@ int test_7_2(CRTK_robot *robot, time_t current_time){
     case 9:
     {
       // (9) take user input yes or no
-      getline(std::cin,start);
-      if(start == "Y" || start == "y"){
+      int answer = CRTK_confirm::yes_no_peak(robot, traced, tf::Vector3(0,0,0));
+      if(answer > 0){
         out = 1;
         out = step_success(out, &current_step);
       }
-      else if(start == "N" || start == "n"){
+      else if(answer < 0){
         out = -1;
         out = step_success(out, &current_step);
       }
-      else{
-        current_step --;
-      }
       if(out == 1)
         return 1; // at the end of test 2
       break;
@@ -418,12 +425,15 @@ int test_7_2(CRTK_robot *robot, time_t current_time){
  *
  * @return     success 1, fail otherwise
  */
-int test_7_3(CRTK_robot * robot, time_t current_time){
+int test_7_3(CRTK_robot * robot, ros::Time current_time){
   static int current_step = 1;
   int duration = 1, out = 0;
   float step_angle = 2*0.000262;
   static tf::Vector3 motion_vec;
-  std::string start;
+
+  // the rotations of steps 5 to 17 are checked in (19)
+  if(current_step >= 5 && current_step <= 17)
+    CRTK_confirm::watch(robot);
 
   switch(current_step)
   {
@@ -439,8 +449,7 @@ int test_7_3(CRTK_robot * robot, time_t current_time){
     case 2:
     {
       // (2) wait for 'Enter' key press
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
@@ -476,7 +485,7 @@ int test_7_3(CRTK_robot * robot, time_t current_time){
 
       tf::Transform trans = tf::Transform(tf::Quaternion(motion_vec,step_angle));
       out = robot->arm.send_servo_cv(trans);
-      if(current_time-robot->arm.get_start_time() > duration){
+      if((current_time - robot->arm.get_start_stamp()).toSec() > duration){
         robot->arm.start_motion(current_time);
         current_step ++;
         ROS_INFO("moving to step %i",current_step);
@@ -487,7 +496,7 @@ int test_7_3(CRTK_robot * robot, time_t current_time){
     {
       // (6) send nothing 
       // (8) send nothing 
-      // if(current_time-robot->arm.get_start_time() > duration){
+      // if((current_time - robot->arm.get_start_stamp()).toSec() > duration){
       //   robot->arm.start_motion(current_time);
       //   current_step ++;
       //   ROS_INFO("moving to step %i",current_step);
@@ -501,7 +510,7 @@ int test_7_3(CRTK_robot * robot, time_t current_time){
       // (7) send motion command to move robot (for 2 secs)
       tf::Transform trans = tf::Transform(tf::Quaternion(-motion_vec,step_angle));
       out = robot->arm.send_servo_cv(trans);
-      if(current_time-robot->arm.get_start_time() > duration){
+      if((current_time - robot->arm.get_start_stamp()).toSec() > duration){
         robot->arm.start_motion(current_time);
         current_step ++;
         ROS_INFO("moving to step %i",current_step);
@@ -517,18 +526,16 @@ int test_7_3(CRTK_robot * robot, time_t current_time){
     case 19:
     {
       // (8) take user input yes or no
-      getline(std::cin,start);
-      if(start == "Y" || start == "y"){
+      float turn = step_angle * duration;   // servo_cv turns step_angle per second
+      int answer = CRTK_confirm::yes_no_peak(robot, tf::Vector3(0,0,0), tf::Vector3(turn,turn,turn));
+      if(answer > 0){
         step_success(1, &current_step);
         return 1;
       }
-      else if(start == "N" || start == "n"){
+      else if(answer < 0){
         step_success(-1, &current_step);
         return -1;
       }
-      else{
-        current_step --;
-      }
       break;
     }
   }
@@ -37,16 +37,16 @@
 
 
 // This function loops through all the crtk tests
-int servo_testing(CRTK_robot*, time_t);
+int servo_testing(CRTK_robot*, ros::Time);
 
 // 5-1 Absolute joint test (command: servo_jp) 
 // (functionality) move 10 degrees in the shoulder and tool joints
 //    Pass: Ask user
-int test_5_1(CRTK_robot *, time_t);
+int test_5_1(CRTK_robot *, ros::Time);
 
 
 // 5-2 Go home (command: servo_jp) 
 // (functionality) move back to home pose (both arms)
 //    Pass: Ask user
-int test_5_2(CRTK_robot *, time_t);
+int test_5_2(CRTK_robot *, ros::Time);
 #endif
\ No newline at end of file
@@ -37,18 +37,18 @@
 
 
 // This function loops through all the crtk tests
-int servo_testing(CRTK_robot*, time_t);
+int servo_testing(CRTK_robot*, ros::Time);
 
 
 // 4-1 Relative joint test (command: servo_jr) 
 // (functionality) move 10 degrees in the shoulder and tool joints
 //    Pass: Ask user
-int test_4_1(CRTK_robot *, time_t);
+int test_4_1(CRTK_robot *, ros::Time);
 
 
 // 4-2 Go home (command: servo_jr) 
 // (functionality) move back to home pose (both arms)
 //    Pass: Ask user
-int test_4_2(CRTK_robot *, time_t);
+int test_4_2(CRTK_robot *, ros::Time);
 
 #endif
\ No newline at end of file
@@ -42,7 +42,7 @@ int crtk_state_check(CRTK_robot_state_enum, CRTK_robot_state_enum, int);
 
 // This function checks each robot joint to move beyond the pos and vel threshold
 // assuming that we're testing MAX_JOINTS number of joints
-int check_joint_motion_and_vel(CRTK_robot*, float, float, long, int);
+int check_joint_motion_and_vel(CRTK_robot*, float, float, ros::Time, int);
 
 // Checks robot completion status
 int step_success(int, int*);
@@ -52,7 +52,7 @@ int done_sum(int*);
 
 // Checks if the robot moved in the specified direction for a desired distance
 // we are doing the check one arm at a time, not parallel
-int check_movement_direction(CRTK_motion* , CRTK_axis , float , int, long);
+int check_movement_direction(CRTK_motion* , CRTK_axis , float , int, ros::Time);
 
 // returns the value of the "axis" entry of a Vector3
 float axis_value(tf::Vector3, CRTK_axis);
@@ -61,7 +61,7 @@ float axis_value(tf::Vector3, CRTK_axis);
 int check_movement_distance(CRTK_motion*,tf::Transform, CRTK_axis, float);
 
 // Check for any rotation not around any particular axis
-int check_movement_rotation(CRTK_motion*, float, int, long, tf::Transform);
+int check_movement_rotation(CRTK_motion*, float, int, ros::Time, tf::Transform);
 
 // Randomly chooses the next motion direction for the robot in cube tracing example
 char rand_cube_dir(char *, tf::Vector3 *, CRTK_axis *);
@@ -36,6 +36,7 @@
 #include "ros/ros.h"
 #include <crtk_msgs/operating_state.h>
 #include <crtk_msgs/StringStamped.h>
+#include <crtk_lib_cpp/crtk_suite.h>
 
 #include "state_tests.h"
 #include <sstream>
@@ -70,11 +71,12 @@ using namespace std;
 int main(int argc, char **argv)
 {
 
-  time_t current_time;
+  ros::Time current_time;
   
 
   ros::init(argc, argv, "crtk_test_state");
   static ros::NodeHandle n("~"); 
+  CRTK_suite::init(n);
 
   std::string r_space;
   if(!n.getParam("r_space", r_space))
@@ -82,12 +84,13 @@ int main(int argc, char **argv)
   CRTK_robot_state robot_state(n,r_space);
 
   int count = 0;
-  ros::Rate loop_rate(10); // \TODO increase loop rate?
+  CRTK_rt_loop loop_rate(n, 10); // \TODO increase loop rate?
+  loop_rate.follow(&robot_state);
 
   ROS_INFO("Please launch stand alone roscore.");
   while (ros::ok()){
 
-    current_time = time(NULL);
+    current_time = CRTK_clock::now();
     state_testing(robot_state, current_time);
 
 
@@ -95,7 +98,7 @@ int main(int argc, char **argv)
     loop_rate.sleep();
     ++count;
   }
-  return 0;
+  return CRTK_suite::exit_code();
 }
 
 
@@ -2,6 +2,8 @@
 #include "ros/ros.h"
 #include <crtk_msgs/operating_state.h>
 #include <crtk_msgs/StringStamped.h>
+#include <crtk_lib_cpp/crtk_confirm.h>
+#include <crtk_lib_cpp/crtk_suite.h>
 
 #include <sstream>
 #include <ctime>
@@ -22,8 +24,8 @@ int starting_test = 1; //change here to skip ahead
  *
  * @return     The number of errors encountered during testing
  */
-int state_testing(CRTK_robot_state robot_state, time_t current_time){
-  static time_t start_time = current_time;
+int state_testing(CRTK_robot_state robot_state, ros::Time current_time){
+  static ros::Time start_time = current_time;
   static int current_test = 0;
   static int finished = 0;
   static int errors = 0;
@@ -39,7 +41,7 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
   }
 
   // wait for a beat
-  if (current_time - start_time < 2){
+  if ((current_time - start_time).toSec() < 2){
         return 0;
   }
   else if (current_test == 0 && !finished){
@@ -65,10 +67,12 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
         errors += 1;
         current_test ++;
         ROS_ERROR("test_1 fail: %i", test_status);
+        CRTK_suite::result("test_1", test_status);
       }
       else if (test_status > 0) {
         current_test ++;
         ROS_INFO("test_1 passed: %i", test_status);
+        CRTK_suite::result("test_1", test_status);
       }
       break;
     }
@@ -82,10 +86,12 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
           errors += 1;
           current_test ++;
           ROS_ERROR("test_2 fail: %i", test_status);
+          CRTK_suite::result("test_2", test_status);
         }
         else if (test_status > 0) {
           current_test ++;
           ROS_INFO("test_2 passed: %i", test_status);
+          CRTK_suite::result("test_2", test_status);
         }
         break;
     }
@@ -99,10 +105,12 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
           errors += 1;
           current_test ++;
           ROS_ERROR("test_3 fail: %i", test_status);
+          CRTK_suite::result("test_3", test_status);
         }
         else if (test_status > 0) {
           current_test ++;
           ROS_INFO("test_3 passed: %i", test_status);
+          CRTK_suite::result("test_3", test_status);
         }
         break;
     }
@@ -116,10 +124,12 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
           errors += 1;
           current_test ++;
           ROS_ERROR("test_4 fail: %i", test_status);
+          CRTK_suite::result("test_4", test_status);
         }
         else if (test_status > 0) {
           current_test ++;
           ROS_INFO("test_4 passed: %i", test_status);
+          CRTK_suite::result("test_4", test_status);
         }
         break;
     }
@@ -134,10 +144,12 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
           errors += 1;
           current_test ++;
           ROS_ERROR("test_5 fail: %i", test_status);
+          CRTK_suite::result("test_5", test_status);
         }
         else if (test_status > 0) {
           current_test ++;
           ROS_INFO("test_5 passed: %i", test_status);
+          CRTK_suite::result("test_5", test_status);
         }
         break;
     }
@@ -152,10 +164,12 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
           errors += 1;
           current_test ++;
           ROS_ERROR("test_6 fail: %i", test_status);
+          CRTK_suite::result("test_6", test_status);
         }
         else if (test_status > 0) {
           current_test ++;
           ROS_INFO("test_6 passed: %i", test_status);
+          CRTK_suite::result("test_6", test_status);
         }
         break;
     }
@@ -170,10 +184,12 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
           errors += 1;
           current_test ++;
           ROS_ERROR("test_7 fail: %i", test_status);
+          CRTK_suite::result("test_7", test_status);
         }
         else if (test_status > 0) {
           current_test ++;
           ROS_INFO("test_7 passed: %i", test_status);
+          CRTK_suite::result("test_7", test_status);
         }
         break;
     }
@@ -188,10 +204,12 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
           errors += 1;
           current_test ++;
           ROS_ERROR("test_8 fail: %i", test_status);
+          CRTK_suite::result("test_8", test_status);
         }
         else if (test_status > 0) {
           current_test ++;
           ROS_INFO("test_8 passed: %i", test_status);
+          CRTK_suite::result("test_8", test_status);
         }
         break;
     }
@@ -204,6 +222,7 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
         robot_state.crtk_command_pb(command);
         ROS_ERROR("We failed some things.");
         finished = 1;
+        CRTK_suite::done(errors);
       }
       else if(finished == 0 && errors == 0){
         // After all tests, send estop command!
@@ -211,6 +230,7 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
         robot_state.crtk_command_pb(command);
         ROS_INFO("We finished everything. Good job!!");
         finished = 1;
+        CRTK_suite::done(errors);
       }
     }
 
@@ -233,9 +253,9 @@ int state_testing(CRTK_robot_state robot_state, time_t current_time){
  *
  * @return      test status (failure (negative value of failing step), running (0), success(1))
  */
-int test_1(CRTK_robot_state robot_state, time_t current_time){
+int test_1(CRTK_robot_state robot_state, ros::Time current_time){
   static int current_step = 1;
-  static time_t pause_start;
+  static ros::Time pause_start;
 
   switch(current_step)
   {
@@ -289,7 +309,7 @@ int test_1(CRTK_robot_state robot_state, time_t current_time){
     case 5:
     {
       // (5) wait for a bit
-      if (current_time - pause_start >= 10){
+      if ((current_time - pause_start).toSec() >= 10){
         current_step ++;
       }
       break;
@@ -331,10 +351,9 @@ int test_1(CRTK_robot_state robot_state, time_t current_time){
  *
  * @return      test status (failure (negative value of failing step), running (0), success(1))
  */
-int test_2(CRTK_robot_state robot_state, time_t current_time){
+int test_2(CRTK_robot_state robot_state, ros::Time current_time){
   static int current_step = 0;
-  static time_t pause_start;
-  string start = "0";
+  static ros::Time pause_start;
   static int start_flag = 0;
   static int cycle_count = 0;
 
@@ -347,8 +366,7 @@ int test_2(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Please home Robot and press 'Enter'.");
         start_flag = 1;
       }
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step = 1;
       }
       break;
@@ -413,8 +431,7 @@ int test_2(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Please make robot busy then press 'Enter'.");
         start_flag = 1;
       }
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
@@ -446,7 +463,7 @@ int test_2(CRTK_robot_state robot_state, time_t current_time){
     case 6:
     {
       // (6) wait for a bit
-      if (current_time - pause_start >= 3){
+      if ((current_time - pause_start).toSec() >= 3){
         current_step ++;
       }
       break;
@@ -486,11 +503,10 @@ int test_2(CRTK_robot_state robot_state, time_t current_time){
  *
  * @return      test status (failure (negative value of failing step), running (0), success(1))
  */
-int test_3(CRTK_robot_state robot_state, time_t current_time){
+int test_3(CRTK_robot_state robot_state, ros::Time current_time){
   static int current_step = 0;
-  static time_t pause_start;
+  static ros::Time pause_start;
   static char start_flag = 0;
-  string start = "0";
 
   switch(current_step)
   {
@@ -501,8 +517,7 @@ int test_3(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Please pause Robot (if it's not already) and press 'Enter'.");
         start_flag = 1;
       }
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step = 1;
       }
       break;
@@ -547,7 +562,7 @@ int test_3(CRTK_robot_state robot_state, time_t current_time){
     case 4:
     {
       // (4) wait for a bit
-      if (current_time - pause_start >= 3){
+      if ((current_time - pause_start).toSec() >= 3){
         current_step ++;
       }
       break;
@@ -605,7 +620,7 @@ int test_3(CRTK_robot_state robot_state, time_t current_time){
     case 9:
     {
       // (9) wait for a bit
-      if (current_time - pause_start >= 1){
+      if ((current_time - pause_start).toSec() >= 1){
         current_step ++;
       }
       break;
@@ -659,10 +674,9 @@ int test_3(CRTK_robot_state robot_state, time_t current_time){
  *
  * @return      test status (failure (negative value of failing step), running (0), success(1))
  */
-int test_4(CRTK_robot_state robot_state, time_t current_time){
+int test_4(CRTK_robot_state robot_state, ros::Time current_time){
   static int current_step = 0;
-  static time_t pause_start;
-  string start = "0";
+  static ros::Time pause_start;
 
   switch(current_step)
   {
@@ -677,8 +691,7 @@ int test_4(CRTK_robot_state robot_state, time_t current_time){
     case 1:
     {
       // (1) wait for 'Enter' key press
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
@@ -702,7 +715,7 @@ int test_4(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Detected start of robot homing.");
         pause_start = current_time;
       }
-      else if(current_time - pause_start > 10){
+      else if((current_time - pause_start).toSec() > 10){
         ROS_ERROR("Testing timeout...");
         current_step = -100;
         return -3;
@@ -712,7 +725,7 @@ int test_4(CRTK_robot_state robot_state, time_t current_time){
     case 4:
     {
       // (4) wait for a bit
-      if (current_time - pause_start >= 3){
+      if ((current_time - pause_start).toSec() >= 3){
         current_step ++;
       }
       break;
@@ -729,7 +742,7 @@ int test_4(CRTK_robot_state robot_state, time_t current_time){
     case 6:
     {
       // (6) wait for a bit
-      if (current_time - pause_start >= 1){
+      if ((current_time - pause_start).toSec() >= 1){
         current_step ++;
       }
       break;
@@ -800,7 +813,7 @@ int test_4(CRTK_robot_state robot_state, time_t current_time){
     case 11:
     {
       // (11) wait for a bit
-      if (current_time - pause_start >= 1){
+      if ((current_time - pause_start).toSec() >= 1){
         current_step ++;
       }
       break;
@@ -853,10 +866,9 @@ int test_4(CRTK_robot_state robot_state, time_t current_time){
  *
  * @return      test status (failure (negative value of failing step), running (0), success(1))
  */
-int test_5(CRTK_robot_state robot_state, time_t current_time){
+int test_5(CRTK_robot_state robot_state, ros::Time current_time){
   static int current_step = 0;
-  static time_t pause_start;
-  string start = "0";
+  static ros::Time pause_start;
 
   switch(current_step)
   {
@@ -871,8 +883,7 @@ int test_5(CRTK_robot_state robot_state, time_t current_time){
     case 1:
     {
       // (1) wait for 'Enter' key press
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
@@ -896,7 +907,7 @@ int test_5(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Detected start of robot homing.");
         pause_start = current_time;
       }
-      else if(current_time - pause_start > 10){
+      else if((current_time - pause_start).toSec() > 10){
         ROS_ERROR("Testing timeout...");
         current_step = -100;
         return -3;
@@ -906,7 +917,7 @@ int test_5(CRTK_robot_state robot_state, time_t current_time){
     case 4:
     {
       // (4) wait for a bit
-      if (current_time - pause_start >= 3){
+      if ((current_time - pause_start).toSec() >= 3){
         current_step ++;
       }
       break;
@@ -923,7 +934,7 @@ int test_5(CRTK_robot_state robot_state, time_t current_time){
     case 6:
     {
       // (6) wait for a bit
-      if (current_time - pause_start >= 1){
+      if ((current_time - pause_start).toSec() >= 1){
         current_step ++;
       }
       break;
@@ -987,10 +998,9 @@ int test_5(CRTK_robot_state robot_state, time_t current_time){
  *
  * @return      test status (failure (negative value of failing step), running (0), success(1))
  */
-int test_6(CRTK_robot_state robot_state, time_t current_time){
+int test_6(CRTK_robot_state robot_state, ros::Time current_time){
   static int current_step = 0;
-  static time_t pause_start;
-  string start = "0";
+  static ros::Time pause_start;
 
   switch(current_step)
   {
@@ -1005,8 +1015,7 @@ int test_6(CRTK_robot_state robot_state, time_t current_time){
     case 1:
     {
       // (1) wait for 'Enter' key press
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
@@ -1030,7 +1039,7 @@ int test_6(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Detected start of robot homing.");
         pause_start = current_time;
       }
-      else if(current_time - pause_start > 10){
+      else if((current_time - pause_start).toSec() > 10){
         ROS_ERROR("Testing timeout...");
         current_step = -100;
         return -3;
@@ -1040,7 +1049,7 @@ int test_6(CRTK_robot_state robot_state, time_t current_time){
     case 4:
     {
       // (4) wait for a bit
-      if (current_time - pause_start >= 3){
+      if ((current_time - pause_start).toSec() >= 3){
         current_step ++;
       }
       break;
@@ -1057,7 +1066,7 @@ int test_6(CRTK_robot_state robot_state, time_t current_time){
     case 6:
     {
       // (6) wait for a bit
-      if (current_time - pause_start >= 1){
+      if ((current_time - pause_start).toSec() >= 1){
         current_step ++;
       }
       break;
@@ -1120,10 +1129,9 @@ int test_6(CRTK_robot_state robot_state, time_t current_time){
  *
  * @return      test status (failure (negative value of failing step), running (0), success(1))
  */
-int test_7(CRTK_robot_state robot_state, time_t current_time){
+int test_7(CRTK_robot_state robot_state, ros::Time current_time){
   static int current_step = 0;
-  static time_t pause_start;
-  string start = "0";
+  static ros::Time pause_start;
 
   switch(current_step)
   {
@@ -1138,8 +1146,7 @@ int test_7(CRTK_robot_state robot_state, time_t current_time){
     case 1:
     {
       // (1) wait for 'Enter' key press
-      getline(std::cin,start);
-      if(start == ""){
+      if(CRTK_confirm::enter()){
         current_step ++;
       }
       break;
@@ -1163,7 +1170,7 @@ int test_7(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Detected start of robot homing.");
         pause_start = current_time;
       }
-      else if(current_time - pause_start > 10){
+      else if((current_time - pause_start).toSec() > 10){
         ROS_ERROR("Testing timeout...");
         current_step = -3;
         return -3;
@@ -1180,7 +1187,7 @@ int test_7(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Detected completion of robot homing.");
         pause_start = current_time;
       }
-      else if(current_time - pause_start > 30){
+      else if((current_time - pause_start).toSec() > 30){
         ROS_ERROR("Testing timeout...");
         current_step = -100;
         return -4;
@@ -1199,7 +1206,7 @@ int test_7(CRTK_robot_state robot_state, time_t current_time){
     case 6:
     {
       // (6) wait for a bit
-      if (current_time - pause_start >= 1){
+      if ((current_time - pause_start).toSec() >= 1){
         current_step ++;
       }
       break;
@@ -1263,10 +1270,9 @@ int test_7(CRTK_robot_state robot_state, time_t current_time){
  *
  * @return      test status (failure (negative value of failing step), running (0), success(1))
  */
-int test_8(CRTK_robot_state robot_state, time_t current_time){
+int test_8(CRTK_robot_state robot_state, ros::Time current_time){
   static int current_step = 0;
-  static time_t pause_start;
-  string start = "0";
+  static ros::Time pause_start;
 
   switch(current_step)
   {
@@ -1320,7 +1326,7 @@ int test_8(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Detected start of robot homing.");
         pause_start = current_time;
       }
-      else if(current_time - pause_start > 10){
+      else if((current_time - pause_start).toSec() > 10){
         ROS_ERROR("Testing timeout...");
         current_step = -4;
         return -4;
@@ -1330,7 +1336,7 @@ int test_8(CRTK_robot_state robot_state, time_t current_time){
     case 5:
     {
       // (5) wait for a bit
-      if (current_time - pause_start >= 3){
+      if ((current_time - pause_start).toSec() >= 3){
         current_step ++;
       }
       break;
@@ -1381,7 +1387,7 @@ int test_8(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Detected completion of robot homing.");
         pause_start = current_time;
       }
-      else if(current_time - pause_start > 30){
+      else if((current_time - pause_start).toSec() > 30){
         ROS_ERROR("Testing timeout...");
         current_step = -100;
         return -9;
@@ -1445,7 +1451,7 @@ int test_8(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Detected start of robot homing.");
         pause_start = current_time;
       }
-      else if(current_time - pause_start > 10){
+      else if((current_time - pause_start).toSec() > 10){
         ROS_ERROR("Testing timeout...");
         current_step = -14;
         return -14;
@@ -1455,7 +1461,7 @@ int test_8(CRTK_robot_state robot_state, time_t current_time){
     case 15:
     {
       // (15) wait for a bit
-      if (current_time - pause_start >= 3){
+      if ((current_time - pause_start).toSec() >= 3){
         current_step ++;
       }
       break;
@@ -1506,7 +1512,7 @@ int test_8(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Detected completion of robot homing.");
         pause_start = current_time;
       }
-      else if(current_time - pause_start > 30){
+      else if((current_time - pause_start).toSec() > 30){
         ROS_ERROR("Testing timeout...");
         current_step = -100;
         return -19;
@@ -1540,7 +1546,7 @@ int test_8(CRTK_robot_state robot_state, time_t current_time){
     case 22:
     {
       // (22) wait for a bit
-      if (current_time - pause_start >= 1){
+      if ((current_time - pause_start).toSec() >= 1){
         current_step ++;
       }
       break;
@@ -1576,7 +1582,7 @@ int test_8(CRTK_robot_state robot_state, time_t current_time){
         ROS_INFO("Detected start of robot homing.");
         pause_start = current_time;
       }
-      else if(current_time - pause_start > 10){
+      else if((current_time - pause_start).toSec() > 10){
         ROS_ERROR("Testing timeout...");
         current_step = -25;
         return -25;
@@ -1586,7 +1592,7 @@ int test_8(CRTK_robot_state robot_state, time_t current_time){
     case 26:
     {
       // (26) wait for a bit
-      if (current_time - pause_start >= 3){
+      if ((current_time - pause_start).toSec() >= 3){
         current_step ++;
       }
       break;
@@ -1638,7 +1644,7 @@ int test_8(CRTK_robot_state robot_state, time_t current_time){
         pause_start = current_time;
         return 1;
       }
-      else if(current_time - pause_start > 30){
+      else if((current_time - pause_start).toSec() > 30){
         ROS_ERROR("Testing timeout...");
         current_step = -100;
         return -30;
@@ -38,6 +38,7 @@
 
 #include "ros/ros.h"
 #include <crtk_msgs/StringStamped.h>
+#include <crtk_lib_cpp/crtk_rt_loop.h>
 #include "main.h"
 #include <sstream>
 #include <iostream>
@@ -74,7 +75,7 @@ int main(int argc, char **argv)
   //start ros node
   ros::init(argc, argv, "crtk_util_footkey");
   static ros::NodeHandle n;
-  ros::Rate loop_rate(LOOP_RATE);
+  CRTK_rt_loop loop_rate(ros::NodeHandle("~"), LOOP_RATE);
 
   ROS_INFO("!~~~~~~~~~~~~ Starting keyboard node ~~~~~~~~~~~");
   ROS_INFO("Press 'e' for pedal up, 'd' for pedal down!");
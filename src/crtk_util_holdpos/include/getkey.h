@@ -0,0 +1,7 @@
+#ifndef _GETKEY_H_
+#define _GETKEY_H_
+
+// reads one keyboard character without blocking, EOF (-1) if none available
+int getkey();
+
+#endif
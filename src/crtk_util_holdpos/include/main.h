@@ -11,7 +11,9 @@
 #include <tf/tf.h>
 #include <cstdio>
 #include <iomanip>
-#include <termios.h>  // needed for terminal settings in getkey()
+#include "getkey.h"
+#include <crtk_lib_cpp/crtk_rt_loop.h>
+#include <crtk_lib_cpp/crtk_transport.h>
 
 
 using namespace std;
@@ -35,13 +37,12 @@ enum CRTK_robot_command {CRTK_ENABLE, CRTK_DISABLE, CRTK_PAUSE, CRTK_RESUME, CRT
 
 ros::Publisher command_pub;
 void crtk_command_pb(CRTK_robot_command command);
-void crtk_measured_cp_arm_cb(geometry_msgs::TransformStamped);
+void crtk_measured_cp_arm_cb(const geometry_msgs::TransformStamped::ConstPtr&);
 
-void operating_state_cb(crtk_msgs::operating_state msg);
+void operating_state_cb(const crtk_msgs::operating_state::ConstPtr& msg);
 
 int main(int argc, char **argv);
 char enable_if_safe();
-int getkey();
 
 
 
@@ -0,0 +1,71 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford,
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * getkey.cpp
+ *
+ * \brief non-blocking keyboard read, shared by the holdpos node and nodelet
+ *
+ *
+ * \date June 18, 2019
+ * \author Andrew Lewis
+ * \author Melody Yun-Hsuan Su
+ *
+ */
+
+#include "getkey.h"
+#include <cstdio>
+#include <cstring>
+#include <termios.h>  // needed for terminal settings in getkey()
+
+
+/**
+ *  \fn int getkey()
+ *
+ *  \brief gets keyboard character for switch case's of console_process()
+ *
+ *  \return returns keyboard character
+ *
+ *  \ingroup IO
+ *
+ *  \return character int
+ */
+int getkey() {
+  int character;
+  termios orig_term_attr;
+  termios new_term_attr;
+
+  /* set the terminal to raw mode */
+  tcgetattr(fileno(stdin), &orig_term_attr);
+  memcpy(&new_term_attr, &orig_term_attr, sizeof(termios));
+  new_term_attr.c_lflag &= ~(ECHO | ICANON);
+  new_term_attr.c_cc[VTIME] = 0;
+  new_term_attr.c_cc[VMIN] = 0;
+  tcsetattr(fileno(stdin), TCSANOW, &new_term_attr);
+
+  /* read a character from the stdin stream without blocking */
+  /*   returns EOF (-1) if no character is available */
+  character = fgetc(stdin);
+
+  /* restore the original terminal attributes */
+  tcsetattr(fileno(stdin), TCSANOW, &orig_term_attr);
+
+  return character;
+}
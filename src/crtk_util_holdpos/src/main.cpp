@@ -55,15 +55,17 @@ int main(int argc, char **argv)
   //start ros node
   ros::init(argc, argv, "crtk_util_holdpos");
   static ros::NodeHandle n("~");
-  ros::Rate loop_rate(LOOP_RATE);
+  CRTK_rt_loop loop_rate(n, LOOP_RATE);
 
 
   std::string space;
   n.getParam("ns", space);
   ROS_INFO("targeting robot named : %s", space.c_str());
 
-  sub_operating_state = n.subscribe("/"+space+"/operating_state", 1, operating_state_cb);
-  sub_measured_cp = n.subscribe("/"+space+"/measured_cp", 1, crtk_measured_cp_arm_cb);
+  std::string topic = "/"+space+"/operating_state";
+  sub_operating_state = n.subscribe(topic, 1, operating_state_cb, CRTK_transport::hints(n, topic));
+  topic = "/"+space+"/measured_cp";
+  sub_measured_cp = n.subscribe(topic, 1, crtk_measured_cp_arm_cb, CRTK_transport::hints(n, topic));
   pub_servo_cp = n.advertise<geometry_msgs::TransformStamped>("/"+space+"/servo_cp", 1);
   pub_state_command = n.advertise<crtk_msgs::StringStamped>("/"+space+"/state_command", 1);
 
@@ -119,49 +121,14 @@ int main(int argc, char **argv)
 
 
 
-/**
- *  \fn int getkey()
- *
- *  \brief gets keyboard character for switch case's of console_process()
- *
- *  \return returns keyboard character
- *
- *  \ingroup IO
- *
- *  \return character int
- */
-int getkey() {
-  int character;
-  termios orig_term_attr;
-  termios new_term_attr;
-
-  /* set the terminal to raw mode */
-  tcgetattr(fileno(stdin), &orig_term_attr);
-  memcpy(&new_term_attr, &orig_term_attr, sizeof(termios));
-  new_term_attr.c_lflag &= ~(ECHO | ICANON);
-  new_term_attr.c_cc[VTIME] = 0;
-  new_term_attr.c_cc[VMIN] = 0;
-  tcsetattr(fileno(stdin), TCSANOW, &new_term_attr);
-
-  /* read a character from the stdin stream without blocking */
-  /*   returns EOF (-1) if no character is available */
-  character = fgetc(stdin);
-
-  /* restore the original terminal attributes */
-  tcsetattr(fileno(stdin), TCSANOW, &orig_term_attr);
-
-  return character;
-}
-
-
 /**
  * @brief      arm1 callback function for measured_cp
  *
  * @param[in]  msg   The message
  */
-void crtk_measured_cp_arm_cb(geometry_msgs::TransformStamped msg){
+void crtk_measured_cp_arm_cb(const geometry_msgs::TransformStamped::ConstPtr& msg){
   tf::Transform in;
-  tf::transformMsgToTF(msg.transform, in);
+  tf::transformMsgToTF(msg->transform, in);
   
   current_pos = in;
 }
@@ -172,9 +139,9 @@ void crtk_measured_cp_arm_cb(geometry_msgs::TransformStamped msg){
  *
  * @param[in]  msg   The message from ROS
  */
-void operating_state_cb(crtk_msgs::operating_state msg){
+void operating_state_cb(const crtk_msgs::operating_state::ConstPtr& msg){
 
-  std::string state = msg.state;
+  const std::string &state = msg->state;
 
   if (state =="DISABLED"){
     robot_state = 'D';
@@ -194,9 +161,9 @@ void operating_state_cb(crtk_msgs::operating_state msg){
   }
 
 
-  is_homed = msg.is_homed;
+  is_homed = msg->is_homed;
 
-  is_busy  = msg.is_busy;
+  is_busy  = msg->is_busy;
 
 }
 
@@ -0,0 +1,130 @@
+/* Raven 2 Control - Control software for the Raven II robot
+ * Copyright (C) 2005-2018  Andrew Lewis, Yun-Hsuan Su, Blake Hannaford,
+ * and the University of Washington BioRobotics Laboratory
+ *
+ * This file is part of Raven 2 Control.
+ *
+ * Raven 2 Control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Raven 2 Control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Raven 2 Control.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ *
+ * \brief Nodelet form of holdpos: press 'd' to hold the current pose (as
+ *  servo_cp) and 'e' to let go. Uses CRTK_robot, so the robot's yaml
+ *  parameters must be loaded and r_space set.
+ *
+ *
+ * \date Oct 16, 2026
+ *
+ */
+
+#include <crtk_lib_cpp/crtk_robot_nodelet.h>
+#include <pluginlib/class_list_macros.h>
+
+#include "getkey.h"
+
+
+class CRTK_util_holdpos_nodelet : public CRTK_robot_nodelet{
+  public:
+    CRTK_util_holdpos_nodelet():hold(0),start(0){};
+
+  protected:
+    virtual int loop(const ros::Time&);
+
+  private:
+    char enable_if_safe();
+
+    int hold;
+    int start;
+    tf::Transform hold_pos;
+};
+
+
+/**
+ * @brief      Checks the keyboard and holds the grabbed pose while enabled
+ *
+ * @param[in]  current_time  The current time
+ *
+ * @return     0
+ */
+int CRTK_util_holdpos_nodelet::loop(const ros::Time& current_time){
+
+  //check keyboard
+  int key_in = getkey();
+
+  //wait for 'd' to start
+  if(key_in == 'd'){
+    // grab current position
+    hold_pos = robot->arm.get_measured_cp();
+    //check that the robot is enabled (and enable if not)
+    if (robot->state.get_enabled() && !robot->state.get_busy()){
+      hold = 1;
+      start = 1;
+    }
+    else{
+      hold = enable_if_safe(); //tell the user to wait and press d after enabled
+    }
+  }
+  else if (key_in == 'e'){
+    hold = 0;
+    NODELET_INFO("Letting go!");
+  }
+
+  if (hold == 1 && robot->state.get_enabled() && !robot->state.get_busy()){
+    if (start) NODELET_INFO("I'm just gonna hold right here");
+    start = 0;
+
+    robot->arm.send_servo_cp(hold_pos);
+  }
+  return 0;
+}
+
+
+/**
+ * @brief      transitions to Enabled if the robot can do that safely
+ *
+ * @return     1 if robot is enabled and not busy
+ */
+char CRTK_util_holdpos_nodelet::enable_if_safe(){
+
+  if (!robot->state.get_homed()){
+    NODELET_INFO("Please home the robot and press 'd' again");
+    return 0;
+  }
+  else if(robot->state.get_paused()){
+    NODELET_INFO("Resuming robot, please wait and press 'd' again");
+    robot->state.crtk_command_pb(CRTK_RESUME);
+    return 0;
+  }
+  else if (robot->state.get_disabled()){
+    NODELET_INFO("Enabling robot, please wait and press 'd' again");
+    robot->state.crtk_command_pb(CRTK_ENABLE);
+    return 0;
+  }
+  else if (robot->state.get_enabled()){
+    if(!robot->state.get_busy())
+      return 1; //do nothing - already enabled, not busy
+    else{
+      NODELET_INFO("Robot is already busy, please wait and press 'd' again");
+      return 0;
+    }
+  }
+  else if (robot->state.get_fault()){
+    NODELET_INFO("Robot in fault state, please clear fault and press 'd' again");
+    return -1;
+  }
+  return 0;
+}
+
+PLUGINLIB_EXPORT_CLASS(CRTK_util_holdpos_nodelet, nodelet::Nodelet)